@@ -0,0 +1,192 @@
+/*
+	Copyright Frank Bösing, Karsten Fleischer, 2026
+
+	This file is part of Teensy64.
+
+    Teensy64 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Teensy64 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Teensy64.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von Teensy64.
+
+    Teensy64 ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Teensy64 wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+*/
+
+/*
+  Host port: the parts of the Teensy core and of its libraries that are not inline in
+  include/, and stand-ins for the hardware dependent functions of util.cpp,
+  keyboard_usb.cpp and output_dac.cpp, which are not built on the host.
+*/
+
+#include <cstdarg>
+#include "teensy64.h"
+
+volatile uint32_t hostRegisters[32];
+thread_local uint32_t hostCycleCounter;
+
+void (*_VectorsRam[NVIC_NUM_INTERRUPTS + 16])(void);
+
+extern "C" void systick_isr(void) {}
+
+usb_serial_class Serial;
+
+size_t Print::printf(const char *format, ...) {
+    va_list args;
+
+    va_start(args, format);
+    int n = vfprintf(stderr, format, args);
+    va_end(args);
+
+    return n;
+}
+
+namespace {
+
+uint32_t milliseconds;
+
+}
+
+void pinMode(int pin, int mode) {}
+int digitalRead(int pin) { return 1; } //pull-ups, nothing pressed
+void digitalWrite(int pin, int value) {}
+int analogRead(int pin) { return 0; }
+uint32_t millis() { return milliseconds; }
+uint32_t micros() { return milliseconds * 1000; }
+void delay(uint32_t ms) { milliseconds += ms; }
+void delayMicroseconds(uint32_t us) {}
+void noInterrupts() {}
+void interrupts() {}
+void attachInterrupt(int pin, void (*function)(void), int mode) {}
+void detachInterrupt(int pin) {}
+
+/*
+  SdFat
+*/
+
+std::string SdFat::hostPath(const char *path) {
+    const char *root = getenv("TEENSY64_SD");
+
+    return std::string(root ? root : ".") + (path[0] == '/' ? "" : "/") + path;
+}
+
+FsFile SdFat::open(const char *path, oflag_t flags) {
+    FsFile f;
+    std::string name = hostPath(path);
+    struct stat s;
+
+    f.path = name;
+    f.name = name.substr(name.find_last_of('/') + 1);
+
+    if(stat(name.c_str(), &s) == 0 && S_ISDIR(s.st_mode)) {
+        DIR *d = opendir(name.c_str());
+        if(d) { f.directory.reset(d, closedir); }
+        return f;
+    }
+
+    FILE *file;
+
+    if((flags & O_ACCMODE) == O_RDONLY) {
+        file = fopen(name.c_str(), "rb");
+    } else {
+        file = fopen(name.c_str(), (flags & O_TRUNC) ? "w+b" : "r+b");
+        if(!file && (flags & O_CREAT)) {
+            file = fopen(name.c_str(), "w+b");
+        }
+        if(file && (flags & O_AT_END)) {
+            fseek(file, 0, SEEK_END);
+        }
+    }
+    if(file) { f.file.reset(file, fclose); }
+
+    return f;
+}
+
+FsFile FsFile::openNextFile(oflag_t flags) {
+    if(!directory) {
+        return FsFile();
+    }
+
+    while(struct dirent *e = readdir(directory.get())) {
+        if(e->d_name[0] != '.') {
+            std::string p = path + "/" + e->d_name;
+            const char *root = getenv("TEENSY64_SD");
+            return SdFat().open(p.c_str() + strlen(root ? root : "."), flags);
+        }
+    }
+
+    return FsFile();
+}
+
+size_t FsFile::printf(const char *format, ...) {
+    if(!file) {
+        return 0;
+    }
+
+    va_list args;
+
+    va_start(args, format);
+    int n = vfprintf(file.get(), format, args);
+    va_end(args);
+
+    return n;
+}
+
+/*
+  util.cpp
+*/
+
+void enableCycleCounter() {}
+void disableEventResponder() {}
+float setAudioSampleFreq(float freq) { return freq; }
+void setAudioOff() {}
+void setAudioOn() {}
+void listInterrupts() {}
+
+size_t freeRAM() {
+    return 200 * 1024;
+}
+
+/*
+  output_dac.cpp
+*/
+
+DMAChannel AudioOutputAnalog::dma(false);
+uint8_t AudioOutputAnalog::volume;
+audio_block_t *AudioOutputAnalog::block_left_1st;
+audio_block_t *AudioOutputAnalog::block_left_2nd;
+bool AudioOutputAnalog::update_responsibility;
+
+void AudioOutputAnalog::begin(void) {}
+void AudioOutputAnalog::update(void) {}
+
+/*
+  keyboard_usb.cpp
+*/
+
+void c64USBKeyboard::init() {}
+bool c64USBKeyboard::claim(Device_t *dev, int type, const uint8_t *descriptors, uint32_t len) { return false; }
+void c64USBKeyboard::control(const Transfer_t *transfer) {}
+void c64USBKeyboard::disconnect() {}
+void c64USBKeyboard::attachC64(void (*f)(void *)) {}
+void c64USBKeyboard::numLock(bool state) {}
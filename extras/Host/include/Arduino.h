@@ -0,0 +1,257 @@
+/*
+	Copyright Frank Bösing, Karsten Fleischer, 2026
+
+	This file is part of Teensy64.
+
+    Teensy64 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Teensy64 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Teensy64.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von Teensy64.
+
+    Teensy64 ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Teensy64 wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+*/
+
+/*
+  Host port of the parts of the Teensy core that Teensy64 uses, for the host tools and
+  tests in extras (see ../Makefile). Nothing here talks to hardware:
+  - Serial prints to stderr, so stdout stays free for the output of the tools.
+  - millis() and micros() only advance with delay(). The cycle counter ARM_DWT_CYCCNT
+    advances by HOST_CYCCNT_STEP on every read, with a counter per thread. Time budgets of
+    the core, like that of warp mode, thus come out the same on every run.
+  - The peripheral registers are plain variables.
+*/
+
+#pragma once
+
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <type_traits>
+
+// As in platformio.ini
+#ifndef F_CPU
+#define F_CPU 240000000
+#endif
+#ifndef F_BUS
+#define F_BUS 120000000
+#endif
+#ifndef AUDIO_BLOCK_SAMPLES
+#define AUDIO_BLOCK_SAMPLES 32
+#endif
+#ifndef HOST_CYCCNT_STEP
+#define HOST_CYCCNT_STEP 256
+#endif
+
+#define HEX 16
+#define DEC 10
+
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define OUTPUT_OPENDRAIN 3
+#define FALLING 2
+#define RISING 3
+#define CHANGE 4
+
+#define A12 38
+#define A13 39
+#define A14 40
+#define A15 41
+#define BUILTIN_SDCARD 254
+
+#define FASTRUN
+#define DMAMEM
+#define PROGMEM
+
+extern volatile uint32_t hostRegisters[32];
+extern thread_local uint32_t hostCycleCounter; //per thread, like the machines
+
+#define HOST_REGISTER(n) (hostRegisters[n])
+
+#define ARM_DWT_CYCCNT (hostCycleCounter += HOST_CYCCNT_STEP)
+#define ARM_DEMCR HOST_REGISTER(1)
+#define ARM_DEMCR_TRCENA 1
+#define ARM_DWT_CTRL HOST_REGISTER(2)
+#define ARM_DWT_CTRL_CYCCNTENA 1
+
+#define GPIOA_PDIR HOST_REGISTER(3)
+#define GPIOB_PDIR HOST_REGISTER(4)
+#define GPIOA_PCOR HOST_REGISTER(5)
+#define GPIOA_PSOR HOST_REGISTER(6)
+#define GPIOC_PTOR HOST_REGISTER(7)
+#define GPIOE_PDDR HOST_REGISTER(8)
+#define GPIOE_PSOR HOST_REGISTER(9)
+#define PORTE_PCR0 HOST_REGISTER(10)
+#define PORTE_PCR1 HOST_REGISTER(11)
+#define PORTE_PCR3 HOST_REGISTER(12)
+#define PORTE_PCR4 HOST_REGISTER(13)
+#define PORTE_PCR5 HOST_REGISTER(14)
+#define PORTE_PCR6 HOST_REGISTER(15)
+#define PORT_PCR_MUX(n) (n)
+#define PORT_PCR_PE 2
+#define PORT_PCR_PS 1
+
+#define SIM_SCGC6 HOST_REGISTER(16)
+#define SIM_SCGC6_PDB 1
+#define SIM_SCGC2 HOST_REGISTER(17)
+#define SIM_SCGC2_DAC0 1
+
+#define PDB0_SC HOST_REGISTER(18)
+#define PDB0_IDLY HOST_REGISTER(19)
+#define PDB0_MOD HOST_REGISTER(20)
+#define PDB0_CH0C1 HOST_REGISTER(21)
+#define PDB_SC_TRGSEL(n) (n)
+#define PDB_SC_PDBEN 1
+#define PDB_SC_CONT 2
+#define PDB_SC_PDBIE 4
+#define PDB_SC_DMAEN 8
+#define PDB_SC_LDOK 16
+#define PDB_SC_SWTRIG 32
+
+#define DAC0_C0 HOST_REGISTER(22)
+#define DAC0_DAT0L HOST_REGISTER(23)
+#define DAC_C0_DACEN 1
+#define DAC_C0_DACRFS 2
+#define DMAMUX_SOURCE_PDB 1
+
+#define SCB_AIRCR HOST_REGISTER(24)
+#define WDOG_STCTRLH HOST_REGISTER(25)
+
+#define IRQ_SOFTWARE 1
+#define IRQ_USBOTG 2
+#define IRQ_USBHS 3
+#define IRQ_FTFL_COLLISION 4
+#define NVIC_NUM_INTERRUPTS 100
+#define NVIC_ENABLE_IRQ(n) ((void) (n))
+#define NVIC_DISABLE_IRQ(n) ((void) (n))
+#define NVIC_GET_PRIORITY(n) 0
+#define NVIC_IS_ENABLED(n) 0
+#define NVIC_SET_PRIORITY(n, p) ((void) (n))
+#define NVIC_SET_PENDING(n) ((void) (n))
+
+#define digitalPinToInterrupt(p) (p)
+#define digitalWriteFast digitalWrite
+#define digitalReadFast digitalRead
+#define __disable_irq() noInterrupts()
+#define __enable_irq() interrupts()
+
+extern void (*_VectorsRam[NVIC_NUM_INTERRUPTS + 16])(void);
+extern "C" void systick_isr(void);
+
+void pinMode(int pin, int mode);
+int digitalRead(int pin);
+void digitalWrite(int pin, int value);
+int analogRead(int pin);
+uint32_t millis();
+uint32_t micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void noInterrupts();
+void interrupts();
+void attachInterrupt(int pin, void (*function)(void), int mode);
+void detachInterrupt(int pin);
+void yield(void);
+
+template<class A, class B>
+static inline auto min(A a, B b) -> typename std::common_type<A, B>::type {
+    return a < b ? a : b;
+}
+
+template<class A, class B>
+static inline auto max(A a, B b) -> typename std::common_type<A, B>::type {
+    return a > b ? a : b;
+}
+
+static inline char *itoa(int value, char *s, int base) {
+    sprintf(s, base == 16 ? "%x" : "%d", value);
+
+    return s;
+}
+
+class Print {
+public:
+    virtual ~Print() {}
+
+    virtual size_t write(uint8_t c) {
+        return fputc(c, stderr) == EOF ? 0 : 1;
+    }
+
+    size_t write(const uint8_t *buffer, size_t size) {
+        return fwrite(buffer, 1, size, stderr);
+    }
+
+    size_t print(const char *s) { return fprintf(stderr, "%s", s); }
+    size_t print(char c) { return fprintf(stderr, "%c", c); }
+    size_t print(int n, int base = DEC) { return fprintf(stderr, base == HEX ? "%X" : "%d", n); }
+    size_t print(unsigned n, int base = DEC) { return fprintf(stderr, base == HEX ? "%X" : "%u", n); }
+    size_t print(long n, int base = DEC) { return fprintf(stderr, base == HEX ? "%lX" : "%ld", n); }
+    size_t print(unsigned long n, int base = DEC) { return fprintf(stderr, base == HEX ? "%lX" : "%lu", n); }
+    size_t print(double d, int digits = 2) { return fprintf(stderr, "%.*f", digits, d); }
+    size_t println() { return fprintf(stderr, "\n"); }
+
+    template<typename T>
+    size_t println(T value) {
+        return print(value) + println();
+    }
+
+    template<typename T>
+    size_t println(T value, int format) {
+        return print(value, format) + println();
+    }
+
+    size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3)));
+};
+
+class usb_serial_class : public Print {
+public:
+    using Print::write;
+
+    void begin(long) {}
+    operator bool() { return true; }
+    int available() { return 0; }
+    int read() { return -1; }
+    int peek() { return -1; }
+    void flush() { fflush(stderr); }
+    int availableForWrite() { return 64; }
+};
+
+extern usb_serial_class Serial;
+
+// The callback never runs: host tools drive the machine themselves.
+class IntervalTimer {
+public:
+    bool begin(void (*function)(), float) { this->function = function; return true; }
+    bool begin(void (*function)(), unsigned) { this->function = function; return true; }
+    void update(float) {}
+    void end() { function = nullptr; }
+    void priority(uint8_t) {}
+
+    void (*function)() = nullptr;
+};
+
+class EventResponder {};
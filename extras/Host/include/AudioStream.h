@@ -0,0 +1,76 @@
+/*
+	Copyright Frank Bösing, Karsten Fleischer, 2026
+
+	This file is part of Teensy64.
+
+    Teensy64 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Teensy64 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Teensy64.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von Teensy64.
+
+    Teensy64 ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Teensy64 wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+*/
+
+/*
+  Host port of the Teensy audio library: the audio graph is never updated, blocks are
+  never allocated.
+*/
+
+#pragma once
+
+#include <Arduino.h>
+
+typedef struct audio_block_struct {
+    uint8_t ref_count;
+    uint8_t reserved1;
+    uint16_t memory_pool_index;
+    int16_t data[AUDIO_BLOCK_SAMPLES];
+} audio_block_t;
+
+class AudioStream {
+public:
+    AudioStream(unsigned char ninput, audio_block_t **iqueue) {}
+    virtual ~AudioStream() {}
+
+    virtual void update(void) = 0;
+
+protected:
+    audio_block_t *receiveReadOnly(unsigned int index = 0) { return nullptr; }
+    audio_block_t *receiveWritable(unsigned int index = 0) { return nullptr; }
+    static audio_block_t *allocate(void) { return nullptr; }
+    static void release(audio_block_t *block) {}
+    void transmit(audio_block_t *block, unsigned char index = 0) {}
+    static bool update_setup(void) { return true; }
+
+    bool active = true;
+};
+
+class AudioConnection {
+public:
+    AudioConnection(AudioStream &source, unsigned char sourceOutput,
+                    AudioStream &destination, unsigned char destinationInput) {}
+};
+
+#define AudioMemory(num) ((void) (num))
@@ -0,0 +1,85 @@
+/*
+	Copyright Frank Bösing, Karsten Fleischer, 2026
+
+	This file is part of Teensy64.
+
+    Teensy64 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Teensy64 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Teensy64.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von Teensy64.
+
+    Teensy64 ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Teensy64 wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+*/
+
+/*
+  Host port of the Teensy DMAChannel: the transfer control descriptor is plain memory and
+  no transfer ever runs.
+*/
+
+#pragma once
+
+#include <Arduino.h>
+
+typedef struct {
+    volatile const void *volatile SADDR;
+    int16_t SOFF;
+    uint16_t ATTR;
+    uint32_t NBYTES;
+    int32_t SLAST;
+    volatile void *volatile DADDR;
+    int16_t DOFF;
+    uint16_t CITER;
+    int32_t DLASTSGA;
+    uint16_t CSR;
+    uint16_t BITER;
+} TCD_t;
+
+#define DMA_TCD_ATTR_SSIZE(n) ((n) << 8)
+#define DMA_TCD_ATTR_DSIZE(n) (n)
+#define DMA_TCD_ATTR_SIZE_16BIT 1
+#define DMA_TCD_ATTR_SIZE_32BIT 2
+#define DMA_TCD_CSR_INTMAJOR 2
+#define DMA_TCD_CSR_INTHALF 4
+
+class DMAChannel {
+public:
+    DMAChannel(bool allocate = true) { TCD = &tcd; }
+
+    void begin(bool force = false) {}
+    void triggerAtCompletionOf(DMAChannel &channel) {}
+    void triggerAtHardwareEvent(uint8_t source) {}
+    void enable() {}
+    void disable() {}
+    void attachInterrupt(void (*isr)(void)) {}
+    void clearInterrupt() {}
+    void sourceBuffer(const void *p, uint32_t len) {}
+    void destination(volatile uint16_t &p) {}
+
+    TCD_t *TCD;
+    uint8_t channel = 0;
+
+private:
+    TCD_t tcd;
+};
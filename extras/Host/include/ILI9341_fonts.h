@@ -0,0 +1,60 @@
+/*
+	Copyright Frank Bösing, Karsten Fleischer, 2026
+
+	This file is part of Teensy64.
+
+    Teensy64 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Teensy64 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Teensy64.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von Teensy64.
+
+    Teensy64 ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Teensy64 wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+*/
+
+// Host port of the font header of the ILI9341_t3n library.
+
+#pragma once
+
+#include <cstdint>
+
+typedef struct {
+    const unsigned char *index;
+    const unsigned char *unicode;
+    const unsigned char *data;
+    unsigned char version;
+    unsigned char reserved;
+    unsigned char index1_first;
+    unsigned char index1_last;
+    unsigned char index2_first;
+    unsigned char index2_last;
+    unsigned char bits_index;
+    unsigned char bits_width;
+    unsigned char bits_height;
+    unsigned char bits_xoffset;
+    unsigned char bits_yoffset;
+    unsigned char bits_delta;
+    unsigned char line_space;
+    unsigned char cap_height;
+} ILI9341_t3_font_t;
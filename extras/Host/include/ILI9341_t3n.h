@@ -0,0 +1,76 @@
+/*
+	Copyright Frank Bösing, Karsten Fleischer, 2026
+
+	This file is part of Teensy64.
+
+    Teensy64 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Teensy64 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Teensy64.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von Teensy64.
+
+    Teensy64 ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Teensy64 wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+*/
+
+/*
+  Host port of the ILI9341_t3n display library: a display that shows nothing. The core
+  draws into the frame buffer of its machine, host tools read it from there.
+*/
+
+#pragma once
+
+#include <Arduino.h>
+#include "ILI9341_fonts.h"
+
+#define ILI9341_TFTWIDTH 320
+#define ILI9341_TFTHEIGHT 240
+
+#define ILI9341_BLACK 0x0000
+#define ILI9341_WHITE 0xFFFF
+
+class ILI9341_t3n {
+public:
+    ILI9341_t3n(uint8_t cs, uint8_t dc, uint8_t rst, uint8_t mosi, uint8_t sclk, uint8_t miso) {}
+
+    void begin(uint32_t spiClock = 0) {}
+    void setRotation(uint8_t r) {}
+    void setFrameBuffer(uint16_t *frameBuffer) {}
+    uint8_t useFrameBuffer(bool use) { return 1; }
+    bool updateScreenAsync(bool updateContinuous = false) { return true; }
+    void updateScreen() {}
+    void waitUpdateAsyncComplete() {}
+    bool asyncUpdateActive() { return false; }
+    void endUpdateAsync() {}
+    void fillScreen(uint16_t color) {}
+    void drawPixel(int16_t x, int16_t y, uint16_t color) {}
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {}
+    void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {}
+    void setFont(const ILI9341_t3_font_t &f) {}
+    void setTextColor(uint16_t c) {}
+    void setTextColor(uint16_t c, uint16_t bg) {}
+    void setTextSize(uint8_t s) {}
+    void setCursor(int16_t x, int16_t y) {}
+    void print(const char *s) {}
+    void println(const char *s) {}
+};
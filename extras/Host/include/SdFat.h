@@ -0,0 +1,152 @@
+/*
+	Copyright Frank Bösing, Karsten Fleischer, 2026
+
+	This file is part of Teensy64.
+
+    Teensy64 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Teensy64 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Teensy64.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von Teensy64.
+
+    Teensy64 ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Teensy64 wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+*/
+
+/*
+  Host port of the SdFat library: the card is a directory of the host, given by the
+  environment variable TEENSY64_SD (default: the current directory). Only what the core
+  uses is there.
+*/
+
+#pragma once
+
+#include <Arduino.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <memory>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+
+typedef int oflag_t;
+
+#define O_READ O_RDONLY
+#define O_WRITE O_WRONLY
+#define O_AT_END O_APPEND
+#define FILE_READ O_RDONLY
+#define FILE_WRITE (O_RDWR | O_CREAT | O_AT_END)
+
+class FsFile {
+public:
+    operator bool() const { return file || directory; }
+
+    bool isDirectory() const { return (bool) directory; }
+
+    uint64_t size() {
+        struct stat s;
+
+        return file && fstat(fileno(file.get()), &s) == 0 ? s.st_size : 0;
+    }
+
+    int read() {
+        return file ? fgetc(file.get()) : -1;
+    }
+
+    int read(void *buffer, size_t count) {
+        return file ? fread(buffer, 1, count, file.get()) : -1;
+    }
+
+    size_t write(const void *buffer, size_t count) {
+        return file ? fwrite(buffer, 1, count, file.get()) : 0;
+    }
+
+    size_t write(uint8_t c) {
+        return write(&c, 1);
+    }
+
+    bool seekSet(uint64_t position) {
+        return file && fseek(file.get(), position, SEEK_SET) == 0;
+    }
+
+    bool seek(uint64_t position) {
+        return seekSet(position);
+    }
+
+    uint64_t position() {
+        return file ? ftell(file.get()) : 0;
+    }
+
+    int available() {
+        return file ? size() - position() : 0;
+    }
+
+    void flush() {
+        if(file) { fflush(file.get()); }
+    }
+
+    bool close() {
+        file.reset();
+        directory.reset();
+        return true;
+    }
+
+    size_t getName(char *name, size_t size) {
+        snprintf(name, size, "%s", this->name.c_str());
+        return strlen(name);
+    }
+
+    FsFile openNextFile(oflag_t flags = O_RDONLY);
+
+    size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3)));
+
+private:
+    friend class SdFat;
+
+    std::shared_ptr<FILE> file;
+    std::shared_ptr<DIR> directory;
+    std::string path;
+    std::string name;
+};
+
+class SdFat {
+public:
+    bool begin(uint8_t csPin) { return true; }
+
+    FsFile open(const char *path, oflag_t flags = O_RDONLY);
+
+    bool exists(const char *path) {
+        return access(hostPath(path).c_str(), F_OK) == 0;
+    }
+
+    bool remove(const char *path) {
+        return ::remove(hostPath(path).c_str()) == 0;
+    }
+
+    bool mkdir(const char *path, bool parents = true) {
+        return ::mkdir(hostPath(path).c_str(), 0777) == 0;
+    }
+
+    // The path of a file of the card on the host.
+    static std::string hostPath(const char *path);
+};
@@ -0,0 +1,74 @@
+/*
+	Copyright Frank Bösing, Karsten Fleischer, 2026
+
+	This file is part of Teensy64.
+
+    Teensy64 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Teensy64 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Teensy64.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von Teensy64.
+
+    Teensy64 ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Teensy64 wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+*/
+
+// Host port of the USBHost_t36 library: no USB devices are ever attached.
+
+#pragma once
+
+#include <Arduino.h>
+
+typedef struct Device_struct {} Device_t;
+typedef struct Pipe_struct {} Pipe_t;
+
+typedef struct Transfer_struct {
+    void *driver;
+    void *buffer;
+    uint32_t length;
+} Transfer_t;
+
+typedef struct {
+    uint32_t word1;
+    uint32_t word2;
+} setup_t;
+
+class USBHost {
+public:
+    static void begin() {}
+    static void Task() {}
+};
+
+class USBDriver {
+protected:
+    virtual bool claim(Device_t *device, int type, const uint8_t *descriptors, uint32_t len) = 0;
+    virtual void control(const Transfer_t *transfer) {}
+    virtual void disconnect() {}
+
+    Device_t *device = nullptr;
+};
+
+class USBHub {
+public:
+    USBHub(USBHost &host) {}
+};
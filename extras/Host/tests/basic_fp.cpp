@@ -0,0 +1,228 @@
+/*
+	Copyright Frank Bösing, Karsten Fleischer, 2026
+
+	This file is part of Teensy64.
+
+    Teensy64 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Teensy64 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Teensy64.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von Teensy64.
+
+    Teensy64 ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Teensy64 wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+*/
+
+/*
+  Test of basic_fp.h: the native FADDT, FMULTT and FDIVT against the code of the BASIC ROM.
+  Each case runs twice from the same FAC, ARG and zero page: once through the trap in the
+  ROM, once from a copy of the unpatched ROM in the RAM under it, with the BASIC ROM banked
+  out. Both must end with the same zero page, registers, flags and number of cycles, at the
+  return address or, for an overflow or a division by zero, at the ERROR routine.
+*/
+
+#include <cmath>
+#include <random>
+
+#include "test.h"
+#include "basic_fp.h"
+#include "roms.h"
+
+namespace {
+
+using namespace test;
+
+tpixel frameBuffer[ILI9341_TFTWIDTH * ILI9341_TFTHEIGHT];
+
+const uint16_t RETURN = 0xC000; //the routines return here
+const uint16_t ERROR = 0xA437;  //BASIC ERROR, X: error number
+
+struct tentry {
+    const char *name;
+    uint16_t address;
+};
+
+const tentry ADD = {"FADDT", 0xB86A}; //FAC = ARG + FAC
+const tentry MULT = {"FMULTT", 0xBA2B}; //FAC = ARG * FAC
+const tentry DIV = {"FDIVT", 0xBB12}; //FAC = ARG / FAC
+
+struct tresult {
+    uint8_t zp[0x100];
+    uint16_t pc;
+    uint8_t a, x, y, sp, flags;
+    uint32_t cycles;
+};
+
+unsigned cases = 0;
+unsigned errors = 0; //cases that end in ERROR
+
+//Unpacked floating point register at base: exponent, 4 bytes mantissa, sign
+void setFloat(uint8_t base, double value) {
+    uint8_t *r = &cpu().RAM[base];
+
+    memset(r, 0, 6);
+    if(value == 0) { return; }
+
+    int e;
+    double m = frexp(fabs(value), &e); //0.5 <= m < 1
+    uint32_t mantissa = (uint32_t) ldexp(m, 32);
+
+    r[0] = e + 128;
+    for(int i = 0; i < 4; i++) { r[1 + i] = mantissa >> (24 - 8 * i); }
+    r[5] = value < 0 ? 0xFF : 0x00;
+}
+
+bool running() {
+    return cpu().pc != RETURN && cpu().pc != ERROR;
+}
+
+//Runs the routine at entry with the zero page in zp, the way FADD, FMULT and FDIV call it
+tresult run(uint16_t entry, const uint8_t *zp, bool rom) {
+    memcpy(cpu().RAM, zp, 0x100);
+    (*cpu().plamap_w)[0](1, rom ? 0x36 : 0x37); //the copy of the BASIC ROM or the ROM with the traps
+
+    cpu().sp = 0xFD;
+    cpu().RAM[BASE_STACK + 0xFD] = (RETURN - 1) >> 8;
+    cpu().RAM[BASE_STACK + 0xFC] = (RETURN - 1) & 0xFF;
+    cpu().sp -= 2;
+    cpu().pc = entry;
+    cpu().a = zp[0x61]; //LDA $61 at the end of CONUPK
+    cpu().x = 0;
+    cpu().y = 0;
+    cpu().cpustatus = FLAG_CONSTANT | FLAG_INTERRUPT | (cpu().a == 0 ? FLAG_ZERO : 0) | (cpu().a & FLAG_SIGN);
+
+    tresult r;
+
+    r.cycles = cpu_runWhile(running, 100000);
+    memcpy(r.zp, cpu().RAM, sizeof(r.zp));
+    r.zp[1] = 0; //the bank differs
+    r.pc = cpu().pc;
+    r.a = cpu().a;
+    r.x = cpu().x;
+    r.y = cpu().y;
+    r.sp = cpu().sp;
+    r.flags = cpu().cpustatus & (FLAG_SIGN | FLAG_OVERFLOW | FLAG_ZERO | FLAG_CARRY);
+
+    return r;
+}
+
+void compare(const tentry &routine, const uint8_t *zp, const char *description) {
+    tresult native = run(routine.address, zp, false);
+    tresult rom = run(routine.address, zp, true);
+    bool same = memcmp(native.zp, rom.zp, sizeof(native.zp)) == 0 && native.pc == rom.pc
+                && native.a == rom.a && native.x == rom.x && native.y == rom.y && native.sp == rom.sp
+                && native.flags == rom.flags && (BASICFP_CYCLEDIVIDER != 1 || native.cycles == rom.cycles);
+
+    cases++;
+    if(rom.pc == ERROR) { errors++; }
+    CHECK(rom.pc == RETURN || rom.pc == ERROR);
+    if(!same) {
+        printf("%s %s: native pc %04x a %02x x %02x y %02x sp %02x p %02x %u cycles, "
+               "ROM pc %04x a %02x x %02x y %02x sp %02x p %02x %u cycles\n", routine.name, description,
+               native.pc, native.a, native.x, native.y, native.sp, native.flags, (unsigned) native.cycles,
+               rom.pc, rom.a, rom.x, rom.y, rom.sp, rom.flags, (unsigned) rom.cycles);
+        for(unsigned i = 0; i < 0x100; i++) {
+            if(native.zp[i] != rom.zp[i]) { printf("  $%02x: %02x %02x\n", i, native.zp[i], rom.zp[i]); }
+        }
+    }
+    CHECK(same);
+}
+
+//The zero page of a machine at the READY prompt with FAC and ARG set
+void vector(const tentry &routine, double arg, double fac, uint8_t rounding = 0) {
+    uint8_t zp[0x100];
+    char description[64];
+
+    setFloat(0x61, fac);
+    setFloat(0x69, arg);
+    cpu().RAM[0x6F] = cpu().RAM[0x66] ^ cpu().RAM[0x6E];
+    cpu().RAM[0x70] = rounding;
+    memcpy(zp, cpu().RAM, sizeof(zp));
+
+    snprintf(description, sizeof(description), "%g, %g", arg, fac);
+    compare(routine, zp, description);
+}
+
+void testVectors() {
+    const tentry routines[] = {ADD, MULT, DIV};
+
+    for(const tentry &r : routines) {
+        //normal, zero, overflow and underflow
+        vector(r, 1, 1);
+        vector(r, 10, 3);
+        vector(r, -3.5, 2);
+        vector(r, 0.1, 0.2, 0x80);
+        vector(r, 5, -5);
+        vector(r, 0, 7);
+        vector(r, 7, 0);
+        vector(r, 0, 0);
+        vector(r, 1.7e38, 1.7e38);
+        vector(r, 1.7e38, -1e-38);
+        vector(r, 1e-38, 1e-38);
+        vector(r, 3e-39, 1e38);
+        vector(r, -1e-38, 3e-39);
+    }
+}
+
+//FAC, ARG, the rounding byte and the temporaries at random, exponents over the whole range
+void testRandom() {
+    const tentry routines[] = {ADD, MULT, DIV};
+    std::mt19937 random(6502);
+    uint8_t zp[0x100];
+
+    memcpy(zp, cpu().RAM, sizeof(zp));
+
+    for(unsigned i = 0; i < 3000; i++) {
+        for(unsigned a = 0x26; a <= 0x70; a++) { zp[a] = random(); }
+        zp[0x62] |= 0x80; //normalized
+        zp[0x6A] |= 0x80;
+        if(i % 8 == 0) { zp[0x61] = 0; }
+        if(i % 8 == 1) { zp[0x69] = 0; }
+        zp[0x66] &= 0x80;
+        zp[0x6E] &= 0x80;
+        zp[0x6F] = zp[0x66] ^ zp[0x6E];
+
+        char description[32];
+
+        snprintf(description, sizeof(description), "random %u", i);
+        compare(routines[i % 3], zp, description);
+    }
+}
+
+}
+
+int main() {
+    tcpu *m = boot(frameBuffer);
+
+    //the unpatched BASIC ROM in the RAM under it
+    memcpy(&cpu().RAM[0xA000], rom_basic, sizeof(rom_basic));
+    for(uint16_t a : {ADD.address, MULT.address, DIV.address}) { cpu().RAM[a] = basicFPOpcode(a); }
+    CHECK(cpu().RAM[ADD.address] != BASICFP_TRAP_OPCODE && rom_basic[ADD.address - 0xA000] == BASICFP_TRAP_OPCODE);
+
+    testVectors();
+    testRandom();
+    printf("basic_fp: %u cases, %u of them end in ERROR\n", cases, errors);
+
+    machineDestroy(m);
+
+    return result("basic_fp");
+}
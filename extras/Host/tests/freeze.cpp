@@ -0,0 +1,130 @@
+/*
+	Copyright Frank Bösing, Karsten Fleischer, 2026
+
+	This file is part of Teensy64.
+
+    Teensy64 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Teensy64 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Teensy64.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von Teensy64.
+
+    Teensy64 ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Teensy64 wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+*/
+
+/*
+  Test of freeze.h, with the SD card in a temporary directory. A machine runs a demo the
+  way the line clock interrupt drives it. A freeze must keep the machine waiting while it
+  writes the file, at most one tick per chunk, and a resume some frames later must bring
+  back the state of the freeze.
+*/
+
+#include <cstdlib>
+#include <unistd.h>
+
+#include "test.h"
+#include "freeze.h"
+
+namespace {
+
+using namespace test;
+
+tpixel frameBuffer[ILI9341_TFTWIDTH * ILI9341_TFTHEIGHT];
+
+const unsigned TICKS = 19; //see freeze.h
+
+unsigned wait = 0;
+unsigned longestWait = 0;
+
+//One tick of the line clock, as oneRasterLine() without warp and exact timing
+void tick() {
+    if(freezePoll()) {
+        longestWait = max(longestWait, ++wait);
+        return;
+    }
+
+    wait = 0;
+    machineLine();
+}
+
+void runFrames(uint32_t frames) {
+    for(uint32_t line = 0; line < frames * LINECNT; line++) { tick(); }
+}
+
+void testFreeze(const char *examples) {
+    char directory[] = "/tmp/t64-freeze-XXXXXX";
+
+    CHECK(mkdtemp(directory) != nullptr);
+    setenv("TEENSY64_SD", directory, 1);
+    SDinitialized = true;
+
+    tcpu *m = boot(frameBuffer);
+
+    CHECK(load(examples, "deliri.prg"));
+    runFrames(100);
+
+    freezeRequest();
+    uint64_t frozen = machineHash();
+
+    tick(); //starts the freeze
+    while(freezeBusy()) {
+        CHECK(machineHash() == frozen);
+        tick();
+    }
+
+    unsigned freezeWait = longestWait;
+
+    runFrames(100);
+    CHECK(machineHash() != frozen);
+
+    resumeRequest();
+    longestWait = 0;
+    tick();
+    while(freezeBusy()) { tick(); }
+
+    printf("freeze: %u ticks, resume: %u ticks\n", freezeWait, longestWait);
+    CHECK(freezeWait > 0 && freezeWait <= TICKS);
+    CHECK(longestWait > 0 && longestWait <= TICKS);
+    CHECK(machineHash() == frozen);
+
+    machineDestroy(m);
+
+    char path[64];
+
+    snprintf(path, sizeof(path), "%s%s", directory, FREEZE_FILE);
+    unlink(path);
+    rmdir(directory);
+}
+
+}
+
+int main(int argc, char **argv) {
+    if(argc != 2) {
+        fprintf(stderr, "Usage: %s <directory of the sample programs>\n", argv[0]);
+        return 2;
+    }
+
+    testFreeze(argv[1]);
+
+    return result("freeze");
+}
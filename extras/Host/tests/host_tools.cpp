@@ -0,0 +1,282 @@
+/*
+	Copyright Frank Bösing, Karsten Fleischer, 2026
+
+	This file is part of Teensy64.
+
+    Teensy64 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Teensy64 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Teensy64.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von Teensy64.
+
+    Teensy64 ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Teensy64 wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+*/
+
+/*
+  Tests of the parts of the core that only host builds have: the render thread
+  (vic_pipeline.h), the streams of frames and audio blocks (stream.h, video_stream.h,
+  output_stream.h), the live view (live_view.h), and the signatures of decrunch.cpp with
+  their test programs. Run by make check, with the directory of the sample programs.
+*/
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "test.h"
+#include "vic_pipeline.h"
+#include "video_stream.h"
+#include "output_stream.h"
+#include "live_view.h"
+#include "cia6526.h"
+
+namespace {
+
+using namespace test;
+
+const unsigned FRAMES = 100;
+
+tpixel frameBuffer[ILI9341_TFTWIDTH * ILI9341_TFTHEIGHT];
+
+//Boots a machine and runs it for FRAMES frames, returns the hash of RAM and frame buffer
+uint64_t run(bool pipelined) {
+    memset(frameBuffer, 0, sizeof(frameBuffer));
+
+    tcpu *m = machineCreate(frameBuffer, nullptr);
+
+    machineBind(m);
+    if(pipelined) { vicPipelineStart(cpu().vic); }
+    machineReset();
+    machineBoot();
+    while(machineBooting()) { machineLine(); }
+
+    for(uint32_t line = 0; line < FRAMES * LINECNT; line++) {
+        machineLine();
+    }
+
+    vicPipelineFlush(cpu().vic);
+
+    uint64_t h = fnv1a(cpu().RAM, sizeof(cpu().RAM)) ^ fnv1a(frameBuffer, sizeof(frameBuffer));
+
+    machineDestroy(m);
+
+    return h;
+}
+
+void testPipeline() {
+    CHECK(run(true) == run(false));
+}
+
+void testStream() {
+    tstream<unsigned, 4> block(STREAM_BLOCK);
+    std::atomic<bool> ok{true};
+
+    std::thread consumer([&] {
+        for(unsigned i = 0; i < 10000;) {
+            if(const unsigned *v = block.acquire()) {
+                if(*v != i++) { ok = false; }
+            }
+        }
+    });
+
+    for(unsigned i = 0; i < 10000; i++) {
+        block.slot() = i;
+        block.publish();
+    }
+    consumer.join();
+
+    CHECK(ok);
+    CHECK(block.dropped == 0);
+
+    tstream<unsigned, 4> drop(STREAM_DROP);
+
+    for(unsigned i = 0; i < 5; i++) {
+        drop.slot() = i;
+        drop.publish();
+    }
+
+    CHECK(drop.dropped == 2); //one slot is kept free for the producer
+    CHECK(*drop.acquire() == 0);
+    CHECK(*drop.acquire() == 1);
+    CHECK(*drop.acquire() == 2);
+    CHECK(drop.acquire() == nullptr);
+
+    tstream<unsigned, 4> stretch(STREAM_STRETCH);
+
+    stretch.slot() = 7;
+    stretch.publish();
+
+    CHECK(*stretch.acquire() == 7);
+    CHECK(*stretch.acquire() == 7);
+}
+
+void testVideoStream() {
+    tcpu *m = boot(frameBuffer);
+    std::atomic<bool> done{false};
+    uint32_t frames = 0;
+    bool ordered = true;
+
+    videoStreamStart(cpu().vic, STREAM_BLOCK);
+
+    std::thread consumer([&] {
+        while(true) {
+            bool last = done; //all frames are published before done is set
+
+            if(const tframe *f = videoStreamAcquire(m->vic)) {
+                if(f->number != frames++) { ordered = false; }
+            } else if(last) {
+                break;
+            }
+        }
+    });
+
+    for(uint32_t line = 0; line < FRAMES * LINECNT; line++) {
+        machineLine();
+    }
+
+    done = true;
+    consumer.join();
+    videoStreamClose(cpu().vic);
+
+    CHECK(ordered);
+    CHECK(frames + 1 >= FRAMES && frames <= FRAMES + 1); //depends on the line the stream started in
+    CHECK(videoStreamDropped(cpu().vic) == 0);
+
+    videoStreamStop(cpu().vic);
+    machineDestroy(m);
+}
+
+void testOutputStream() {
+    AudioOutputStream out(STREAM_STRETCH);
+    int16_t samples[4 * AUDIO_BLOCK_SAMPLES];
+
+    for(unsigned i = 0; i < 3; i++) { out.update(); } //no SID on the host: silence
+
+    CHECK(out.read(samples, 4 * AUDIO_BLOCK_SAMPLES) == 3 * AUDIO_BLOCK_SAMPLES);
+    CHECK(samples[0] == 0 && samples[4 * AUDIO_BLOCK_SAMPLES - 1] == 0);
+    CHECK(out.dropped() == 0);
+}
+
+//The program must start the fast run of a decruncher, which must end before DECRUNCH_MAXCYCLES
+void testDecrunch(const char *examples, const char *program) {
+    bool started = false;
+    tcpu *m = boot(frameBuffer);
+
+    CHECK(load(examples, program));
+
+    for(uint32_t line = 0; line < 10 * REFRESHRATE * LINECNT; line++) {
+        machineLine();
+        if(cpu().decrunch.decruncher) { started = true; }
+        if(started && !cpu().decrunch.decruncher) { break; }
+    }
+
+    CHECK(started);
+    CHECK(!cpu().decrunch.decruncher);
+    CHECK(cpu().decrunch.cycles > 0 && cpu().decrunch.cycles < DECRUNCH_MAXCYCLES);
+
+    machineDestroy(m);
+}
+
+//A reset keeps the CPU turbo, the KERNAL still sets up the CIA timers at 1x
+void testTurboReset() {
+    tcpu *m = boot(frameBuffer);
+    uint16_t latch = cpu().cia1.W16[CIA_TALO / 2];
+
+    cpu_setTurbo(TURBO_MAX);
+    machineReset();
+    machineBoot();
+    while(machineBooting()) { machineLine(); }
+
+    CHECK(cpu().turbo == TURBO_MAX);
+    CHECK(cpu().cia1.W16[CIA_TALO / 2] == latch);
+
+    machineDestroy(m);
+}
+
+void testLiveView() {
+    char name[64];
+
+    snprintf(name, sizeof(name), "/t64-test-%d", (int) getpid());
+
+    tcpu *m = machineCreate(frameBuffer, nullptr, name);
+
+    CHECK(m != nullptr);
+
+    int fd = shm_open(name, O_RDONLY, 0);
+
+    CHECK(fd >= 0);
+    if(fd < 0) {
+        machineDestroy(m);
+        return;
+    }
+
+    const tliveView *header = (const tliveView *) mmap(nullptr, sizeof(tliveView), PROT_READ, MAP_SHARED, fd, 0);
+    unsigned size = header->size;
+    const uint8_t *view = (const uint8_t *) mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+
+    close(fd);
+
+    CHECK(strcmp(header->magic, LIVE_VIEW_MAGIC) == 0);
+    CHECK(header->version == LIVE_VIEW_VERSION);
+
+    machineBind(m);
+    machineReset();
+    machineBoot();
+    while(machineBooting()) { machineLine(); }
+    for(uint32_t line = 0; line < 10 * LINECNT; line++) {
+        machineLine();
+    }
+
+    CHECK(memcmp(view + header->ram, cpu().RAM, sizeof(cpu().RAM)) == 0);
+    CHECK(*(const uint16_t *) (view + header->pc) == cpu().pc);
+
+    munmap((void *) view, size);
+    munmap((void *) header, sizeof(tliveView));
+    machineDestroy(m);
+
+    CHECK(shm_open(name, O_RDONLY, 0) < 0); //removed with the machine
+}
+
+}
+
+int main(int argc, char **argv) {
+    if(argc != 2) {
+        fprintf(stderr, "Usage: %s <directory of the sample programs>\n", argv[0]);
+        return 2;
+    }
+
+    testPipeline();
+    testStream();
+    testVideoStream();
+    testOutputStream();
+    testLiveView();
+    testTurboReset();
+    testDecrunch(argv[1], "Radwar.prg"); //Exomizer SFX
+
+    return result("host_tools");
+}
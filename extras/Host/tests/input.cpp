@@ -0,0 +1,127 @@
+/*
+	Copyright Frank Bösing, Karsten Fleischer, 2026
+
+	This file is part of Teensy64.
+
+    Teensy64 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Teensy64 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Teensy64.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von Teensy64.
+
+    Teensy64 ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Teensy64 wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+*/
+
+/*
+  Test of the record and replay of input.h, with the SD card in a temporary directory. A
+  session with keys typed at the READY prompt is recorded, its replay must match the hashes
+  of the recording. A second replay with a RAM byte changed on the way must report the
+  first hash after it as the frame where it diverged.
+*/
+
+#include <cstdlib>
+#include <unistd.h>
+
+#include "test.h"
+#include "input.h"
+
+namespace {
+
+using namespace test;
+
+tpixel frameBuffer[ILI9341_TFTWIDTH * ILI9341_TFTHEIGHT];
+
+const uint32_t FRAMES = 4 * INPUT_HASH_FRAMES;
+
+void runFrames(uint32_t frames) {
+    for(uint32_t line = 0; line < frames * LINECNT; line++) { oneRasterLine(); }
+}
+
+//Records FRAMES frames with a few keys, they wait for the READY prompt in the keyboard buffer
+void record() {
+    inputRecordToggle();
+    runFrames(1);
+    for(const char *k = "PRINT 6502\r"; *k; k++) {
+        while(!inputKey(*k)) { oneRasterLine(); }
+    }
+    runFrames(FRAMES);
+    inputRecordToggle();
+    runFrames(1);
+}
+
+//Replays the recording, with the byte at address changed at the frame change, 0: never
+uint32_t replay(uint16_t address, uint32_t change) {
+    inputReplayToggle();
+    if(change) {
+        runFrames(change);
+        cpu().RAM[address] ^= 0xFF;
+    }
+    runFrames(FRAMES + 20 - change); //to the end of the recording
+
+    return inputDivergence();
+}
+
+void testInput() {
+    char directory[] = "/tmp/t64-input-XXXXXX";
+
+    CHECK(mkdtemp(directory) != nullptr);
+    setenv("TEENSY64_SD", directory, 1);
+    SDinitialized = true;
+
+    tcpu *m = boot(frameBuffer);
+
+    record();
+
+    uint32_t diverged = replay(0, 0);
+
+    printf("replay: %s\n", diverged ? "diverged" : "matches");
+    CHECK(diverged == 0);
+
+    //$02A7-$02FF: unused RAM, nothing writes it back
+    uint32_t change = INPUT_HASH_FRAMES + 10;
+
+    diverged = replay(0x02A7, change);
+    printf("replay with a change at frame %u: diverged at frame %u\n", (unsigned) change, (unsigned) diverged);
+    CHECK(diverged > change && diverged <= change + INPUT_HASH_FRAMES);
+
+    machineDestroy(m);
+
+    char path[64];
+
+    snprintf(path, sizeof(path), "%s%s", directory, INPUT_FILE);
+    unlink(path);
+    rmdir(directory);
+}
+
+}
+
+int main() {
+#if INPUT_HASH_FRAMES
+    testInput();
+#else
+    printf("input: skipped, INPUT_HASH_FRAMES is 0\n");
+    return 0;
+#endif
+
+    return result("input");
+}
@@ -0,0 +1,175 @@
+/*
+	Copyright Frank Bösing, Karsten Fleischer, 2026
+
+	This file is part of Teensy64.
+
+    Teensy64 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Teensy64 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Teensy64.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von Teensy64.
+
+    Teensy64 ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Teensy64 wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+*/
+
+/*
+  Test of the checkpoints of monitor.h, on a build with MONITOR 1 (make check runs it on the
+  build with the features of the firmware on). The test is the client on MONITOR_TCP and
+  runs the machine itself. A temporary checkpoint must stop the machine, also on the
+  zeropage and the stack, which the CPU reads and writes without the tables of the PLA.
+*/
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "test.h"
+#include "monitor.h"
+
+namespace {
+
+using namespace test;
+
+tpixel frameBuffer[ILI9341_TFTWIDTH * ILI9341_TFTHEIGHT];
+
+int client = -1;
+uint32_t requestId = 0;
+
+//Sends a command of the binary protocol of VICE, the machine sees it with the next monitorPoll()
+void send(uint8_t type, const uint8_t *body, uint32_t len) {
+    uint8_t header[11] = {0x02, 0x02, (uint8_t) len, (uint8_t) (len >> 8), (uint8_t) (len >> 16),
+                          (uint8_t) (len >> 24)};
+
+    requestId++;
+    memcpy(&header[6], &requestId, 4);
+    header[10] = type;
+
+    CHECK(write(client, header, sizeof(header)) == sizeof(header));
+    CHECK(len == 0 || write(client, body, len) == (ssize_t) len);
+    monitorPoll();
+}
+
+//Reads the responses and events until one of them is the hit of a checkpoint at start,
+//false if none comes within the timeout of the socket
+bool receiveHit(uint16_t start) {
+    static uint8_t rx[65536];
+    static size_t len = 0;
+    ssize_t n;
+
+    while((n = recv(client, rx + len, sizeof(rx) - len, 0)) > 0) {
+        len += n;
+
+        size_t p = 0;
+        bool hit = false;
+
+        while(len - p >= 12 && !hit) {
+            uint32_t bodyLen, id;
+
+            memcpy(&bodyLen, &rx[p + 2], 4);
+            memcpy(&id, &rx[p + 8], 4);
+            if(len - p < 12 + bodyLen) { break; }
+
+            const uint8_t *body = &rx[p + 12];
+
+            //CHECKPOINT_GET as an event: the checkpoint that stopped the machine
+            hit = rx[p + 6] == 0x11 && id == 0xFFFFFFFF && (body[5] | (body[6] << 8)) == start;
+            p += 12 + bodyLen;
+        }
+
+        memmove(rx, rx + p, len - p);
+        len -= p;
+
+        if(hit) { return true; }
+    }
+
+    return false;
+}
+
+//Sets a temporary checkpoint, runs the machine up to 100 frames and resumes it after the hit
+void testCheckpoint(const char *name, uint16_t start, uint16_t end, uint8_t op) {
+    uint8_t body[] = {(uint8_t) start, (uint8_t) (start >> 8), (uint8_t) end, (uint8_t) (end >> 8),
+                      1, 1, op, 1}; //stop, enabled, temporary
+    bool stopped = false;
+
+    send(0x12, body, sizeof(body)); //CHECKPOINT_SET, stops the machine
+    send(0xAA, nullptr, 0);         //EXIT
+    receiveHit(start);              //the responses, until the timeout
+
+    for(unsigned line = 0; line < 100 * LINECNT && !stopped; line++) {
+        stopped = monitorPoll();
+        if(!stopped) { machineLine(); }
+    }
+
+    bool hit = stopped && receiveHit(start);
+
+    printf("%s: %s\n", name, hit ? "hit" : "not hit");
+    CHECK(hit);
+
+    send(0xAA, nullptr, 0);
+}
+
+void testMonitor() {
+    boot(frameBuffer);
+    monitorStart();
+
+    sockaddr_in address{};
+
+    address.sin_family = AF_INET;
+    address.sin_port = htons(MONITOR_TCP);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    client = socket(AF_INET, SOCK_STREAM, 0);
+
+    timeval timeout = {0, 200000};
+
+    setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    if(connect(client, (sockaddr *) &address, sizeof(address)) != 0) {
+        printf("monitor: no connection to TCP port %d\n", MONITOR_TCP);
+        CHECK(false);
+        return;
+    }
+    monitorPoll();
+
+    //the IRQ of the KERNAL: the stores of the interrupt on the stack, the screen editor reads
+    //its pointer into the screen at $D1/$D2 with LDA ($D1),Y
+    testCheckpoint("store on the stack", 0x0100, 0x01FF, 2);
+    testCheckpoint("load in the zeropage", 0x00D1, 0x00D2, 1);
+    testCheckpoint("store in the RAM", 0x0400, 0x07E7, 2);
+
+    close(client);
+    monitorPoll();
+}
+
+}
+
+int main() {
+#if MONITOR
+    testMonitor();
+#else
+    printf("monitor: skipped, MONITOR is 0\n");
+    return 0;
+#endif
+
+    return result("monitor");
+}
@@ -0,0 +1,144 @@
+/*
+	Copyright Frank Bösing, Karsten Fleischer, 2026
+
+	This file is part of Teensy64.
+
+    Teensy64 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Teensy64 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Teensy64.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von Teensy64.
+
+    Teensy64 ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Teensy64 wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+*/
+
+/*
+  Test of rewind.h, on a build with REWIND_FRAMES > 0 (make check runs it on the build with
+  the features of the firmware on). A machine runs a demo the way the line clock interrupt
+  drives it, with the machine state hashed at the start of each frame. A rewind must bring
+  back the state of one of the frames a snapshot was taken in, at most REWIND_SECONDS
+  before, and a snapshot must not keep the machine waiting for more ticks than rewind.h
+  says.
+*/
+
+#include <map>
+
+#include "test.h"
+#include "rewind.h"
+
+namespace {
+
+using namespace test;
+
+tpixel frameBuffer[ILI9341_TFTWIDTH * ILI9341_TFTHEIGHT];
+
+std::map<uint32_t, uint64_t> snapshots; //frame -> machine hash when its snapshot was taken
+uint32_t frame = 0;
+bool capturing = false;
+unsigned wait = 0; //ticks the current snapshot has taken so far
+unsigned longestWait = 0;
+
+//One tick of the line clock, as oneRasterLine() without warp and exact timing
+void tick() {
+    if(rewindPoll()) {
+        longestWait = max(longestWait, ++wait);
+        return;
+    }
+
+    capturing = false;
+    wait = 0;
+    machineLine();
+
+    if(cpu().vic.rasterLine == 0) {
+        frame++;
+        if(rewindFrame()) {
+            snapshots[frame] = machineHash();
+            capturing = true;
+        }
+    }
+}
+
+//Runs the frames and the snapshot that may start in the last one
+void runFrames(uint32_t frames) {
+    for(uint32_t end = frame + frames; frame < end || capturing;) { tick(); }
+}
+
+//The frame of the snapshot with the machine state hash h, 0 if there is none
+uint32_t snapshotFrame(uint64_t h) {
+    for(auto &s : snapshots) {
+        if(s.second == h) { return s.first; }
+    }
+
+    return 0;
+}
+
+void testRewind(const char *examples) {
+    tcpu *m = boot(frameBuffer);
+
+    CHECK(load(examples, "deliri.prg"));
+
+    rewindInit();
+
+    for(unsigned i = 0; i < 3; i++) {
+        runFrames(20 * REWIND_FRAMES);
+
+        uint32_t now = frame;
+
+        rewindRequest();
+        rewindPoll(); //rewinds, the tick would go on with the next line
+
+        //back REWIND_SECONDS, or less if the ring no longer holds that snapshot
+        uint32_t target = snapshotFrame(machineHash());
+
+        CHECK(target > 0);
+        CHECK(now - target <= REWIND_SECONDS * REFRESHRATE && now - target >= REWIND_FRAMES);
+
+        //the snapshots after the target are gone, and so is the time since then
+        snapshots.erase(snapshots.upper_bound(target), snapshots.end());
+        frame = target;
+    }
+
+    CHECK(snapshots.size() > 1);
+    CHECK(longestWait > 0 && longestWait <= 3 * 17);
+
+    machineDestroy(m);
+}
+
+}
+
+int main(int argc, char **argv) {
+    if(argc != 2) {
+        fprintf(stderr, "Usage: %s <directory of the sample programs>\n", argv[0]);
+        return 2;
+    }
+
+#if REWIND_FRAMES
+    testRewind(argv[1]);
+#else
+    printf("rewind: skipped, REWIND_FRAMES is 0\n");
+    return 0;
+#endif
+
+    return result("rewind");
+}
@@ -0,0 +1,141 @@
+/*
+	Copyright Frank Bösing, Karsten Fleischer, 2026
+
+	This file is part of Teensy64.
+
+    Teensy64 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Teensy64 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Teensy64.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von Teensy64.
+
+    Teensy64 ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Teensy64 wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+*/
+
+/*
+  Helpers of the host tests: checks, hashes, and machines that run a sample program.
+*/
+
+#pragma once
+
+#ifndef TEENSY64_HOST_TEST_H
+#define TEENSY64_HOST_TEST_H
+
+#include <cstdio>
+#include <cstring>
+
+#include "teensy64.h"
+#include "machine.h"
+
+#if MACHINES < 2
+#error Teensy64 host tests: build with MACHINES > 1
+#endif
+
+namespace test {
+
+inline unsigned failures = 0;
+
+#define CHECK(condition) test::check(condition, #condition, __FILE__, __LINE__)
+
+inline void check(bool ok, const char *condition, const char *file, int line) {
+    if(!ok) {
+        printf("%s:%d: failed: %s\n", file, line, condition);
+        failures++;
+    }
+}
+
+// Prints the result of the test program, returns its exit code.
+inline int result(const char *name) {
+    printf("%s: %s\n", name, failures ? "FAILED" : "ok");
+
+    return failures ? 1 : 0;
+}
+
+inline uint64_t fnv1a(const void *data, size_t len, uint64_t h = 1469598103934665603ull) {
+    const uint8_t *p = (const uint8_t *) data;
+
+    for(size_t i = 0; i < len; i++) {
+        h ^= p[i];
+        h *= 1099511628211ull;
+    }
+
+    return h;
+}
+
+// Hash of RAM, colour RAM and the CPU registers of the bound machine.
+inline uint64_t machineHash() {
+    uint8_t registers[] = {(uint8_t) cpu().pc, (uint8_t) (cpu().pc >> 8), cpu().a, cpu().x, cpu().y,
+                           cpu().sp, cpu().cpustatus};
+    uint64_t h = fnv1a(cpu().RAM, sizeof(cpu().RAM));
+
+    h = fnv1a(cpu().vic.colorRAM, sizeof(cpu().vic.colorRAM), h);
+    return fnv1a(registers, sizeof(registers), h);
+}
+
+// Creates a machine, binds it and boots it.
+inline tcpu *boot(tpixel *frameBuffer, const char *liveView = nullptr) {
+    tcpu *m = machineCreate(frameBuffer, nullptr, liveView);
+
+    machineBind(m);
+    machineReset();
+    machineBoot();
+    while(machineBooting()) { machineLine(); }
+
+    return m;
+}
+
+// Puts the program directory/name into RAM like LOAD"...",8,1 and RUN into the keyboard
+// buffer, as the batch runner does.
+inline bool load(const char *directory, const char *name) {
+    char path[512];
+
+    snprintf(path, sizeof(path), "%s/%s", directory, name);
+
+    FILE *f = fopen(path, "rb");
+
+    if(f == nullptr) { return false; }
+
+    uint8_t header[2];
+    bool ok = fread(header, 1, 2, f) == 2;
+    uint16_t address = header[0] | (header[1] << 8);
+    size_t len = ok ? fread(&cpu().RAM[address], 1, sizeof(cpu().RAM) - address, f) : 0;
+
+    fclose(f);
+
+    uint16_t end = address + len;
+
+    for(unsigned zp = 0x2D; zp <= 0x31; zp += 2) {
+        cpu().RAM[zp] = end & 0xFF;
+        cpu().RAM[zp + 1] = end >> 8;
+    }
+
+    memcpy(&cpu().RAM[0x277], "RUN\r", 4);
+    cpu().RAM[0xC6] = 4;
+
+    return ok && len > 0;
+}
+
+}
+
+#endif // TEENSY64_HOST_TEST_H
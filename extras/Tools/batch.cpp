@@ -0,0 +1,418 @@
+/*
+	Copyright Frank Bösing, Karsten Fleischer, 2026
+
+	This file is part of Teensy64.
+
+    Teensy64 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Teensy64 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Teensy64.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von Teensy64.
+
+    Teensy64 ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Teensy64 wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+*/
+
+/*
+  Batch runner: runs many programs on the host, one emulated machine per program, on all
+  cores, and reports a screenshot, RAM hash and timing for each of them.
+
+    batch [-j threads] [-s seconds] [-o directory] [-p] [-l name] program.prg ... [@list.txt ...]
+
+  A @file holds one program per line. Each program is put into RAM after the boot and
+  started with RUN, then runs for the given emulated seconds (default 10) at full host
+  speed, without SID and without the exact timing of the IEC bus. The screenshot of the
+  last frame goes to <directory>/<n>.ppm (default: no screenshots).
+  The report on stdout has one JSON object per program and a summary line with the
+  throughput in emulated machine-seconds per wall-second. Built with COUNTERS 1, the object
+  of each program has the counters of its run (see counters.h). Built with HEATMAP 1, the
+  heatmap of the last complete window goes to <directory>/<n>-heat.ppm (see heatmap.h),
+  one square per entry, the addresses from left to right and top to bottom. Built with
+  VIC_JOURNAL 1, the object has the number of VIC register writes, of lines with writes
+  and of dropped writes in the last frame, the journal of that frame goes to
+  <directory>/<n>-vic.csv (see vic_journal.h).
+
+  The tasks are spread over the threads round-robin, a thread that runs out of work
+  steals from the others. With -p, each machine draws its lines on a render thread of its
+  own (see vic_pipeline.h), then half as many threads as cores are a good choice.
+  With -l, the machine of program n lives in the shared memory segment <name>-<n> while it
+  runs (see live_view.h), e.g. -l /t64 gives /t64-0, /t64-1, ...
+
+  Build with make in extras/Host, which builds the core against the host port of the
+  Teensy libraries there. The runner is then extras/Host/build/batch. Serial messages of the
+  core go to stderr.
+*/
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+#include "teensy64.h"
+#include "machine.h"
+#include "vic_pipeline.h"
+#include "counters.h"
+#include "heatmap.h"
+#include "vic_journal.h"
+
+#if MACHINES < 2
+#error Teensy64 batch: build with MACHINES > 1
+#endif
+
+namespace {
+
+struct ttask {
+    std::string program;
+    unsigned index;
+
+    //results
+    bool loaded;
+    uint16_t loadAddress;
+    uint64_t ramHash;
+    uint64_t screenHash;
+    uint32_t frames;
+    double wallSeconds;
+#if COUNTERS
+    std::string counters; //JSON object
+#endif
+#if VIC_JOURNAL
+    unsigned vicWrites, vicLines, vicDropped;
+#endif
+};
+
+struct tworker {
+    std::mutex lock;
+    std::deque<ttask *> tasks;
+};
+
+std::vector<ttask> tasks;
+std::vector<tworker> workers;
+unsigned seconds = 10;
+bool pipelined = false;
+const char *screenshots = nullptr;
+const char *liveView = nullptr;
+
+uint64_t fnv1a(const void *data, size_t len) {
+    const uint8_t *p = (const uint8_t *) data;
+    uint64_t h = 1469598103934665603ull;
+
+    for(size_t i = 0; i < len; i++) {
+        h ^= p[i];
+        h *= 1099511628211ull;
+    }
+
+    return h;
+}
+
+//Puts the program into RAM like LOAD"...",8,1 and RUN into the keyboard buffer
+bool load(const char *name, uint16_t &address) {
+    FILE *f = fopen(name, "rb");
+
+    if(f == nullptr) { return false; }
+
+    uint8_t header[2];
+    bool ok = fread(header, 1, 2, f) == 2;
+
+    address = header[0] | (header[1] << 8);
+
+    size_t len = ok ? fread(&cpu().RAM[address], 1, sizeof(cpu().RAM) - address, f) : 0;
+
+    fclose(f);
+
+    if(!ok || len == 0) { return false; }
+
+    uint16_t end = address + len;
+
+    for(unsigned zp = 0x2D; zp <= 0x31; zp += 2) { //end of program, start of variables and arrays
+        cpu().RAM[zp] = end & 0xFF;
+        cpu().RAM[zp + 1] = end >> 8;
+    }
+
+    memcpy(&cpu().RAM[0x277], "RUN\r", 4);
+    cpu().RAM[0xC6] = 4;
+
+    return true;
+}
+
+void screenshot(const tpixel *frameBuffer, unsigned index) {
+    char name[512];
+
+    snprintf(name, sizeof(name), "%s/%u.ppm", screenshots, index);
+
+    FILE *f = fopen(name, "wb");
+
+    if(f == nullptr) { return; }
+
+    fprintf(f, "P6\n%d %d\n255\n", ILI9341_TFTWIDTH, ILI9341_TFTHEIGHT);
+
+    for(unsigned i = 0; i < ILI9341_TFTWIDTH * ILI9341_TFTHEIGHT; i++) {
+        tpixel p = frameBuffer[i];
+        uint8_t rgb[3] = {(uint8_t) ((p >> 11) << 3), (uint8_t) (((p >> 5) & 0x3F) << 2), (uint8_t) ((p & 0x1F) << 3)};
+        fwrite(rgb, 1, 3, f);
+    }
+
+    fclose(f);
+}
+
+#if HEATMAP
+void heatmapImage(unsigned index) {
+    const unsigned columns = 1u << ((16 - HEATMAP_SHIFT + 1) / 2);
+    const unsigned rows = HEATMAP_ENTRIES / columns;
+    const unsigned size = max(1u, 256 / columns); //pixels per square
+    char name[512];
+
+    snprintf(name, sizeof(name), "%s/%u-heat.ppm", screenshots, index);
+
+    FILE *f = fopen(name, "wb");
+
+    if(f == nullptr) { return; }
+
+    fprintf(f, "P6\n%u %u\n255\n", columns * size, rows * size);
+
+    for(unsigned y = 0; y < rows * size; y++) {
+        for(unsigned x = 0; x < columns * size; x++) {
+            uint8_t rgb[3];
+
+            heatmapColor((y / size) * columns + x / size, rgb);
+            fwrite(rgb, 1, 3, f);
+        }
+    }
+
+    fclose(f);
+}
+#endif
+
+#if VIC_JOURNAL
+void vicJournalCsv(unsigned index) {
+    char name[512];
+
+    snprintf(name, sizeof(name), "%s/%u-vic.csv", screenshots, index);
+
+    FILE *f = fopen(name, "w");
+
+    if(f == nullptr) { return; }
+
+    fprintf(f, "line,cycle,register,value\n");
+
+    for(unsigned i = 0; i < cpu().vicJournal.frame.count; i++) {
+        const tvicWrite &w = cpu().vicJournal.frame.writes[i];
+
+        fprintf(f, "%u,%u,%u,%u\n", w.line, w.cycle, w.reg, w.value);
+    }
+
+    fclose(f);
+}
+#endif
+
+void run(ttask &task) {
+    static thread_local tpixel frameBuffer[ILI9341_TFTWIDTH * ILI9341_TFTHEIGHT];
+    auto start = std::chrono::steady_clock::now();
+
+    memset(frameBuffer, 0, sizeof(frameBuffer));
+
+    std::string view = liveView ? std::string(liveView) + "-" + std::to_string(task.index) : "";
+    tcpu *m = machineCreate(frameBuffer, nullptr, liveView ? view.c_str() : nullptr);
+
+    machineBind(m);
+    if(pipelined) { vicPipelineStart(cpu().vic); }
+    machineReset();
+    machineBoot();
+    while(machineBooting()) { machineLine(); }
+
+    task.loaded = load(task.program.c_str(), task.loadAddress);
+    task.frames = task.loaded ? seconds * REFRESHRATE : 0;
+
+    for(uint32_t line = 0; line < task.frames * LINECNT; line++) {
+        machineLine();
+    }
+
+    vicPipelineFlush(cpu().vic);
+
+#if COUNTERS
+    char counters[COUNTERS_JSON_SIZE];
+
+    countersJson(counters, sizeof(counters));
+    task.counters = counters;
+#endif
+
+    task.ramHash = fnv1a(cpu().RAM, sizeof(cpu().RAM));
+    task.screenHash = fnv1a(frameBuffer, sizeof(frameBuffer));
+
+    if(screenshots && task.loaded) { screenshot(frameBuffer, task.index); }
+#if HEATMAP
+    if(screenshots && task.loaded) { heatmapImage(task.index); }
+#endif
+#if VIC_JOURNAL
+    task.vicWrites = cpu().vicJournal.frame.count + cpu().vicJournal.frame.dropped;
+    task.vicLines = vicJournalLines();
+    task.vicDropped = cpu().vicJournal.frame.dropped;
+    if(screenshots && task.loaded) { vicJournalCsv(task.index); }
+#endif
+
+    machineDestroy(m);
+
+    task.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+//Own tasks from the back, stolen ones from the front
+ttask *next(unsigned self) {
+    for(unsigned i = 0; i < workers.size(); i++) {
+        tworker &w = workers[(self + i) % workers.size()];
+        std::lock_guard<std::mutex> guard(w.lock);
+
+        if(w.tasks.empty()) { continue; }
+
+        ttask *task;
+
+        if(i == 0) {
+            task = w.tasks.back();
+            w.tasks.pop_back();
+        } else {
+            task = w.tasks.front();
+            w.tasks.pop_front();
+        }
+
+        return task;
+    }
+
+    return nullptr;
+}
+
+void worker(unsigned self) {
+    while(ttask *task = next(self)) { run(*task); }
+}
+
+void addList(const char *name) {
+    FILE *f = fopen(name, "r");
+    char line[1024];
+
+    if(f == nullptr) {
+        fprintf(stderr, "Can't open %s\n", name);
+        exit(1);
+    }
+
+    while(fgets(line, sizeof(line), f)) {
+        line[strcspn(line, "\r\n")] = 0;
+        if(line[0]) { tasks.push_back({line}); }
+    }
+
+    fclose(f);
+}
+
+void printJsonString(const std::string &s) {
+    putchar('"');
+
+    for(char c : s) {
+        if(c == '"' || c == '\\') {
+            printf("\\%c", c);
+        } else if((uint8_t) c < 0x20) {
+            printf("\\u%04x", c);
+        } else {
+            putchar(c);
+        }
+    }
+
+    putchar('"');
+}
+
+}
+
+int main(int argc, char **argv) {
+    unsigned threads = std::thread::hardware_concurrency();
+    int opt;
+
+    while((opt = getopt(argc, argv, "j:s:o:pl:")) != -1) {
+        switch(opt) {
+            case 'j': threads = atoi(optarg); break;
+            case 's': seconds = atoi(optarg); break;
+            case 'o': screenshots = optarg; break;
+            case 'p': pipelined = true; break;
+            case 'l': liveView = optarg; break;
+            default:
+                fprintf(stderr, "Usage: %s [-j threads] [-s seconds] [-o directory] [-p] [-l name] program.prg ... [@list.txt ...]\n", argv[0]);
+                return 1;
+        }
+    }
+
+    for(int i = optind; i < argc; i++) {
+        if(argv[i][0] == '@') {
+            addList(argv[i] + 1);
+        } else {
+            tasks.push_back({argv[i]});
+        }
+    }
+
+    if(threads == 0) { threads = 1; }
+
+    workers = std::vector<tworker>(threads);
+
+    for(unsigned i = 0; i < tasks.size(); i++) {
+        tasks[i].index = i;
+        workers[i % threads].tasks.push_back(&tasks[i]);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> pool;
+
+    for(unsigned i = 0; i < threads; i++) { pool.emplace_back(worker, i); }
+    for(auto &t : pool) { t.join(); }
+
+    double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    double machineSeconds = 0;
+
+    for(const ttask &task : tasks) {
+        double emulated = task.frames / REFRESHRATE;
+
+        machineSeconds += emulated;
+
+        printf("{\"index\": %u, \"program\": ", task.index);
+        printJsonString(task.program);
+        printf(", \"loaded\": %s, \"loadAddress\": %u, \"frames\": %u, \"ramHash\": \"%016llx\", "
+               "\"screenHash\": \"%016llx\", \"wallSeconds\": %.3f, \"speed\": %.2f",
+               task.loaded ? "true" : "false", task.loadAddress, task.frames,
+               (unsigned long long) task.ramHash, (unsigned long long) task.screenHash,
+               task.wallSeconds, task.wallSeconds > 0 ? emulated / task.wallSeconds : 0.0);
+#if COUNTERS
+        printf(", \"counters\": %s", task.counters.c_str());
+#endif
+#if VIC_JOURNAL
+        printf(", \"vicJournal\": {\"writes\": %u, \"lines\": %u, \"dropped\": %u}",
+               task.vicWrites, task.vicLines, task.vicDropped);
+#endif
+        printf("}\n");
+    }
+
+    printf("{\"programs\": %u, \"threads\": %u, \"wallSeconds\": %.3f, \"machineSeconds\": %.1f, "
+           "\"machineSecondsPerSecond\": %.2f}\n",
+           (unsigned) tasks.size(), threads, wallSeconds, machineSeconds,
+           wallSeconds > 0 ? machineSeconds / wallSeconds : 0.0);
+
+    return 0;
+}
@@ -0,0 +1,704 @@
+/*
+	Copyright Frank Bösing, Karsten Fleischer, 2026
+
+	This file is part of Teensy64.
+
+    Teensy64 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Teensy64 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Teensy64.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von Teensy64.
+
+    Teensy64 ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Teensy64 wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+*/
+
+#include <cstring>
+#include "teensy64.h"
+#include "basic_fp.h"
+
+namespace {
+
+/*
+  Just enough of a 6502 to run the floating point code of the BASIC ROM natively.
+  Every method is one instruction of the ROM code and counts its cycles, so the
+  routines below read like the ROM listing (labels are named after the addresses).
+  All operands are zero page addresses, none of them touches I/O.
+*/
+struct fp6502 {
+    uint8_t *const zp = cpu().RAM;
+    uint8_t a, x, y;
+    uint8_t n, z, c, v;
+    unsigned ticks = 0;
+
+    struct tflags {
+        uint8_t n, z, c, v;
+    } stacked{};
+
+    void setnz(uint8_t value) {
+        n = value & 0x80;
+        z = value == 0;
+    }
+
+    //loads and stores
+    void lda_imm(uint8_t m) { setnz(a = m); ticks += 2; }
+    void lda_zp(uint8_t ad) { setnz(a = zp[ad]); ticks += 3; }
+    void lda_zpx(uint8_t ad) { setnz(a = zp[(uint8_t) (ad + x)]); ticks += 4; }
+    void lda_absy(uint16_t ad) { setnz(a = zp[ad + y]); ticks += 4; } //only used with $0001..$0004,Y
+    void ldx_imm(uint8_t m) { setnz(x = m); ticks += 2; }
+    void ldx_zp(uint8_t ad) { setnz(x = zp[ad]); ticks += 3; }
+    void ldy_imm(uint8_t m) { setnz(y = m); ticks += 2; }
+    void ldy_zp(uint8_t ad) { setnz(y = zp[ad]); ticks += 3; }
+    void ldy_zpx(uint8_t ad) { setnz(y = zp[(uint8_t) (ad + x)]); ticks += 4; }
+    void sta_zp(uint8_t ad) { zp[ad] = a; ticks += 3; }
+    void sta_zpx(uint8_t ad) { zp[(uint8_t) (ad + x)] = a; ticks += 4; }
+    void stx_zp(uint8_t ad) { zp[ad] = x; ticks += 3; }
+    void sty_zp(uint8_t ad) { zp[ad] = y; ticks += 3; }
+    void sty_zpx(uint8_t ad) { zp[(uint8_t) (ad + x)] = y; ticks += 4; }
+
+    //register operations
+    void tay() { setnz(y = a); ticks += 2; }
+    void tya() { setnz(a = y); ticks += 2; }
+    void inx() { setnz(++x); ticks += 2; }
+    void iny() { setnz(++y); ticks += 2; }
+    void dex() { setnz(--x); ticks += 2; }
+    void clc() { c = 0; ticks += 2; }
+    void sec() { c = 1; ticks += 2; }
+    void php() { stacked = {n, z, c, v}; ticks += 3; }
+    void plp() { n = stacked.n; z = stacked.z; c = stacked.c; v = stacked.v; ticks += 4; }
+
+    //arithmetic and logic (binary mode only, basicFP() refuses to run with the decimal flag set)
+    void adc(uint8_t m) {
+        unsigned r = a + m + c;
+        v = (~(a ^ m) & (a ^ r) & 0x80) != 0;
+        c = r >> 8;
+        setnz(a = r);
+    }
+    void adc_imm(uint8_t m) { adc(m); ticks += 2; }
+    void adc_zp(uint8_t ad) { adc(zp[ad]); ticks += 3; }
+    void sbc_imm(uint8_t m) { adc(~m); ticks += 2; }
+    void sbc_zp(uint8_t ad) { adc(~zp[ad]); ticks += 3; }
+    void sbc_zpx(uint8_t ad) { adc(~zp[(uint8_t) (ad + x)]); ticks += 4; }
+    void eor_imm(uint8_t m) { setnz(a ^= m); ticks += 2; }
+    void ora_imm(uint8_t m) { setnz(a |= m); ticks += 2; }
+    void cmp(uint8_t r, uint8_t m) { c = r >= m; setnz(r - m); }
+    void cmp_imm(uint8_t m) { cmp(a, m); ticks += 2; }
+    void cpx_imm(uint8_t m) { cmp(x, m); ticks += 2; }
+    void cpy_zp(uint8_t ad) { cmp(y, zp[ad]); ticks += 3; }
+    void bit(uint8_t m) { n = m & 0x80; v = (m & 0x40) != 0; z = (a & m) == 0; }
+    void bit_zp(uint8_t ad) { bit(zp[ad]); ticks += 3; }
+    void bit_abs(uint16_t ad) { bit(cpu().RAM[ad]); ticks += 4; }
+
+    //shifts and increments
+    uint8_t asl(uint8_t m) { c = m >> 7; setnz(m <<= 1); return m; }
+    uint8_t rol(uint8_t m) { uint8_t r = (m << 1) | c; c = m >> 7; setnz(r); return r; }
+    uint8_t ror(uint8_t m) { uint8_t r = (m >> 1) | (c << 7); c = m & 1; setnz(r); return r; }
+    uint8_t lsr(uint8_t m) { c = m & 1; setnz(m >>= 1); return m; }
+    void asl_a() { a = asl(a); ticks += 2; }
+    void ror_a() { a = ror(a); ticks += 2; }
+    void lsr_a() { a = lsr(a); ticks += 2; }
+    void asl_zp(uint8_t ad) { zp[ad] = asl(zp[ad]); ticks += 5; }
+    void rol_zp(uint8_t ad) { zp[ad] = rol(zp[ad]); ticks += 5; }
+    void ror_zp(uint8_t ad) { zp[ad] = ror(zp[ad]); ticks += 5; }
+    void asl_zpx(uint8_t ad) { uint8_t e = ad + x; zp[e] = asl(zp[e]); ticks += 6; }
+    void ror_zpx(uint8_t ad) { uint8_t e = ad + x; zp[e] = ror(zp[e]); ticks += 6; }
+    void lsr_zpx(uint8_t ad) { uint8_t e = ad + x; zp[e] = lsr(zp[e]); ticks += 6; }
+    void inc_zp(uint8_t ad) { setnz(++zp[ad]); ticks += 5; }
+    void inc_zpx(uint8_t ad) { setnz(++zp[(uint8_t) (ad + x)]); ticks += 6; }
+
+    //control flow, "page" is set for branches crossing a page boundary
+    bool branch(bool taken, bool page = false) { ticks += taken ? (page ? 4 : 3) : 2; return taken; }
+    void jsr() { ticks += 6; }
+    void rts() { ticks += 6; }
+    void jmp() { ticks += 3; }
+    void pla() { ticks += 4; }
+
+    enum tresult { RETURNED, POPPED, OVERFLOW };
+
+    //Subroutines
+    void movfa();
+    void negfac();
+    void incfac();
+    void shiftr(uint16_t entry);
+    tresult normal();
+    tresult round();
+    tresult muldiv();
+    void mltply(uint16_t entry);
+
+    //Trapped entry points
+    tresult faddt();
+    tresult fmultt();
+    tresult fdivt();
+};
+
+// $BBFC MOVFA: FAC = ARG
+void fp6502::movfa() {
+    lda_zp(0x6E);
+    sta_zp(0x66);
+    ldx_imm(0x05);
+    do {
+        lda_zpx(0x68);
+        sta_zpx(0x60);
+        dex();
+    } while(branch(!z));
+    stx_zp(0x70);
+    rts();
+}
+
+// $B947 NEGFAC: two's complement of the FAC mantissa including the rounding byte
+void fp6502::negfac() {
+    lda_zp(0x66);
+    eor_imm(0xFF);
+    sta_zp(0x66);
+    lda_zp(0x62);
+    eor_imm(0xFF);
+    sta_zp(0x62);
+    lda_zp(0x63);
+    eor_imm(0xFF);
+    sta_zp(0x63);
+    lda_zp(0x64);
+    eor_imm(0xFF);
+    sta_zp(0x64);
+    lda_zp(0x65);
+    eor_imm(0xFF);
+    sta_zp(0x65);
+    lda_zp(0x70);
+    eor_imm(0xFF);
+    sta_zp(0x70);
+    inc_zp(0x70);
+    if(branch(!z)) { rts(); return; }
+    incfac();
+}
+
+// $B96F: increment FAC mantissa
+void fp6502::incfac() {
+    inc_zp(0x65);
+    if(branch(!z)) { rts(); return; }
+    inc_zp(0x64);
+    if(branch(!z)) { rts(); return; }
+    inc_zp(0x63);
+    if(branch(!z)) { rts(); return; }
+    inc_zp(0x62);
+    rts();
+}
+
+// $B983 MULSHF, $B999 SHIFTR, $B9B0: shift the register at X+1 right by -A bits
+void fp6502::shiftr(uint16_t entry) {
+    if(entry == 0xB9B0) { goto b9b0; }
+    if(entry == 0xB999) { goto b999; }
+
+    ldx_imm(0x25);
+b985:
+    ldy_zpx(0x04);
+    sty_zp(0x70);
+    ldy_zpx(0x03);
+    sty_zpx(0x04);
+    ldy_zpx(0x02);
+    sty_zpx(0x03);
+    ldy_zpx(0x01);
+    sty_zpx(0x02);
+    ldy_zp(0x68);
+    sty_zpx(0x01);
+b999:
+    adc_imm(0x08);
+    if(branch(n)) { goto b985; }
+    if(branch(z)) { goto b985; }
+    sbc_imm(0x08);
+    tay();
+    lda_zp(0x70);
+    if(branch(c)) { goto b9ba; }
+b9a6:
+    asl_zpx(0x01);
+    if(!branch(!c)) {
+        inc_zpx(0x01);
+    }
+    ror_zpx(0x01);
+    ror_zpx(0x01);
+b9b0:
+    ror_zpx(0x02);
+    ror_zpx(0x03);
+    ror_zpx(0x04);
+    ror_a();
+    iny();
+    if(branch(!z)) { goto b9a6; }
+b9ba:
+    clc();
+    rts();
+}
+
+// $B8D7 NORMAL: normalize FAC, $B936/$B938 handle a carry out of the mantissa
+fp6502::tresult fp6502::normal() {
+    ldy_imm(0x00);
+    tya();
+    clc();
+b8db:
+    ldx_zp(0x62);
+    if(branch(!z, true)) { goto b929; }
+    ldx_zp(0x63);
+    stx_zp(0x62);
+    ldx_zp(0x64);
+    stx_zp(0x63);
+    ldx_zp(0x65);
+    stx_zp(0x64);
+    ldx_zp(0x70);
+    stx_zp(0x65);
+    sty_zp(0x70);
+    adc_imm(0x08);
+    cmp_imm(0x20);
+    if(branch(!z)) { goto b8db; }
+b8f7:
+    lda_imm(0x00);
+    sta_zp(0x61);
+    sta_zp(0x66);
+    rts();
+    return RETURNED;
+b91d:
+    adc_imm(0x01);
+    asl_zp(0x70);
+    rol_zp(0x65);
+    rol_zp(0x64);
+    rol_zp(0x63);
+    rol_zp(0x62);
+b929:
+    if(branch(!n)) { goto b91d; }
+    sec();
+    sbc_zp(0x61);
+    if(branch(c, true)) { goto b8f7; }
+    eor_imm(0xFF);
+    adc_imm(0x01);
+    sta_zp(0x61);
+    if(branch(!c)) { rts(); return RETURNED; }
+    inc_zp(0x61);
+    if(branch(z)) { return OVERFLOW; }
+    ror_zp(0x62);
+    ror_zp(0x63);
+    ror_zp(0x64);
+    ror_zp(0x65);
+    ror_zp(0x70);
+    rts();
+    return RETURNED;
+}
+
+// $BC1B ROUND: round FAC using the rounding byte
+fp6502::tresult fp6502::round() {
+    lda_zp(0x61);
+    if(branch(z)) { rts(); return RETURNED; }
+    asl_zp(0x70);
+    if(branch(!c)) { rts(); return RETURNED; }
+    jsr();
+    incfac();
+    if(branch(!z)) { rts(); return RETURNED; }
+    jmp();
+    inc_zp(0x61);
+    if(branch(z)) { return OVERFLOW; }
+    ror_zp(0x62);
+    ror_zp(0x63);
+    ror_zp(0x64);
+    ror_zp(0x65);
+    ror_zp(0x70);
+    rts();
+    return RETURNED;
+}
+
+// $BAB7 MULDIV: add exponents, POPPED if the result is zero (the ROM drops the return address)
+fp6502::tresult fp6502::muldiv() {
+    lda_zp(0x69);
+    if(branch(z)) { goto bada; }
+    clc();
+    adc_zp(0x61);
+    if(branch(!c)) {
+        if(branch(!n)) { goto bada; }
+    } else {
+        if(branch(n)) { return OVERFLOW; }
+        clc();
+        bit_abs(0x1410);
+    }
+    adc_imm(0x80);
+    sta_zp(0x61);
+    if(!branch(!z)) {
+        jmp();
+        sta_zp(0x66);
+        rts();
+        return RETURNED;
+    }
+    lda_zp(0x6F);
+    sta_zp(0x66);
+    rts();
+    return RETURNED;
+bada:
+    pla();
+    pla();
+    jmp();
+    lda_imm(0x00);
+    sta_zp(0x61);
+    sta_zp(0x66);
+    rts();
+    return POPPED;
+}
+
+// $BA59 MLTPLY, $BA5E MLTPL1: multiply ARG by A and add to RES
+void fp6502::mltply(uint16_t entry) {
+    if(entry == 0xBA59) {
+        if(!branch(!z)) {
+            jmp();
+            shiftr(0xB983);
+            return;
+        }
+    }
+    lsr_a();
+    ora_imm(0x80);
+    do {
+        tay();
+        if(!branch(!c)) {
+            clc();
+            lda_zp(0x29);
+            adc_zp(0x6D);
+            sta_zp(0x29);
+            lda_zp(0x28);
+            adc_zp(0x6C);
+            sta_zp(0x28);
+            lda_zp(0x27);
+            adc_zp(0x6B);
+            sta_zp(0x27);
+            lda_zp(0x26);
+            adc_zp(0x6A);
+            sta_zp(0x26);
+        }
+        ror_zp(0x26);
+        ror_zp(0x27);
+        ror_zp(0x28);
+        ror_zp(0x29);
+        ror_zp(0x70);
+        tya();
+        lsr_a();
+    } while(branch(!z));
+    rts();
+}
+
+// $B86A FADDT: FAC = ARG + FAC
+fp6502::tresult fp6502::faddt() {
+    if(!branch(!z)) {
+        jmp();
+        movfa();
+        return RETURNED;
+    }
+    ldx_zp(0x70);
+    stx_zp(0x56);
+    ldx_imm(0x69);
+    lda_zp(0x69);
+    tay();
+    if(branch(z)) { rts(); return RETURNED; }
+    sec();
+    sbc_zp(0x61);
+    if(branch(z)) { goto b8a3; }
+    if(branch(!c)) {
+        ldy_imm(0x00);
+        sty_zp(0x70);
+    } else {
+        sty_zp(0x61);
+        ldy_zp(0x6E);
+        sty_zp(0x66);
+        eor_imm(0xFF);
+        adc_imm(0x00);
+        ldy_imm(0x00);
+        sty_zp(0x56);
+        ldx_imm(0x61);
+        branch(true);
+    }
+    cmp_imm(0xF9);
+    if(branch(n)) {
+        jsr();
+        shiftr(0xB999);
+        branch(!c);
+    } else {
+        tay();
+        lda_zp(0x70);
+        lsr_zpx(0x01);
+        jsr();
+        shiftr(0xB9B0);
+    }
+b8a3:
+    bit_zp(0x6F);
+    if(branch(!n)) {
+        adc_zp(0x56);
+        sta_zp(0x70);
+        lda_zp(0x65);
+        adc_zp(0x6D);
+        sta_zp(0x65);
+        lda_zp(0x64);
+        adc_zp(0x6C);
+        sta_zp(0x64);
+        lda_zp(0x63);
+        adc_zp(0x6B);
+        sta_zp(0x63);
+        lda_zp(0x62);
+        adc_zp(0x6A);
+        sta_zp(0x62);
+        jmp();
+        if(branch(!c)) { rts(); return RETURNED; }
+        inc_zp(0x61);
+        if(branch(z)) { return OVERFLOW; }
+        ror_zp(0x62);
+        ror_zp(0x63);
+        ror_zp(0x64);
+        ror_zp(0x65);
+        ror_zp(0x70);
+        rts();
+        return RETURNED;
+    }
+    ldy_imm(0x61);
+    cpx_imm(0x69);
+    if(!branch(z)) {
+        ldy_imm(0x69);
+    }
+    sec();
+    eor_imm(0xFF);
+    adc_zp(0x56);
+    sta_zp(0x70);
+    lda_absy(0x0004);
+    sbc_zpx(0x04);
+    sta_zp(0x65);
+    lda_absy(0x0003);
+    sbc_zpx(0x03);
+    sta_zp(0x64);
+    lda_absy(0x0002);
+    sbc_zpx(0x02);
+    sta_zp(0x63);
+    lda_absy(0x0001);
+    sbc_zpx(0x01);
+    sta_zp(0x62);
+    if(!branch(c)) {
+        jsr();
+        negfac();
+    }
+    return normal();
+}
+
+// $BA2B FMULTT: FAC = ARG * FAC
+fp6502::tresult fp6502::fmultt() {
+    if(!branch(!z)) {
+        jmp();
+        rts();
+        return RETURNED;
+    }
+    jsr();
+    tresult r = muldiv();
+    if(r != RETURNED) { return r; }
+    lda_imm(0x00);
+    sta_zp(0x26);
+    sta_zp(0x27);
+    sta_zp(0x28);
+    sta_zp(0x29);
+    lda_zp(0x70);
+    jsr();
+    mltply(0xBA59);
+    lda_zp(0x65);
+    jsr();
+    mltply(0xBA59);
+    lda_zp(0x64);
+    jsr();
+    mltply(0xBA59);
+    lda_zp(0x63);
+    jsr();
+    mltply(0xBA59);
+    lda_zp(0x62);
+    jsr();
+    mltply(0xBA5E);
+    jmp();
+
+    //$BB8F MOVFR
+    lda_zp(0x26);
+    sta_zp(0x62);
+    lda_zp(0x27);
+    sta_zp(0x63);
+    lda_zp(0x28);
+    sta_zp(0x64);
+    lda_zp(0x29);
+    sta_zp(0x65);
+    jmp();
+    return normal();
+}
+
+// $BB12 FDIVT: FAC = ARG / FAC
+fp6502::tresult fp6502::fdivt() {
+    if(branch(z)) { return OVERFLOW; } //Division by zero, let the ROM raise the error
+    jsr();
+    if(round() != RETURNED) { return OVERFLOW; }
+    lda_imm(0x00);
+    sec();
+    sbc_zp(0x61);
+    sta_zp(0x61);
+    jsr();
+    tresult r = muldiv();
+    if(r != RETURNED) { return r; }
+    inc_zp(0x61);
+    if(branch(z, true)) { return OVERFLOW; }
+    ldx_imm(0xFC);
+    lda_imm(0x01);
+bb29:
+    ldy_zp(0x6A);
+    cpy_zp(0x62);
+    if(branch(!z)) { goto bb3f; }
+    ldy_zp(0x6B);
+    cpy_zp(0x63);
+    if(branch(!z)) { goto bb3f; }
+    ldy_zp(0x6C);
+    cpy_zp(0x64);
+    if(branch(!z)) { goto bb3f; }
+    ldy_zp(0x6D);
+    cpy_zp(0x65);
+bb3f:
+    php();
+    a = rol(a);
+    ticks += 2;
+    if(branch(!c)) { goto bb4c; }
+    inx();
+    sta_zpx(0x29);
+    if(branch(z)) {
+        lda_imm(0x40);
+        branch(true);
+        goto bb4c;
+    }
+    if(branch(!n)) {
+        asl_a();
+        asl_a();
+        asl_a();
+        asl_a();
+        asl_a();
+        asl_a();
+        sta_zp(0x70);
+        plp();
+        jmp();
+        lda_zp(0x26);
+        sta_zp(0x62);
+        lda_zp(0x27);
+        sta_zp(0x63);
+        lda_zp(0x28);
+        sta_zp(0x64);
+        lda_zp(0x29);
+        sta_zp(0x65);
+        jmp();
+        return normal();
+    }
+    lda_imm(0x01);
+bb4c:
+    plp();
+    if(branch(c)) {
+        tay();
+        lda_zp(0x6D);
+        sbc_zp(0x65);
+        sta_zp(0x6D);
+        lda_zp(0x6C);
+        sbc_zp(0x64);
+        sta_zp(0x6C);
+        lda_zp(0x6B);
+        sbc_zp(0x63);
+        sta_zp(0x6B);
+        lda_zp(0x6A);
+        sbc_zp(0x62);
+        sta_zp(0x6A);
+        tya();
+        jmp();
+    }
+    asl_zp(0x6D);
+    rol_zp(0x6C);
+    rol_zp(0x6B);
+    rol_zp(0x6A);
+    if(branch(c)) { goto bb3f; }
+    if(branch(n)) { goto bb29; }
+    branch(true);
+    goto bb3f;
+}
+
+struct tfppatch {
+    uint16_t address;
+    uint8_t opcode;
+    fp6502::tresult (fp6502::*fn)();
+};
+
+const tfppatch fppatches[] = {
+    {0xB86A, 0xD0, &fp6502::faddt},
+    {0xBA2B, 0xD0, &fp6502::fmultt},
+    {0xBB12, 0xF0, &fp6502::fdivt},
+};
+
+// FAC, ARG and the temporaries written by the routines above ($26..$70)
+const unsigned FPSAVE_FIRST = 0x26;
+const unsigned FPSAVE_LEN = 0x70 - FPSAVE_FIRST + 1;
+
+} // namespace
+
+uint8_t basicFPOpcode(uint16_t address) {
+    for(const auto &p : fppatches) {
+        if(p.address == address) { return p.opcode; }
+    }
+
+    return 0x02; //KIL
+}
+
+bool basicFP(uint16_t address) {
+    if(cpu().cpustatus & FLAG_DECIMAL) { return false; }
+
+    const tfppatch *patch = nullptr;
+
+    for(const auto &p : fppatches) {
+        if(p.address == address) {
+            patch = &p;
+            break;
+        }
+    }
+
+    if(patch == nullptr) { return false; }
+
+    uint8_t save[FPSAVE_LEN];
+    memcpy(save, &cpu().RAM[FPSAVE_FIRST], FPSAVE_LEN);
+
+    fp6502 fp;
+    fp.a = cpu().a;
+    fp.x = cpu().x;
+    fp.y = cpu().y;
+    fp.n = cpu().cpustatus & FLAG_SIGN;
+    fp.v = (cpu().cpustatus & FLAG_OVERFLOW) != 0;
+    fp.z = (cpu().cpustatus & FLAG_ZERO) != 0;
+    fp.c = cpu().cpustatus & FLAG_CARRY;
+
+    if((fp.*(patch->fn))() == fp6502::OVERFLOW) {
+        //Overflow or division by zero: Undo everything and let the ROM raise the error
+        memcpy(&cpu().RAM[FPSAVE_FIRST], save, FPSAVE_LEN);
+        return false;
+    }
+
+    cpu().a = fp.a;
+    cpu().x = fp.x;
+    cpu().y = fp.y;
+    cpu().cpustatus = (cpu().cpustatus & ~(FLAG_SIGN | FLAG_OVERFLOW | FLAG_ZERO | FLAG_CARRY)) |
+                      (fp.n ? FLAG_SIGN : 0) | (fp.v ? FLAG_OVERFLOW : 0) | (fp.z ? FLAG_ZERO : 0) | (fp.c ? FLAG_CARRY : 0);
+
+    //The final RTS of the routine
+    cpu().pc = (cpu().RAM[BASE_STACK + ((cpu().sp + 1) & 0xFF)] | (cpu().RAM[BASE_STACK + ((cpu().sp + 2) & 0xFF)] << 8)) + 1;
+    cpu().sp += 2;
+
+    cpu().ticks = (fp.ticks + BASICFP_CYCLEDIVIDER - 1) / BASICFP_CYCLEDIVIDER;
+
+    return true;
+}
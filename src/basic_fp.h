@@ -0,0 +1,63 @@
+/*
+	Copyright Frank Bösing, Karsten Fleischer, 2026
+
+	This file is part of Teensy64.
+
+    Teensy64 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Teensy64 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Teensy64.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von Teensy64.
+
+    Teensy64 ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Teensy64 wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+*/
+
+#pragma once
+
+#ifndef TEENSY64_BASIC_FP_H
+#define TEENSY64_BASIC_FP_H
+
+#include <cstdint>
+
+/*
+  Native versions of the floating point arithmetic of the BASIC ROM.
+
+  The entry points of FADDT ($B86A), FMULTT ($BA2B) and FDIVT ($BB12) are patched
+  with BASICFP_TRAP_OPCODE in rom_basic. All other floating point routines (FADD,
+  FSUB, FMULT, FDIV, FOUT, SQR, EXP, LOG, SIN, COS, TAN, ATN, POLY...) end up in
+  one of these three, so they are accelerated as well.
+  The native code works on the FAC/ARG registers in the zero page and produces the
+  same zero page contents, registers, flags and - with BASICFP_CYCLEDIVIDER 1 - the
+  same number of cycles as the ROM code.
+*/
+
+#define BASICFP_TRAP_OPCODE 0x32
+
+// Runs the routine trapped at address natively, returns false if the ROM code has to run instead.
+bool basicFP(uint16_t address);
+
+// Returns the original ROM opcode of a trapped address.
+uint8_t basicFPOpcode(uint16_t address);
+
+#endif // TEENSY64_BASIC_FP_H
@@ -0,0 +1,162 @@
+/*
+	Copyright Frank Bösing, Karsten Fleischer, 2026
+
+	This file is part of Teensy64.
+
+    Teensy64 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Teensy64 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Teensy64.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von Teensy64.
+
+    Teensy64 ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Teensy64 wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+*/
+
+#include <cstring>
+#include "teensy64.h"
+#include "kernal_editor.h"
+#include "boot_snapshot.h"
+
+namespace {
+
+//RAM contents after resetPLA()
+inline uint8_t powerOnRAM(unsigned address) {
+    return (address & 0x40) ? 0xFF : 0x00;
+}
+
+//Bytes equal to the power-on pattern that are stored anyway to avoid a new run
+const unsigned RUN_GAP = 8;
+
+void dumpBytes(const uint8_t *data, unsigned length) {
+    for(unsigned i = 0; i < length; i++) {
+        Serial.printf((i % 16 == 0) ? "        0x%02X," : " 0x%02X,", data[i]);
+        if(i % 16 == 15 || i == length - 1) { Serial.println(); }
+    }
+}
+
+void dumpRegisters(const char *name, const uint8_t *data, unsigned length) {
+    Serial.printf("        //%s\n        {\n", name);
+    dumpBytes(data, length);
+    Serial.println("        },");
+}
+
+//Finds the next run of RAM that differs from the power-on pattern at or after address
+bool nextRun(unsigned &address, unsigned &length) {
+    while(address <= 0xFFFF && cpu().RAM[address] == powerOnRAM(address)) { address++; }
+
+    if(address > 0xFFFF) { return false; }
+
+    unsigned end = address + 1;
+    unsigned gap = 0;
+
+    for(unsigned i = end; i <= 0xFFFF && gap < RUN_GAP; i++) {
+        if(cpu().RAM[i] == powerOnRAM(i)) {
+            gap++;
+        } else {
+            gap = 0;
+            end = i + 1;
+        }
+    }
+
+    length = end - address;
+    return true;
+}
+
+}
+
+void bootSnapshotRestore() {
+    const tbootSnapshot &s = bootSnapshot;
+    const uint8_t *data = s.ram;
+
+    for(unsigned i = 0; i < s.runCount; i++) {
+        memcpy(&cpu().RAM[s.runs[i].address], data, s.runs[i].length);
+        data += s.runs[i].length;
+    }
+
+    //6510 port: memory configuration
+    (*cpu().plamap_w)[0](1, cpu().RAM[1]);
+
+    memcpy(cpu().vic.colorRAM, s.colorRAM, sizeof(cpu().vic.colorRAM));
+
+    memcpy(cpu().cia1.R, s.cia1R, sizeof(cpu().cia1.R));
+    memcpy(cpu().cia1.W, s.cia1W, sizeof(cpu().cia1.W));
+    memcpy(cpu().cia2.R, s.cia2R, sizeof(cpu().cia2.R));
+    memcpy(cpu().cia2.W, s.cia2W, sizeof(cpu().cia2.W));
+
+    memcpy(cpu().vic.R, s.vic, sizeof(cpu().vic.R));
+    cpu().vic.intRasterLine = cpu().vic.R[VIC_RASTER] | ((cpu().vic.R[VIC_CR1] & VIC_CR1_RST8) ? 0x100 : 0);
+
+    cia2_restorePorts();
+
+    cpu().a = s.a;
+    cpu().x = s.x;
+    cpu().y = s.y;
+    cpu().sp = s.sp;
+    cpu().cpustatus = s.cpustatus;
+    cpu().pc = s.pc;
+
+    Serial.println("Boot snapshot restored.");
+}
+
+void bootSnapshotDump() {
+    unsigned address, length;
+
+    Serial.println((PAL == 1) ? "#if PAL == 1\n" : "#if PAL != 1\n");
+    Serial.println("namespace {\n\nconst tbootSnapshotRun runs[] = {");
+
+    unsigned runCount = 0;
+
+    for(address = 0; nextRun(address, length); address += length) {
+        Serial.printf("        {0x%04X, %u},\n", address, length);
+        runCount++;
+    }
+
+    Serial.println("};\n\nconst uint8_t ram[] = {");
+
+    for(address = 0; nextRun(address, length); address += length) {
+        Serial.printf("        //$%04X\n", address);
+        dumpBytes(&cpu().RAM[address], length);
+    }
+
+    Serial.println("};\n\n}\n\nconst tbootSnapshot bootSnapshot = {");
+    Serial.printf("        0x%02X, 0x%02X, 0x%02X, 0x%02X, 0x%02X, //A, X, Y, SP, P\n",
+                  cpu().a, cpu().x, cpu().y, cpu().sp, cpu().cpustatus);
+    Serial.printf("        0x%04X, //PC\n", cpu().pc);
+    dumpRegisters("VIC", cpu().vic.R, sizeof(cpu().vic.R));
+    dumpRegisters("CIA1 R", cpu().cia1.R, sizeof(cpu().cia1.R));
+    dumpRegisters("CIA1 W", cpu().cia1.W, sizeof(cpu().cia1.W));
+    dumpRegisters("CIA2 R", cpu().cia2.R, sizeof(cpu().cia2.R));
+    dumpRegisters("CIA2 W", cpu().cia2.W, sizeof(cpu().cia2.W));
+    dumpRegisters("colour RAM", cpu().vic.colorRAM, sizeof(cpu().vic.colorRAM));
+    Serial.printf("        %u, runs, ram\n};\n\n#endif\n", runCount);
+}
+
+void bootSnapshotDumpAtReady() {
+    static bool dumped = false;
+
+    if(!dumped && kernalKeyboardWait()) {
+        dumped = true;
+        bootSnapshotDump();
+    }
+}
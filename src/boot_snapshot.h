@@ -0,0 +1,88 @@
+/*
+	Copyright Frank Bösing, Karsten Fleischer, 2026
+
+	This file is part of Teensy64.
+
+    Teensy64 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Teensy64 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Teensy64.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von Teensy64.
+
+    Teensy64 ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Teensy64 wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+*/
+
+#pragma once
+
+#ifndef TEENSY64_BOOT_SNAPSHOT_H
+#define TEENSY64_BOOT_SNAPSHOT_H
+
+#include <cstdint>
+
+/*
+  Instant boot: the state of the machine at the READY prompt is stored in flash
+  (boot_snapshot_data.cpp) and restored at startup instead of running the KERNAL boot.
+
+  The snapshot contains the CPU registers, the RAM that differs from the power-on
+  pattern of resetPLA(), the colour RAM and the registers of VIC and CIAs.
+  There is one snapshot for PAL and one for NTSC, the KERNAL boot sets them up differently.
+
+  To regenerate boot_snapshot_data.cpp (e.g. after a ROM change), build with FASTBOOT 0
+  and BOOTSNAPSHOT_DUMP 1 for PAL and NTSC: the source is printed on the serial console
+  when the KERNAL waits for a key for the first time.
+*/
+
+struct tbootSnapshotRun {
+    uint16_t address;
+    uint16_t length;
+};
+
+struct tbootSnapshot {
+    uint8_t a, x, y, sp, cpustatus;
+    uint16_t pc;
+
+    uint8_t vic[0x40];
+    uint8_t cia1R[0x10];
+    uint8_t cia1W[0x10];
+    uint8_t cia2R[0x10];
+    uint8_t cia2W[0x10];
+    uint8_t colorRAM[1024];
+
+    uint16_t runCount;
+    const tbootSnapshotRun *runs; //RAM ranges, their contents are stored back to back in ram
+    const uint8_t *ram;
+};
+
+extern const tbootSnapshot bootSnapshot;
+
+// Restores the snapshot, the machine has to be reset before.
+void bootSnapshotRestore();
+
+// Prints the current state of the machine as source of boot_snapshot_data.cpp.
+void bootSnapshotDump();
+
+// Called by the raster line interrupt with BOOTSNAPSHOT_DUMP, dumps once at the READY prompt.
+void bootSnapshotDumpAtReady();
+
+#endif // TEENSY64_BOOT_SNAPSHOT_H
@@ -55,5 +55,6 @@ void cia2_checkRTCAlarm() __attribute__ ((hot));
 void cia2_write(uint32_t address, uint8_t value) __attribute__ ((hot));
 uint8_t cia2_read(uint32_t address) __attribute__ ((hot));
 void resetCia2(void);
+void cia2_restorePorts(void);
 
 #endif
@@ -17,7 +17,7 @@ void cia_2::write(uint32_t address, uint8_t value) {
 
             WRITE_ATN_CLK_DATA(value);
 
-            cpu.vic.bank = ((~value) & CIA2_PRA_VIC_BANK_MASK) * 16384;
+            cpu().vic.bank = ((~value) & CIA2_PRA_VIC_BANK_MASK) * 16384;
             tvic::applyAdressChange();
 
             r.PRA = value;
@@ -43,7 +43,7 @@ uint8_t cia_2::read(uint32_t address) {
 
     switch(address) {
         case CIA_PRA:
-            ret = (cpu.cia2.R[CIA_PRA] & ~CIA2_PRA_IEC_IN_MASK) | (uint8_t)READ_CLK_DATA();
+            ret = (cpu().cia2.R[CIA_PRA] & ~CIA2_PRA_IEC_IN_MASK) | (uint8_t)READ_CLK_DATA();
 
             if(~ret & ~CIA2_PRA_IEC_IN_MASK) {
                 cpu_setExactTiming();
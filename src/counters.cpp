@@ -0,0 +1,129 @@
+/*
+	Copyright Frank Bösing, Karsten Fleischer, 2026
+
+	This file is part of Teensy64.
+
+    Teensy64 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Teensy64 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Teensy64.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von Teensy64.
+
+    Teensy64 ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Teensy64 wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+*/
+
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include "settings.h"
+
+#if COUNTERS
+
+#include "teensy64.h"
+#include "counters.h"
+
+namespace {
+
+const char *const modeNames[MODES] = {
+        "imp", "acc", "imm", "zp", "zpx", "zpy", "rel", "abs", "absx", "absy", "ind", "indx", "indy"
+};
+
+const char *const deviceNames[DEVICES] = {
+        "vic", "sid", "col", "cia1", "cia2"
+};
+
+const uint8_t branchOpcodes[] = {0x10, 0x30, 0x50, 0x70, 0x90, 0xB0, 0xD0, 0xF0};
+
+volatile bool request = false;
+
+//Appends to out like snprintf(), a full buffer keeps its end
+void append(char *out, unsigned size, unsigned &len, const char *format, ...) {
+    va_list args;
+
+    va_start(args, format);
+    int n = vsnprintf(out + len, size - len, format, args);
+    va_end(args);
+
+    if(n > 0) { len = min(len + n, size - 1); }
+}
+
+}
+
+void countersReset() {
+    memset(&cpu().counters, 0, sizeof(cpu().counters));
+}
+
+unsigned countersJson(char *out, unsigned size) {
+    const tcounters &counters = cpu().counters;
+    unsigned len = 0;
+    uint32_t instructions = 0;
+    uint32_t branches = 0;
+
+    for(unsigned i = 0; i < 256; i++) { instructions += counters.opcodes[i]; }
+    for(uint8_t opcode : branchOpcodes) { branches += counters.opcodes[opcode]; }
+
+    out[0] = 0;
+    append(out, size, len, "{\"instructions\": %u, \"irqs\": %u, \"nmis\": %u, \"opcodes\": [",
+           (unsigned) instructions, (unsigned) counters.irqs, (unsigned) counters.nmis);
+
+    for(unsigned i = 0; i < 256; i++) {
+        append(out, size, len, i ? ", %u" : "%u", (unsigned) counters.opcodes[i]);
+    }
+
+    append(out, size, len, "], \"modes\": {");
+
+    for(unsigned i = 0; i < MODES; i++) {
+        append(out, size, len, "%s\"%s\": %u", i ? ", " : "", modeNames[i], (unsigned) counters.modes[i]);
+    }
+
+    append(out, size, len, "}, \"branches\": {\"taken\": %u, \"untaken\": %u, \"pageCrossings\": %u}, "
+                           "\"pageCrossings\": %u, \"io\": {",
+           (unsigned) counters.branchesTaken, (unsigned) (branches - counters.branchesTaken),
+           (unsigned) counters.branchPageCrossings, (unsigned) counters.pageCrossings);
+
+    for(unsigned i = 0; i < DEVICES; i++) {
+        append(out, size, len, "%s\"%s\": {\"reads\": %u, \"writes\": %u}", i ? ", " : "", deviceNames[i],
+               (unsigned) counters.reads[i], (unsigned) counters.writes[i]);
+    }
+
+    append(out, size, len, "}}");
+
+    return len;
+}
+
+void countersRequest() {
+    request = true;
+}
+
+void countersPoll() {
+    static char json[COUNTERS_JSON_SIZE];
+
+    if(!request) { return; }
+
+    request = false;
+    countersJson(json, sizeof(json));
+    Serial.println(json);
+}
+
+#endif
@@ -0,0 +1,101 @@
+/*
+	Copyright Frank Bösing, Karsten Fleischer, 2026
+
+	This file is part of Teensy64.
+
+    Teensy64 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Teensy64 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Teensy64.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von Teensy64.
+
+    Teensy64 ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Teensy64 wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+*/
+
+#pragma once
+
+#ifndef TEENSY64_COUNTERS_H
+#define TEENSY64_COUNTERS_H
+
+#include <cstdint>
+#include "settings.h"
+
+/*
+  Counters of the executed 6502 code, an instrumentation build with COUNTERS 1:
+
+    - executions per opcode and per addressing mode (counted in the mode functions of cpu.cpp)
+    - taken and untaken branches, and taken branches to another page
+    - the extra cycle of abs,X, abs,Y and (zp),Y across a page boundary
+    - IRQs and NMIs
+    - reads and writes of the I/O devices: VIC, SID, colour RAM, CIA 1 and CIA 2
+
+  A run starts after the boot of the machine (machineBoot()), the counters start at zero.
+  Ctrl+Alt+C prints them on Serial as one JSON object, the batch runner adds them to the
+  report of each program. The native replacements of ROM routines and the loop idioms run
+  6502 code without the interpreter, that code is not counted. The decrunchers run in the
+  interpreter and are counted.
+*/
+
+#if COUNTERS
+enum : uint8_t {
+    MODE_IMP, MODE_ACC, MODE_IMM, MODE_ZP, MODE_ZPX, MODE_ZPY, MODE_REL, MODE_ABS, MODE_ABSX, MODE_ABSY,
+    MODE_IND, MODE_INDX, MODE_INDY, MODES
+};
+
+enum : uint8_t {
+    DEVICE_VIC, DEVICE_SID, DEVICE_COL, DEVICE_CIA1, DEVICE_CIA2, DEVICES
+};
+
+struct tcounters {
+    uint32_t opcodes[256];
+    uint32_t modes[MODES];
+    uint32_t branchesTaken;       //untaken: the executed branch opcodes minus these
+    uint32_t branchPageCrossings; //taken to another page
+    uint32_t pageCrossings;       //extra cycle of abs,X, abs,Y and (zp),Y
+    uint32_t irqs;
+    uint32_t nmis;
+    uint32_t reads[DEVICES];
+    uint32_t writes[DEVICES];
+};
+
+//The counters of the machine are cpu().counters
+#define COUNT(counter) (cpu().counters.counter++)
+
+// Longest JSON object of countersJson(), with the terminating 0.
+const unsigned COUNTERS_JSON_SIZE = 4096;
+
+void countersReset();
+
+// Writes the counters as one JSON object, returns its length.
+unsigned countersJson(char *out, unsigned size);
+
+void countersRequest();
+
+// Called by the line clock interrupt between two raster lines.
+void countersPoll();
+#else
+#define COUNT(counter)
+#endif
+
+#endif // TEENSY64_COUNTERS_H
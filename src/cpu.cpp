@@ -48,40 +48,40 @@
 #include "teensy64.h"
 #include "cpu.h"
 #include "cia6526.h"
-
-#define FLAG_CARRY     0x01
-#define FLAG_ZERO      0x02
-#define FLAG_INTERRUPT 0x04
-#define FLAG_DECIMAL   0x08
-#define FLAG_BREAK     0x10
-#define FLAG_CONSTANT  0x20
-#define FLAG_OVERFLOW  0x40
-#define FLAG_SIGN      0x80
+#include "basic_fp.h"
+#include "kernal_editor.h"
+#include "loop_idioms.h"
+#include "decrunch.h"
+#include "monitor.h"
+#include "profiler.h"
+#include "trace.h"
+#include "counters.h"
+#include "heatmap.h"
 
 //flag modifier macros
-#define setcarry()          cpu.cpustatus |= FLAG_CARRY
-#define clearcarry()        cpu.cpustatus &= (~FLAG_CARRY)
-#define setzero()           cpu.cpustatus |= FLAG_ZERO
-#define clearzero()         cpu.cpustatus &= (~FLAG_ZERO)
-#define setinterrupt()      cpu.cpustatus |= FLAG_INTERRUPT
-#define clearinterrupt()    cpu.cpustatus &= (~FLAG_INTERRUPT)
-#define setdecimal()        cpu.cpustatus |= FLAG_DECIMAL
-#define cleardecimal()      cpu.cpustatus &= (~FLAG_DECIMAL)
-#define setoverflow()       cpu.cpustatus |= FLAG_OVERFLOW
-#define clearoverflow()     cpu.cpustatus &= (~FLAG_OVERFLOW)
-#define setsign()           cpu.cpustatus |= FLAG_SIGN
-#define clearsign()         cpu.cpustatus &= (~FLAG_SIGN)
+#define setcarry()          cpu().cpustatus |= FLAG_CARRY
+#define clearcarry()        cpu().cpustatus &= (~FLAG_CARRY)
+#define setzero()           cpu().cpustatus |= FLAG_ZERO
+#define clearzero()         cpu().cpustatus &= (~FLAG_ZERO)
+#define setinterrupt()      cpu().cpustatus |= FLAG_INTERRUPT
+#define clearinterrupt()    cpu().cpustatus &= (~FLAG_INTERRUPT)
+#define setdecimal()        cpu().cpustatus |= FLAG_DECIMAL
+#define cleardecimal()      cpu().cpustatus &= (~FLAG_DECIMAL)
+#define setoverflow()       cpu().cpustatus |= FLAG_OVERFLOW
+#define clearoverflow()     cpu().cpustatus &= (~FLAG_OVERFLOW)
+#define setsign()           cpu().cpustatus |= FLAG_SIGN
+#define clearsign()         cpu().cpustatus &= (~FLAG_SIGN)
 
 
 //flag calculation macros
 #define zerocalc(n)             { if ((n) & 0x00FF) clearzero(); else setzero(); }
 //#define signcalc(n)           { if ((n) & 0x0080) setsign(); else clearsign(); }
-#define signcalc(n)             { cpu.cpustatus =( cpu.cpustatus & 0x7f) | (n & 0x80); }
+#define signcalc(n)             { cpu().cpustatus =( cpu().cpustatus & 0x7f) | (n & 0x80); }
 #define carrycalc(n)            { if ((n) & 0xFF00) setcarry(); else clearcarry(); }
-//#define carrycalc(n)          { cpu.cpustatus =( cpu.cpustatus & 0xfe) | (n >> 8); }
+//#define carrycalc(n)          { cpu().cpustatus =( cpu().cpustatus & 0xfe) | (n >> 8); }
 #define overflowcalc(n, m, o)   { if (((n) ^ (uint16_t)(m)) & ((n) ^ (o)) & 0x0080) setoverflow(); else clearoverflow(); }
 
-#define saveaccum(n)    cpu.a = (uint8_t)((n) & 0x00FF)
+#define saveaccum(n)    cpu().a = (uint8_t)((n) & 0x00FF)
 
 #define UNSUPPORTED { Serial.println("Unsupported static"); while(1){;} }
 
@@ -93,7 +93,11 @@ void logAddr(const uint32_t address, const uint8_t value, const uint8_t rw) {
     Serial.println(value, HEX);
 }
 
-struct tcpu cpu;
+#if MACHINES > 1
+__thread struct tcpu *machine = nullptr;
+#else
+struct tcpu c64;
+#endif
 struct tio io;
 
 void reset6502();
@@ -103,44 +107,78 @@ static inline void cpu_irq();
 static inline __attribute__((always_inline, flatten)) uint8_t read6502(uint32_t address) __attribute__ ((hot));
 
 static inline __attribute__((always_inline, flatten)) uint8_t read6502(const uint32_t address) {
-    return (*cpu.plamap_r)[address >> 8](address);
+    HEAT(reads, address);
+    return (*cpu().plamap_r)[address >> 8](address);
 }
 
 static inline __attribute__((always_inline, flatten)) uint8_t read6502ZP(uint32_t address) __attribute__ ((hot)); //Zeropage
 static inline __attribute__((always_inline, flatten)) uint8_t read6502ZP(const uint32_t address) {
-    return cpu.RAM[address & 0xff];
+    if(monitorTraps()) { return read6502(address & 0xff); } //checkpoints in the zeropage
+    HEAT(reads, address & 0xff);
+    return cpu().RAM[address & 0xff];
 }
 
 /* Ein Schreibzugriff auf einen ROM-Bereich speichert das Byte im „darunterliegenden” RAM. */
 static inline __attribute__((always_inline, flatten)) void write6502(uint32_t address, uint8_t value) __attribute__ ((hot));
 
 static inline __attribute__((always_inline, flatten)) void write6502(const uint32_t address, const uint8_t value) {
-    (*cpu.plamap_w)[address >> 8](address, value);
+    HEAT(writes, address);
+    (*cpu().plamap_w)[address >> 8](address, value);
+}
+
+//CPU cycles left in the current raster line after the current instruction, without badlines and sprites
+static inline __attribute__((always_inline)) int lineCyclesLeft() {
+    int turbo = cpu().exactTiming ? 1 : cpu().turbo;
+    return ((int) CYCLESPERRASTERLINE - (int) cpu().lineCyclesAbs) * turbo + cpu().clockCycles - (int) cpu().ticks;
 }
 
+#if TRACE
+//Writes the instruction with the opcode at pc into the trace, before it runs, see trace.h
+static inline __attribute__((always_inline)) void traceInstruction(uint16_t pc, uint8_t opcode) {
+    ttraceEntry &e = cpu().trace.entries[cpu().trace.next++ & (TRACE_LENGTH - 1)];
+
+    e.pcOpcodeA = pc | (opcode << 16) | (cpu().a << 24);
+    e.xYPSp = cpu().x | (cpu().y << 8) | (cpu().cpustatus << 16) | (cpu().sp << 24);
+    e.lineCycle = cpu().vic.rasterLine | (cpu().lineCycles << 16);
+}
+#endif
+
 //a few general functions used by various other functions
+
+//The stack is always RAM, the PLA is only asked while the monitor has checkpoints in its tables
+static inline __attribute__((always_inline, flatten)) void writeStack(const uint8_t sp, const uint8_t value) {
+    if(monitorTraps()) { write6502(BASE_STACK + sp, value); return; }
+    HEAT(writes, BASE_STACK + sp);
+    cpu().RAM[BASE_STACK + sp] = value;
+}
+
+static inline __attribute__((always_inline, flatten)) uint8_t readStack(const uint8_t sp) {
+    if(monitorTraps()) { return read6502(BASE_STACK + sp); }
+    HEAT(reads, BASE_STACK + sp);
+    return cpu().RAM[BASE_STACK + sp];
+}
+
 static inline __attribute__((always_inline, flatten)) void push16(const uint16_t pushval) {
-    cpu.RAM[BASE_STACK + cpu.sp] = (pushval >> 8) & 0xFF;
-    cpu.RAM[BASE_STACK + ((cpu.sp - 1) & 0xFF)] = pushval & 0xFF;
-    cpu.sp -= 2;
+    writeStack(cpu().sp, (pushval >> 8) & 0xFF);
+    writeStack(cpu().sp - 1, pushval & 0xFF);
+    cpu().sp -= 2;
 }
 
 static inline __attribute__((always_inline, flatten)) uint16_t pull16() {
     uint16_t temp16;
 
-    temp16 = cpu.RAM[BASE_STACK + ((cpu.sp + 1) & 0xFF)] |
-             ((uint16_t) cpu.RAM[BASE_STACK + ((cpu.sp + 2) & 0xFF)] << 8);
-    cpu.sp += 2;
+    temp16 = readStack(cpu().sp + 1) | ((uint16_t) readStack(cpu().sp + 2) << 8);
+    cpu().sp += 2;
 
     return (temp16);
 }
 
 static inline __attribute__((always_inline, flatten)) void push8(uint8_t pushval) {
-    cpu.RAM[BASE_STACK + (cpu.sp--)] = pushval;
+    writeStack(cpu().sp--, pushval);
 }
 
 static inline __attribute__((always_inline, flatten)) uint8_t pull8() {
-    return cpu.RAM[BASE_STACK + (++cpu.sp)];
+    return readStack(++cpu().sp);
 }
 
 /********************************************************************************************************************/
@@ -148,118 +186,143 @@ static inline __attribute__((always_inline, flatten)) uint8_t pull8() {
 /********************************************************************************************************************/
 
 static inline __attribute__((always_inline, flatten)) void imp() { //implied
+    COUNT(modes[MODE_IMP]);
 }
 
 static inline __attribute__((always_inline, flatten)) void acc() { //accumulator
+    COUNT(modes[MODE_ACC]);
 }
 
 static inline __attribute__((always_inline, flatten)) void imm() { //immediate
-    cpu.ea = cpu.pc++;
+    COUNT(modes[MODE_IMM]);
+    cpu().ea = cpu().pc++;
 }
 
 static inline __attribute__((always_inline, flatten)) void zp() { //zero-page
-    cpu.ea = read6502(cpu.pc++) & 0xFF;
+    COUNT(modes[MODE_ZP]);
+    cpu().ea = read6502(cpu().pc++) & 0xFF;
 }
 
 static inline __attribute__((always_inline, flatten)) void zpx() { //zero-page,X
-    cpu.ea = (read6502(cpu.pc++) + cpu.x) & 0xFF; //zero-page wraparound
+    COUNT(modes[MODE_ZPX]);
+    cpu().ea = (read6502(cpu().pc++) + cpu().x) & 0xFF; //zero-page wraparound
 }
 
 static inline __attribute__((always_inline, flatten)) void zpy() { //zero-page,Y
-    cpu.ea = (read6502(cpu.pc++) + cpu.y) & 0xFF; //zero-page wraparound
+    COUNT(modes[MODE_ZPY]);
+    cpu().ea = (read6502(cpu().pc++) + cpu().y) & 0xFF; //zero-page wraparound
 }
 
 static inline __attribute__((always_inline, flatten)) void rel() { //relative for branch ops (8-bit immediate value, sign-extended)
-    cpu.reladdr = read6502(cpu.pc++);
-    if(cpu.reladdr & 0x80) { cpu.reladdr |= 0xFF00; }
+    COUNT(modes[MODE_REL]);
+    cpu().reladdr = read6502(cpu().pc++);
+    if(cpu().reladdr & 0x80) { cpu().reladdr |= 0xFF00; }
 }
 
 static inline __attribute__((always_inline, flatten)) void abso() { //absolute
-    cpu.ea = read6502(cpu.pc) | (read6502(cpu.pc + 1) << 8);
-    cpu.pc += 2;
+    COUNT(modes[MODE_ABS]);
+    cpu().ea = read6502(cpu().pc) | (read6502(cpu().pc + 1) << 8);
+    cpu().pc += 2;
 }
 
 static inline __attribute__((always_inline, flatten)) void absx() { //absolute,X
-    cpu.ea = (read6502(cpu.pc) | (read6502(cpu.pc + 1) << 8)) + cpu.x;
-    cpu.pc += 2;
+    COUNT(modes[MODE_ABSX]);
+    cpu().ea = (read6502(cpu().pc) | (read6502(cpu().pc + 1) << 8)) + cpu().x;
+    cpu().pc += 2;
 }
 
 static inline __attribute__((always_inline, flatten)) void absx_t() { //absolute,X with extra cycle
-    uint16_t h = read6502(cpu.pc) + cpu.x;
+    COUNT(modes[MODE_ABSX]);
+    uint16_t h = read6502(cpu().pc) + cpu().x;
 
-    if(h & 0x100) { cpu.ticks += 1; }
+    if(h & 0x100) {
+        cpu().ticks += 1;
+        COUNT(pageCrossings);
+    }
 
-    cpu.ea = h + (read6502(cpu.pc + 1) << 8);
-    cpu.pc += 2;
+    cpu().ea = h + (read6502(cpu().pc + 1) << 8);
+    cpu().pc += 2;
 }
 
 static inline __attribute__((always_inline, flatten)) void absy() { //absolute,Y
-    cpu.ea = (read6502(cpu.pc) + (read6502(cpu.pc + 1) << 8)) + cpu.y;
-    cpu.pc += 2;
+    COUNT(modes[MODE_ABSY]);
+    cpu().ea = (read6502(cpu().pc) + (read6502(cpu().pc + 1) << 8)) + cpu().y;
+    cpu().pc += 2;
 }
 
 static inline __attribute__((always_inline, flatten)) void absy_t() { //absolute,Y with extra cycle
-    uint16_t h = read6502(cpu.pc) + cpu.y;
+    COUNT(modes[MODE_ABSY]);
+    uint16_t h = read6502(cpu().pc) + cpu().y;
 
-    if(h & 0x100) { cpu.ticks += 1; }
+    if(h & 0x100) {
+        cpu().ticks += 1;
+        COUNT(pageCrossings);
+    }
 
-    cpu.ea = h + (read6502(cpu.pc + 1) << 8);
-    cpu.pc += 2;
+    cpu().ea = h + (read6502(cpu().pc + 1) << 8);
+    cpu().pc += 2;
 }
 
 static inline __attribute__((always_inline, flatten)) void ind() { //indirect
+    COUNT(modes[MODE_IND]);
     uint16_t eahelp;
     uint16_t eahelp2;
 
-    eahelp = read6502(cpu.pc) | (read6502(cpu.pc + 1) << 8);
+    eahelp = read6502(cpu().pc) | (read6502(cpu().pc + 1) << 8);
     eahelp2 = (eahelp & 0xFF00) | ((eahelp + 1) & 0x00FF); //replicate 6502 page-boundary wraparound bug
-    cpu.ea = read6502(eahelp) | (read6502(eahelp2) << 8);
-    cpu.pc += 2;
+    cpu().ea = read6502(eahelp) | (read6502(eahelp2) << 8);
+    cpu().pc += 2;
 }
 
 static inline __attribute__((always_inline, flatten)) void indx() { // (indirect,X)
+    COUNT(modes[MODE_INDX]);
     uint32_t eahelp;
 
-    eahelp = (read6502(cpu.pc++) + cpu.x) & 0xFF; //zero-page wraparound for table pointer
-    cpu.ea = read6502ZP((uint8_t) eahelp) | (read6502ZP((uint8_t)(eahelp + 1)) << 8);
+    eahelp = (read6502(cpu().pc++) + cpu().x) & 0xFF; //zero-page wraparound for table pointer
+    cpu().ea = read6502ZP((uint8_t) eahelp) | (read6502ZP((uint8_t)(eahelp + 1)) << 8);
 }
 
 static inline __attribute__((always_inline, flatten)) void indy() { // (zeropage indirect),Y
-    uint8_t zp = read6502(cpu.pc++);
+    COUNT(modes[MODE_INDY]);
+    uint8_t zp = read6502(cpu().pc++);
 
-    cpu.ea = read6502ZP((uint16_t) zp++);
-    cpu.ea += (uint16_t) read6502ZP((uint16_t) zp) << 8;
-    cpu.ea += cpu.y;
+    cpu().ea = read6502ZP((uint16_t) zp++);
+    cpu().ea += (uint16_t) read6502ZP((uint16_t) zp) << 8;
+    cpu().ea += cpu().y;
 }
 
 static inline __attribute__((always_inline, flatten)) void indy_t() { // (zeropage indirect),Y with extra cycle
-    uint8_t zp = read6502(cpu.pc++);
+    COUNT(modes[MODE_INDY]);
+    uint8_t zp = read6502(cpu().pc++);
     uint16_t h;
 
     h = read6502ZP((uint16_t) zp++);
     h += (uint16_t) read6502ZP((uint16_t) zp) << 8;
 
-    if(((h + cpu.y) & 0xff) != (h & 0xff)) { cpu.ticks += 1; }
+    if(((h + cpu().y) & 0xff) != (h & 0xff)) {
+        cpu().ticks += 1;
+        COUNT(pageCrossings);
+    }
 
-    cpu.ea = h + cpu.y;
+    cpu().ea = h + cpu().y;
 }
 
 //static inline __attribute__((always_inline, flatten, hot)) uint32_t getvalue() __attribute__ ((hot));
 
 static inline __attribute__((always_inline, flatten, hot)) uint32_t getvalue() {
-    return read6502(cpu.ea);
+    return read6502(cpu().ea);
 }
 
 static inline __attribute__((always_inline, flatten)) uint32_t getvalueZP() __attribute__ ((hot));
 
 static inline __attribute__((always_inline, flatten)) uint32_t getvalueZP() {
-    return read6502ZP(cpu.ea);
+    return read6502ZP(cpu().ea);
 }
 
 static inline __attribute__((always_inline, flatten)) void putvalue(uint8_t saveval)  __attribute__ ((hot));
 
 static inline __attribute__((always_inline, flatten)) void putvalue(const uint8_t saveval) {
-    write6502(cpu.ea, saveval);
+    write6502(cpu().ea, saveval);
 }
 
 
@@ -280,14 +343,14 @@ LAS = LAR
 KIL = JAM, HLT
 */
 
-#define SETFLAGS(data)                                              \
-{                                                                   \
-    if (!(data)) {                                                  \
-        cpu.cpustatus = (cpu.cpustatus & ~FLAG_SIGN) | FLAG_ZERO;   \
-    } else {                                                        \
-        cpu.cpustatus = (cpu.cpustatus & ~(FLAG_SIGN|FLAG_ZERO)) |  \
-                        ((data) & FLAG_SIGN);                       \
-    }                                                               \
+#define SETFLAGS(data)                                                  \
+{                                                                       \
+    if (!(data)) {                                                      \
+        cpu().cpustatus = (cpu().cpustatus & ~FLAG_SIGN) | FLAG_ZERO;   \
+    } else {                                                            \
+        cpu().cpustatus = (cpu().cpustatus & ~(FLAG_SIGN|FLAG_ZERO)) |  \
+                        ((data) & FLAG_SIGN);                           \
+    }                                                                   \
 }
 
 
@@ -295,16 +358,16 @@ static inline __attribute__((always_inline, flatten)) void _adc(unsigned data) {
     unsigned tempval = data;
     unsigned temp;
 
-    if(cpu.cpustatus & FLAG_DECIMAL) {
-        temp = (cpu.a & 0x0f) + (tempval & 0x0f) + (cpu.cpustatus & FLAG_CARRY);
+    if(cpu().cpustatus & FLAG_DECIMAL) {
+        temp = (cpu().a & 0x0f) + (tempval & 0x0f) + (cpu().cpustatus & FLAG_CARRY);
 
         if(temp > 9) { temp += 6; }
         if(temp <= 0x0f) {
-            temp = (temp & 0xf) + (cpu.a & 0xf0) + (tempval & 0xf0);
+            temp = (temp & 0xf) + (cpu().a & 0xf0) + (tempval & 0xf0);
         } else {
-            temp = (temp & 0xf) + (cpu.a & 0xf0) + (tempval & 0xf0) + 0x10;
+            temp = (temp & 0xf) + (cpu().a & 0xf0) + (tempval & 0xf0) + 0x10;
         }
-        if(!((cpu.a + tempval + (cpu.cpustatus & FLAG_CARRY)) & 0xff)) {
+        if(!((cpu().a + tempval + (cpu().cpustatus & FLAG_CARRY)) & 0xff)) {
             setzero();
         } else {
             clearzero();
@@ -312,7 +375,7 @@ static inline __attribute__((always_inline, flatten)) void _adc(unsigned data) {
 
         signcalc(temp);
 
-        if(((cpu.a ^ temp) & 0x80) && !((cpu.a ^ tempval) & 0x80)) {
+        if(((cpu().a ^ temp) & 0x80) && !((cpu().a ^ tempval) & 0x80)) {
             setoverflow();
         } else {
             clearoverflow();
@@ -323,11 +386,11 @@ static inline __attribute__((always_inline, flatten)) void _adc(unsigned data) {
         else
             clearcarry();
     } else {
-        temp = tempval + cpu.a + (cpu.cpustatus & FLAG_CARRY);
+        temp = tempval + cpu().a + (cpu().cpustatus & FLAG_CARRY);
 
         SETFLAGS(temp & 0xff);
 
-        if(!((cpu.a ^ tempval) & 0x80) && ((cpu.a ^ temp) & 0x80)) {
+        if(!((cpu().a ^ tempval) & 0x80) && ((cpu().a ^ temp) & 0x80)) {
             setoverflow();
         } else {
             clearoverflow();
@@ -346,17 +409,17 @@ static inline __attribute__((always_inline, flatten)) void _sbc(unsigned data) {
     unsigned tempval = data;
     unsigned temp;
 
-    temp = cpu.a - tempval - ((cpu.cpustatus & FLAG_CARRY) ^ FLAG_CARRY);
+    temp = cpu().a - tempval - ((cpu().cpustatus & FLAG_CARRY) ^ FLAG_CARRY);
 
-    if(cpu.cpustatus & FLAG_DECIMAL) {
+    if(cpu().cpustatus & FLAG_DECIMAL) {
         unsigned tempval2;
 
-        tempval2 = (cpu.a & 0x0f) - (tempval & 0x0f) - ((cpu.cpustatus & FLAG_CARRY) ^ FLAG_CARRY);
+        tempval2 = (cpu().a & 0x0f) - (tempval & 0x0f) - ((cpu().cpustatus & FLAG_CARRY) ^ FLAG_CARRY);
 
         if(tempval2 & 0x10) {
-            tempval2 = ((tempval2 - 6) & 0xf) | ((cpu.a & 0xf0) - (tempval & 0xf0) - 0x10);
+            tempval2 = ((tempval2 - 6) & 0xf) | ((cpu().a & 0xf0) - (tempval & 0xf0) - 0x10);
         } else {
-            tempval2 = (tempval2 & 0xf) | ((cpu.a & 0xf0) - (tempval & 0xf0));
+            tempval2 = (tempval2 & 0xf) | ((cpu().a & 0xf0) - (tempval & 0xf0));
         }
         if(tempval2 & 0x100) {
             tempval2 -= 0x60;
@@ -369,7 +432,7 @@ static inline __attribute__((always_inline, flatten)) void _sbc(unsigned data) {
 
         SETFLAGS(temp & 0xff);
 
-        if(((cpu.a ^ temp) & 0x80) && ((cpu.a ^ tempval) & 0x80)) {
+        if(((cpu().a ^ temp) & 0x80) && ((cpu().a ^ tempval) & 0x80)) {
             setoverflow();
         }
         else {
@@ -386,7 +449,7 @@ static inline __attribute__((always_inline, flatten)) void _sbc(unsigned data) {
             clearcarry();
         }
 
-        if(((cpu.a ^ temp) & 0x80) && ((cpu.a ^ tempval) & 0x80)) {
+        if(((cpu().a ^ temp) & 0x80) && ((cpu().a ^ tempval) & 0x80)) {
             setoverflow();
         } else {
             clearoverflow();
@@ -409,7 +472,7 @@ static inline __attribute__((always_inline, flatten)) void adcZP() {
 }
 
 static inline __attribute__((always_inline, flatten)) void op_and() {
-    uint32_t result = cpu.a & getvalue();
+    uint32_t result = cpu().a & getvalue();
 
     zerocalc(result);
     signcalc(result);
@@ -417,7 +480,7 @@ static inline __attribute__((always_inline, flatten)) void op_and() {
 }
 
 static inline __attribute__((always_inline, flatten)) void op_andZP() {
-    uint32_t result = cpu.a & getvalueZP();
+    uint32_t result = cpu().a & getvalueZP();
 
     zerocalc(result);
     signcalc(result);
@@ -447,7 +510,7 @@ static inline __attribute__((always_inline, flatten)) void aslZP() {
 }
 
 static inline __attribute__((always_inline, flatten)) void asla() {
-    uint32_t result = cpu.a << 1;
+    uint32_t result = cpu().a << 1;
 
     carrycalc(result);
     zerocalc(result);
@@ -456,43 +519,49 @@ static inline __attribute__((always_inline, flatten)) void asla() {
 }
 
 static inline __attribute__((always_inline, flatten)) void bcc() {
-    if((cpu.cpustatus & FLAG_CARRY) == 0) {
-        uint32_t oldpc = cpu.pc;
+    if((cpu().cpustatus & FLAG_CARRY) == 0) {
+        uint32_t oldpc = cpu().pc;
 
-        cpu.pc += cpu.reladdr;
+        COUNT(branchesTaken);
+        cpu().pc += cpu().reladdr;
 
-        if((oldpc & 0xFF00) != (cpu.pc & 0xFF00)) {
-            cpu.ticks += 2; //check if jump crossed a page boundary
+        if((oldpc & 0xFF00) != (cpu().pc & 0xFF00)) {
+            cpu().ticks += 2; //check if jump crossed a page boundary
+            COUNT(branchPageCrossings);
         } else {
-            cpu.ticks++;
+            cpu().ticks++;
         }
     }
 }
 
 static inline __attribute__((always_inline, flatten)) void bcs() {
-    if((cpu.cpustatus & FLAG_CARRY) == FLAG_CARRY) {
-        uint32_t oldpc = cpu.pc;
+    if((cpu().cpustatus & FLAG_CARRY) == FLAG_CARRY) {
+        uint32_t oldpc = cpu().pc;
 
-        cpu.pc += cpu.reladdr;
+        COUNT(branchesTaken);
+        cpu().pc += cpu().reladdr;
 
-        if((oldpc & 0xFF00) != (cpu.pc & 0xFF00)) {
-            cpu.ticks += 2; //check if jump crossed a page boundary
+        if((oldpc & 0xFF00) != (cpu().pc & 0xFF00)) {
+            cpu().ticks += 2; //check if jump crossed a page boundary
+            COUNT(branchPageCrossings);
         } else {
-            cpu.ticks++;
+            cpu().ticks++;
         }
     }
 }
 
 static inline __attribute__((always_inline, flatten)) void beq() {
-    if((cpu.cpustatus & FLAG_ZERO) == FLAG_ZERO) {
-        uint32_t oldpc = cpu.pc;
+    if((cpu().cpustatus & FLAG_ZERO) == FLAG_ZERO) {
+        uint32_t oldpc = cpu().pc;
 
-        cpu.pc += cpu.reladdr;
+        COUNT(branchesTaken);
+        cpu().pc += cpu().reladdr;
 
-        if((oldpc & 0xFF00) != (cpu.pc & 0xFF00)) {
-            cpu.ticks += 2; //check if jump crossed a page boundary
+        if((oldpc & 0xFF00) != (cpu().pc & 0xFF00)) {
+            cpu().ticks += 2; //check if jump crossed a page boundary
+            COUNT(branchPageCrossings);
         } else {
-            cpu.ticks++;
+            cpu().ticks++;
         }
     }
 }
@@ -500,9 +569,9 @@ static inline __attribute__((always_inline, flatten)) void beq() {
 static inline __attribute__((always_inline, flatten)) void op_bit() {
     unsigned value = getvalue();
 
-    cpu.cpustatus = (cpu.cpustatus & ~(FLAG_SIGN | FLAG_OVERFLOW)) | (value & (FLAG_SIGN | FLAG_OVERFLOW));
+    cpu().cpustatus = (cpu().cpustatus & ~(FLAG_SIGN | FLAG_OVERFLOW)) | (value & (FLAG_SIGN | FLAG_OVERFLOW));
 
-    if(!(value & cpu.a)) {
+    if(!(value & cpu().a)) {
         setzero();
     } else {
         clearzero();
@@ -512,9 +581,9 @@ static inline __attribute__((always_inline, flatten)) void op_bit() {
 static inline __attribute__((always_inline, flatten)) void op_bitZP() {
     unsigned value = getvalueZP();
 
-    cpu.cpustatus = (cpu.cpustatus & ~(FLAG_SIGN | FLAG_OVERFLOW)) | (value & (FLAG_SIGN | FLAG_OVERFLOW));
+    cpu().cpustatus = (cpu().cpustatus & ~(FLAG_SIGN | FLAG_OVERFLOW)) | (value & (FLAG_SIGN | FLAG_OVERFLOW));
 
-    if(!(value & cpu.a)) {
+    if(!(value & cpu().a)) {
         setzero();
     } else {
         clearzero();
@@ -522,82 +591,92 @@ static inline __attribute__((always_inline, flatten)) void op_bitZP() {
 }
 
 static inline __attribute__((always_inline, flatten)) void bmi() {
-    if((cpu.cpustatus & FLAG_SIGN) == FLAG_SIGN) {
-        uint32_t oldpc = cpu.pc;
+    if((cpu().cpustatus & FLAG_SIGN) == FLAG_SIGN) {
+        uint32_t oldpc = cpu().pc;
 
-        cpu.pc += cpu.reladdr;
+        COUNT(branchesTaken);
+        cpu().pc += cpu().reladdr;
 
-        if((oldpc & 0xFF00) != (cpu.pc & 0xFF00)) {
-            cpu.ticks += 2; //check if jump crossed a page boundary
+        if((oldpc & 0xFF00) != (cpu().pc & 0xFF00)) {
+            cpu().ticks += 2; //check if jump crossed a page boundary
+            COUNT(branchPageCrossings);
         } else {
-            cpu.ticks++;
+            cpu().ticks++;
         }
     }
 }
 
 static inline __attribute__((always_inline, flatten)) void bne() {
-    if((cpu.cpustatus & FLAG_ZERO) == 0) {
-        uint32_t oldpc = cpu.pc;
+    if((cpu().cpustatus & FLAG_ZERO) == 0) {
+        uint32_t oldpc = cpu().pc;
 
-        cpu.pc += cpu.reladdr;
+        COUNT(branchesTaken);
+        cpu().pc += cpu().reladdr;
 
-        if((oldpc & 0xFF00) != (cpu.pc & 0xFF00)) {
-            cpu.ticks += 2; //check if jump crossed a page boundary
+        if((oldpc & 0xFF00) != (cpu().pc & 0xFF00)) {
+            cpu().ticks += 2; //check if jump crossed a page boundary
+            COUNT(branchPageCrossings);
         } else {
-            cpu.ticks++;
+            cpu().ticks++;
         }
     }
 }
 
 static inline __attribute__((always_inline, flatten)) void bpl() {
-    if((cpu.cpustatus & FLAG_SIGN) == 0) {
-        uint32_t oldpc = cpu.pc;
+    if((cpu().cpustatus & FLAG_SIGN) == 0) {
+        uint32_t oldpc = cpu().pc;
 
-        cpu.pc += cpu.reladdr;
+        COUNT(branchesTaken);
+        cpu().pc += cpu().reladdr;
 
-        if((oldpc & 0xFF00) != (cpu.pc & 0xFF00)) {
-            cpu.ticks += 2; //check if jump crossed a page boundary
+        if((oldpc & 0xFF00) != (cpu().pc & 0xFF00)) {
+            cpu().ticks += 2; //check if jump crossed a page boundary
+            COUNT(branchPageCrossings);
         } else {
-            cpu.ticks++;
+            cpu().ticks++;
         }
     }
 }
 
 static inline __attribute__((always_inline, flatten)) void brk() {
-    cpu.pc++;
+    cpu().pc++;
 
-    push16(cpu.pc); //push next instruction address onto stack
-    push8(cpu.cpustatus | FLAG_BREAK); //push CPU cpustatus to stack
+    push16(cpu().pc); //push next instruction address onto stack
+    push8(cpu().cpustatus | FLAG_BREAK); //push CPU cpustatus to stack
 
     setinterrupt(); //set interrupt flag
 
-    cpu.pc = read6502(0xFFFE) | (read6502(0xFFFF) << 8);
+    cpu().pc = read6502(0xFFFE) | (read6502(0xFFFF) << 8);
 }
 
 static inline __attribute__((always_inline, flatten)) void bvc() {
-    if((cpu.cpustatus & FLAG_OVERFLOW) == 0) {
-        uint32_t oldpc = cpu.pc;
+    if((cpu().cpustatus & FLAG_OVERFLOW) == 0) {
+        uint32_t oldpc = cpu().pc;
 
-        cpu.pc += cpu.reladdr;
+        COUNT(branchesTaken);
+        cpu().pc += cpu().reladdr;
 
-        if((oldpc & 0xFF00) != (cpu.pc & 0xFF00)) {
-            cpu.ticks += 2; //check if jump crossed a page boundary
+        if((oldpc & 0xFF00) != (cpu().pc & 0xFF00)) {
+            cpu().ticks += 2; //check if jump crossed a page boundary
+            COUNT(branchPageCrossings);
         } else {
-            cpu.ticks++;
+            cpu().ticks++;
         }
     }
 }
 
 static inline __attribute__((always_inline, flatten)) void bvs() {
-    if((cpu.cpustatus & FLAG_OVERFLOW) == FLAG_OVERFLOW) {
-        uint32_t oldpc = cpu.pc;
+    if((cpu().cpustatus & FLAG_OVERFLOW) == FLAG_OVERFLOW) {
+        uint32_t oldpc = cpu().pc;
 
-        cpu.pc += cpu.reladdr;
+        COUNT(branchesTaken);
+        cpu().pc += cpu().reladdr;
 
-        if((oldpc & 0xFF00) != (cpu.pc & 0xFF00)) {
-            cpu.ticks += 2; //check if jump crossed a page boundary
+        if((oldpc & 0xFF00) != (cpu().pc & 0xFF00)) {
+            cpu().ticks += 2; //check if jump crossed a page boundary
+            COUNT(branchPageCrossings);
         } else {
-            cpu.ticks++;
+            cpu().ticks++;
         }
     }
 }
@@ -620,14 +699,14 @@ static inline __attribute__((always_inline, flatten)) void clv() {
 
 static inline __attribute__((always_inline, flatten)) void cmp() {
     uint16_t value = getvalue();
-    uint32_t result = (uint16_t) cpu.a - value;
+    uint32_t result = (uint16_t) cpu().a - value;
 
-    if(cpu.a >= (uint8_t)(value & 0x00FF)) {
+    if(cpu().a >= (uint8_t)(value & 0x00FF)) {
         setcarry();
     } else {
         clearcarry();
     }
-    if(cpu.a == (uint8_t)(value & 0x00FF)) {
+    if(cpu().a == (uint8_t)(value & 0x00FF)) {
         setzero();
     } else {
         clearzero();
@@ -638,14 +717,14 @@ static inline __attribute__((always_inline, flatten)) void cmp() {
 
 static inline __attribute__((always_inline, flatten)) void cmpZP() {
     uint16_t value = getvalueZP();
-    uint32_t result = (uint16_t) cpu.a - value;
+    uint32_t result = (uint16_t) cpu().a - value;
 
-    if(cpu.a >= (uint8_t)(value & 0x00FF)) {
+    if(cpu().a >= (uint8_t)(value & 0x00FF)) {
         setcarry();
     } else {
         clearcarry();
     }
-    if(cpu.a == (uint8_t)(value & 0x00FF)) {
+    if(cpu().a == (uint8_t)(value & 0x00FF)) {
         setzero();
     } else {
         clearzero();
@@ -655,14 +734,14 @@ static inline __attribute__((always_inline, flatten)) void cmpZP() {
 
 static inline __attribute__((always_inline, flatten)) void cpx() {
     uint16_t value = getvalue();
-    uint16_t result = (uint16_t) cpu.x - value;
+    uint16_t result = (uint16_t) cpu().x - value;
 
-    if(cpu.x >= (uint8_t)(value & 0x00FF)) {
+    if(cpu().x >= (uint8_t)(value & 0x00FF)) {
         setcarry();
     } else {
         clearcarry();
     }
-    if(cpu.x == (uint8_t)(value & 0x00FF)) {
+    if(cpu().x == (uint8_t)(value & 0x00FF)) {
         setzero();
     } else {
         clearzero();
@@ -673,14 +752,14 @@ static inline __attribute__((always_inline, flatten)) void cpx() {
 
 static inline __attribute__((always_inline, flatten)) void cpxZP() {
     uint16_t value = getvalueZP();
-    uint16_t result = (uint16_t) cpu.x - value;
+    uint16_t result = (uint16_t) cpu().x - value;
 
-    if(cpu.x >= (uint8_t)(value & 0x00FF)) {
+    if(cpu().x >= (uint8_t)(value & 0x00FF)) {
         setcarry();
     } else {
         clearcarry();
     }
-    if(cpu.x == (uint8_t)(value & 0x00FF)) {
+    if(cpu().x == (uint8_t)(value & 0x00FF)) {
         setzero();
     } else {
         clearzero();
@@ -691,14 +770,14 @@ static inline __attribute__((always_inline, flatten)) void cpxZP() {
 
 static inline __attribute__((always_inline, flatten)) void cpy() {
     uint16_t value = getvalue();
-    uint16_t result = (uint16_t) cpu.y - value;
+    uint16_t result = (uint16_t) cpu().y - value;
 
-    if(cpu.y >= (uint8_t)(value & 0x00FF)) {
+    if(cpu().y >= (uint8_t)(value & 0x00FF)) {
         setcarry();
     } else {
         clearcarry();
     }
-    if(cpu.y == (uint8_t)(value & 0x00FF)) {
+    if(cpu().y == (uint8_t)(value & 0x00FF)) {
         setzero();
     } else {
         clearzero();
@@ -709,14 +788,14 @@ static inline __attribute__((always_inline, flatten)) void cpy() {
 
 static inline __attribute__((always_inline, flatten)) void cpyZP() {
     uint16_t value = getvalueZP();
-    uint16_t result = (uint16_t) cpu.y - value;
+    uint16_t result = (uint16_t) cpu().y - value;
 
-    if(cpu.y >= (uint8_t)(value & 0x00FF)) {
+    if(cpu().y >= (uint8_t)(value & 0x00FF)) {
         setcarry();
     } else {
         clearcarry();
     }
-    if(cpu.y == (uint8_t)(value & 0x00FF)) {
+    if(cpu().y == (uint8_t)(value & 0x00FF)) {
         setzero();
     } else {
         clearzero();
@@ -744,21 +823,21 @@ static inline __attribute__((always_inline, flatten)) void decZP() {
 }
 
 static inline __attribute__((always_inline, flatten)) void dex() {
-    cpu.x--;
+    cpu().x--;
 
-    zerocalc(cpu.x);
-    signcalc(cpu.x);
+    zerocalc(cpu().x);
+    signcalc(cpu().x);
 }
 
 static inline __attribute__((always_inline, flatten)) void dey() {
-    cpu.y--;
+    cpu().y--;
 
-    zerocalc(cpu.y);
-    signcalc(cpu.y);
+    zerocalc(cpu().y);
+    signcalc(cpu().y);
 }
 
 static inline __attribute__((always_inline, flatten)) void eor() {
-    uint32_t result = cpu.a ^ getvalue();
+    uint32_t result = cpu().a ^ getvalue();
 
     zerocalc(result);
     signcalc(result);
@@ -767,7 +846,7 @@ static inline __attribute__((always_inline, flatten)) void eor() {
 }
 
 static inline __attribute__((always_inline, flatten)) void eorZP() {
-    uint32_t result = cpu.a ^ getvalueZP();
+    uint32_t result = cpu().a ^ getvalueZP();
 
     zerocalc(result);
     signcalc(result);
@@ -794,69 +873,69 @@ static inline __attribute__((always_inline, flatten)) void incZP() {
 }
 
 static inline __attribute__((always_inline, flatten)) void inx() {
-    cpu.x++;
+    cpu().x++;
 
-    zerocalc(cpu.x);
-    signcalc(cpu.x);
+    zerocalc(cpu().x);
+    signcalc(cpu().x);
 }
 
 static inline __attribute__((always_inline, flatten)) void iny() {
-    cpu.y++;
+    cpu().y++;
 
-    zerocalc(cpu.y);
-    signcalc(cpu.y);
+    zerocalc(cpu().y);
+    signcalc(cpu().y);
 }
 
 static inline __attribute__((always_inline, flatten)) void jmp() {
-    cpu.pc = cpu.ea;
+    cpu().pc = cpu().ea;
 }
 
 static inline __attribute__((always_inline, flatten)) void jsr() {
-    push16(cpu.pc - 1);
+    push16(cpu().pc - 1);
 
-    cpu.pc = cpu.ea;
+    cpu().pc = cpu().ea;
 }
 
 static inline __attribute__((always_inline, flatten)) void lda() {
-    cpu.a = getvalue();
+    cpu().a = getvalue();
 
-    zerocalc(cpu.a);
-    signcalc(cpu.a);
+    zerocalc(cpu().a);
+    signcalc(cpu().a);
 }
 
 static inline __attribute__((always_inline, flatten)) void ldaZP() {
-    cpu.a = getvalueZP();
+    cpu().a = getvalueZP();
 
-    zerocalc(cpu.a);
-    signcalc(cpu.a);
+    zerocalc(cpu().a);
+    signcalc(cpu().a);
 }
 
 static inline __attribute__((always_inline, flatten)) void ldx() {
-    cpu.x = getvalue();
+    cpu().x = getvalue();
 
-    zerocalc(cpu.x);
-    signcalc(cpu.x);
+    zerocalc(cpu().x);
+    signcalc(cpu().x);
 }
 
 static inline __attribute__((always_inline, flatten)) void ldxZP() {
-    cpu.x = getvalue();
+    cpu().x = getvalue();
 
-    zerocalc(cpu.x);
-    signcalc(cpu.x);
+    zerocalc(cpu().x);
+    signcalc(cpu().x);
 }
 
 static inline __attribute__((always_inline, flatten)) void ldy() {
-    cpu.y = getvalue();
+    cpu().y = getvalue();
 
-    zerocalc(cpu.y);
-    signcalc(cpu.y);
+    zerocalc(cpu().y);
+    signcalc(cpu().y);
 }
 
 static inline __attribute__((always_inline, flatten)) void ldyZP() {
-    cpu.y = getvalueZP();
+    cpu().y = getvalueZP();
 
-    zerocalc(cpu.y);
-    signcalc(cpu.y);
+    zerocalc(cpu().y);
+    signcalc(cpu().y);
 }
 
 static inline __attribute__((always_inline, flatten)) void lsr() {
@@ -891,7 +970,7 @@ static inline __attribute__((always_inline, flatten)) void lsrZP() {
 }
 
 static inline __attribute__((always_inline, flatten)) void lsra() {
-    uint8_t value = cpu.a;
+    uint8_t value = cpu().a;
     uint8_t result = value >> 1;
 
     if(value & 1) {
@@ -907,7 +986,7 @@ static inline __attribute__((always_inline, flatten)) void lsra() {
 }
 
 static inline __attribute__((always_inline, flatten)) void ora() {
-    uint32_t result = cpu.a | getvalue();
+    uint32_t result = cpu().a | getvalue();
 
     zerocalc(result);
     signcalc(result);
@@ -915,7 +994,7 @@ static inline __attribute__((always_inline, flatten)) void ora() {
 }
 
 static inline __attribute__((always_inline, flatten)) void oraZP() {
-    uint32_t result = cpu.a | getvalueZP();
+    uint32_t result = cpu().a | getvalueZP();
 
     zerocalc(result);
     signcalc(result);
@@ -923,27 +1002,27 @@ static inline __attribute__((always_inline, flatten)) void oraZP() {
 }
 
 static inline __attribute__((always_inline, flatten)) void pha() {
-    push8(cpu.a);
+    push8(cpu().a);
 }
 
 static inline __attribute__((always_inline, flatten)) void php() {
-    push8(cpu.cpustatus | FLAG_BREAK);
+    push8(cpu().cpustatus | FLAG_BREAK);
 }
 
 static inline __attribute__((always_inline, flatten)) void pla() {
-    cpu.a = pull8();
+    cpu().a = pull8();
 
-    zerocalc(cpu.a);
-    signcalc(cpu.a);
+    zerocalc(cpu().a);
+    signcalc(cpu().a);
 }
 
 static inline __attribute__((always_inline, flatten)) void plp() {
-    cpu.cpustatus = (pull8() & 0xef) | FLAG_CONSTANT;
+    cpu().cpustatus = (pull8() & 0xef) | FLAG_CONSTANT;
 }
 
 static inline __attribute__((always_inline, flatten)) void rol() {
     uint16_t value = getvalue();
-    uint16_t result = (value << 1) | (cpu.cpustatus & FLAG_CARRY);
+    uint16_t result = (value << 1) | (cpu().cpustatus & FLAG_CARRY);
 
     carrycalc(result);
     zerocalc(result);
@@ -953,7 +1032,7 @@ static inline __attribute__((always_inline, flatten)) void rol() {
 
 static inline __attribute__((always_inline, flatten)) void rolZP() {
     uint16_t value = getvalueZP();
-    uint16_t result = (value << 1) | (cpu.cpustatus & FLAG_CARRY);
+    uint16_t result = (value << 1) | (cpu().cpustatus & FLAG_CARRY);
 
     carrycalc(result);
     zerocalc(result);
@@ -962,8 +1041,8 @@ static inline __attribute__((always_inline, flatten)) void rolZP() {
 }
 
 static inline __attribute__((always_inline, flatten)) void rola() {
-    uint16_t value = cpu.a;
-    uint16_t result = (value << 1) | (cpu.cpustatus & FLAG_CARRY);
+    uint16_t value = cpu().a;
+    uint16_t result = (value << 1) | (cpu().cpustatus & FLAG_CARRY);
 
     carrycalc(result);
     zerocalc(result);
@@ -973,7 +1052,7 @@ static inline __attribute__((always_inline, flatten)) void rola() {
 
 static inline __attribute__((always_inline, flatten)) void ror() {
     uint32_t value = getvalue();
-    uint16_t result = (value >> 1) | ((cpu.cpustatus & FLAG_CARRY) << 7);
+    uint16_t result = (value >> 1) | ((cpu().cpustatus & FLAG_CARRY) << 7);
 
     if(value & 1) {
         setcarry();
@@ -988,7 +1067,7 @@ static inline __attribute__((always_inline, flatten)) void ror() {
 
 static inline __attribute__((always_inline, flatten)) void rorZP() {
     uint32_t value = getvalueZP();
-    uint16_t result = (value >> 1) | ((cpu.cpustatus & FLAG_CARRY) << 7);
+    uint16_t result = (value >> 1) | ((cpu().cpustatus & FLAG_CARRY) << 7);
 
     if(value & 1) {
         setcarry();
@@ -1002,8 +1081,8 @@ static inline __attribute__((always_inline, flatten)) void rorZP() {
 }
 
 static inline __attribute__((always_inline, flatten)) void rora() {
-    uint32_t value = cpu.a;
-    uint16_t result = (value >> 1) | ((cpu.cpustatus & FLAG_CARRY) << 7);
+    uint32_t value = cpu().a;
+    uint16_t result = (value >> 1) | ((cpu().cpustatus & FLAG_CARRY) << 7);
 
     if(value & 1) {
         setcarry();
@@ -1018,12 +1097,12 @@ static inline __attribute__((always_inline, flatten)) void rora() {
 
 
 static inline __attribute__((always_inline, flatten)) void rti() {
-    cpu.cpustatus = pull8();
-    cpu.pc = pull16();
+    cpu().cpustatus = pull8();
+    cpu().pc = pull16();
 }
 
 static inline __attribute__((always_inline, flatten)) void rts() {
-    cpu.pc = pull16() + 1;
+    cpu().pc = pull16() + 1;
 }
 
 static inline __attribute__((always_inline, flatten)) void sbc() {
@@ -1050,54 +1129,54 @@ static inline __attribute__((always_inline, flatten)) void sei_() {
 }
 
 static inline __attribute__((always_inline, flatten)) void sta() {
-    putvalue(cpu.a);
+    putvalue(cpu().a);
 }
 
 static inline __attribute__((always_inline, flatten)) void stx() {
-    putvalue(cpu.x);
+    putvalue(cpu().x);
 }
 
 static inline __attribute__((always_inline, flatten)) void sty() {
-    putvalue(cpu.y);
+    putvalue(cpu().y);
 }
 
 static inline __attribute__((always_inline, flatten)) void tax() {
-    cpu.x = cpu.a;
+    cpu().x = cpu().a;
 
-    zerocalc(cpu.x);
-    signcalc(cpu.x);
+    zerocalc(cpu().x);
+    signcalc(cpu().x);
 }
 
 static inline __attribute__((always_inline, flatten)) void tay() {
-    cpu.y = cpu.a;
+    cpu().y = cpu().a;
 
-    zerocalc(cpu.y);
-    signcalc(cpu.y);
+    zerocalc(cpu().y);
+    signcalc(cpu().y);
 }
 
 static inline __attribute__((always_inline, flatten)) void tsx() {
-    cpu.x = cpu.sp;
+    cpu().x = cpu().sp;
 
-    zerocalc(cpu.x);
-    signcalc(cpu.x);
+    zerocalc(cpu().x);
+    signcalc(cpu().x);
 }
 
 static inline __attribute__((always_inline, flatten)) void txa() {
-    cpu.a = cpu.x;
+    cpu().a = cpu().x;
 
-    zerocalc(cpu.a);
-    signcalc(cpu.a);
+    zerocalc(cpu().a);
+    signcalc(cpu().a);
 }
 
 static inline __attribute__((always_inline, flatten)) void txs() {
-    cpu.sp = cpu.x;
+    cpu().sp = cpu().x;
 }
 
 static inline __attribute__((always_inline, flatten)) void tya() {
-    cpu.a = cpu.y;
+    cpu().a = cpu().y;
 
-    zerocalc(cpu.a);
-    signcalc(cpu.a);
+    zerocalc(cpu().a);
+    signcalc(cpu().a);
 }
 
 
@@ -1110,7 +1189,7 @@ static inline __attribute__((always_inline, flatten)) void lax() {
 static inline __attribute__((always_inline, flatten)) void sax() {
     sta();
     stx();
-    putvalue(cpu.a & cpu.x);
+    putvalue(cpu().a & cpu().x);
 }
 
 static inline __attribute__((always_inline, flatten)) void dcp() {
@@ -1144,7 +1223,7 @@ static inline __attribute__((always_inline, flatten)) void rra() {
 }
 
 static inline __attribute__((always_inline, flatten)) void alr() { // (FB)
-    uint32_t result = cpu.a & getvalue();
+    uint32_t result = cpu().a & getvalue();
 
     if(result & 1) {
         setcarry();
@@ -1162,11 +1241,11 @@ static inline __attribute__((always_inline, flatten)) void alr() { // (FB)
 static inline __attribute__((always_inline, flatten)) void arr() { //This one took me hours.. finally taken from VICE (FB)
     uint32_t result;
 
-    result = cpu.a & getvalue();
+    result = cpu().a & getvalue();
 
-    if(!(cpu.cpustatus & FLAG_DECIMAL)) {
+    if(!(cpu().cpustatus & FLAG_DECIMAL)) {
         result >>= 1;
-        result |= ((cpu.cpustatus & FLAG_CARRY) << 7);
+        result |= ((cpu().cpustatus & FLAG_CARRY) << 7);
 
         signcalc(result);
         zerocalc(result);
@@ -1187,9 +1266,9 @@ static inline __attribute__((always_inline, flatten)) void arr() { //This one to
         uint32_t t2 = result;
 
         t2 >>= 1;
-        t2 |= ((cpu.cpustatus & FLAG_CARRY) << 7);
+        t2 |= ((cpu().cpustatus & FLAG_CARRY) << 7);
 
-        if(cpu.cpustatus & FLAG_CARRY) {
+        if(cpu().cpustatus & FLAG_CARRY) {
             setsign();
         } else {
             clearsign();
@@ -1219,7 +1298,7 @@ static inline __attribute__((always_inline, flatten)) void arr() { //This one to
 static inline __attribute__((always_inline, flatten)) void xaa() { // AKA ANE
     const uint32_t val = 0xee; // VICE uses 0xff - but this results in an error in the testsuite (FB)
 
-    uint32_t result = (cpu.a | val) & cpu.x & getvalue();
+    uint32_t result = (cpu().a | val) & cpu().x & getvalue();
 
     signcalc(result);
     zerocalc(result);
@@ -1229,12 +1308,12 @@ static inline __attribute__((always_inline, flatten)) void xaa() { // AKA ANE
 static inline __attribute__((always_inline, flatten)) void lxa() {
     const uint32_t val = 0xee;
 
-    uint32_t result = (cpu.a | val) & getvalue();
+    uint32_t result = (cpu().a | val) & getvalue();
 
     signcalc(result);
     zerocalc(result);
 
-    cpu.x = result;
+    cpu().x = result;
 
     saveaccum(result);
 }
@@ -1242,8 +1321,8 @@ static inline __attribute__((always_inline, flatten)) void lxa() {
 static inline __attribute__((always_inline, flatten)) void axs() { //aka SBX
     uint32_t result = getvalue();
 
-    result = (cpu.a & cpu.x) - result;
-    cpu.x = result;
+    result = (cpu().a & cpu().x) - result;
+    cpu().x = result;
 
     if(result < 0x100) {
         setcarry();
@@ -1251,8 +1330,8 @@ static inline __attribute__((always_inline, flatten)) void axs() { //aka SBX
         clearcarry();
     }
 
-    zerocalc(cpu.x);
-    signcalc(cpu.x);
+    zerocalc(cpu().x);
+    signcalc(cpu().x);
 }
 
 static inline __attribute__((always_inline, flatten)) void ahx() { //todo (is unstable)
@@ -1260,12 +1339,12 @@ static inline __attribute__((always_inline, flatten)) void ahx() { //todo (is un
 }
 
 static inline __attribute__((always_inline, flatten)) void anc() {
-    uint32_t result = cpu.a & getvalue();
+    uint32_t result = cpu().a & getvalue();
 
     signcalc(result)
     zerocalc(result);
 
-    if(cpu.cpustatus & FLAG_SIGN) {
+    if(cpu().cpustatus & FLAG_SIGN) {
         setcarry();
     } else {
         clearcarry();
@@ -1275,13 +1354,13 @@ static inline __attribute__((always_inline, flatten)) void anc() {
 }
 
 static inline __attribute__((always_inline, flatten)) void las() {
-    uint32_t result = cpu.sp & getvalue();
+    uint32_t result = cpu().sp & getvalue();
 
     signcalc(result);
     zerocalc(result);
 
-    cpu.sp = result;
-    cpu.x = result;
+    cpu().sp = result;
+    cpu().x = result;
 
     saveaccum(result);
 }
@@ -1292,157 +1371,171 @@ static inline __attribute__((always_inline, flatten)) void las() {
 
 static void opKIL(void) {
     Serial.print("CPU JAM @ $");
-    Serial.println(cpu.pc);
+    Serial.println(cpu().pc);
+#if TRACE
+    traceDump();
+#endif
 
     cpu_reset();
 }
 
+//KIL, also fetched instead of the opcode when the monitor stops the CPU at a checkpoint
+static void op0x2(void) {
+#if MONITOR
+    if(monitorStopped()) { return; }
+#endif
+    opKIL();
+}
+
 static void op0x0(void) {
-    cpu.ticks = 7;
+    cpu().ticks = 7;
 
     imp();
     brk();
 }
 
 static void op0x1(void) {
-    cpu.ticks = 6;
+    cpu().ticks = 6;
 
     indx();
     ora();
 }
 
 static void op0x3(void) { //undocumented
-    cpu.ticks = 8;
+    cpu().ticks = 8;
 
     indx();
     slo();
 }
 
 static void op0x4(void) { //nop read zeropage
-    cpu.ticks = 3;
+    cpu().ticks = 3;
 
     zp();
 }
 
 static void op0x5(void) {
-    cpu.ticks = 3;
+    cpu().ticks = 3;
 
     zp();
     oraZP();
 }
 
 static void op0x6(void) {
-    cpu.ticks = 5;
+    cpu().ticks = 5;
 
     zp();
     aslZP();
 }
 
 static void op0x7(void) { //undocumented SLO
-    cpu.ticks = 5;
+    cpu().ticks = 5;
 
     zp();
     slo();
 }
 
 static void op0x8(void) {
-    cpu.ticks = 3;
+    cpu().ticks = 3;
 
     imp();
     php();
 }
 
 static void op0x9(void) {
-    cpu.ticks = 2;
+    cpu().ticks = 2;
 
     imm();
     ora();
 }
 
 static void op0xA(void) {
-    cpu.ticks = 2;
+    cpu().ticks = 2;
 
     //acc();
     asla();
 }
 
 static void op0xB(void) { //undocumented
-    cpu.ticks = 2;
+    cpu().ticks = 2;
 
     imm();
     anc();
 }
 
 static void op0xC(void) { //nop
-    cpu.ticks = 4;
+    cpu().ticks = 4;
 
     abso();
 }
 
 static void op0xD(void) {
-    cpu.ticks = 4;
+    cpu().ticks = 4;
 
     abso();
     ora();
 }
 
 static void op0xE(void) {
-    cpu.ticks = 6;
+    cpu().ticks = 6;
 
     abso();
     asl();
 }
 
 static void op0xF(void) { //undocumented
-    cpu.ticks = 6;
+    cpu().ticks = 6;
 
     abso();
     slo();
 }
 
 static void op0x10(void) {
-    cpu.ticks = 2;
+    cpu().ticks = 2;
 
     rel();
     bpl();
+#if LOOPIDIOMS
+    if((cpu().reladdr & 0x8000) && !(cpu().cpustatus & FLAG_SIGN)) { loopIdiom(0x10, lineCyclesLeft()); }
+#endif
 }
 
 static void op0x11(void) {
-    cpu.ticks = 5;
+    cpu().ticks = 5;
 
     indy_t();
     ora();
 }
 
 static void op0x13(void) { //undocumented
-    cpu.ticks = 8;
+    cpu().ticks = 8;
 
     indy();
     slo();
 }
 
 static void op0x14(void) { //nop
-    cpu.ticks = 4;
+    cpu().ticks = 4;
 
     zpx();
 }
 
 static void op0x15(void) {
-    cpu.ticks = 4;
+    cpu().ticks = 4;
 
     zpx();
     ora();
 }
 
 static void op0x16(void) {
-    cpu.ticks = 6;
+    cpu().ticks = 6;
 
     zpx();
     asl();
 }
 
 static void op0x17(void) { //undocumented
-    cpu.ticks = 6;
+    cpu().ticks = 6;
 
     //zpy(); bug
     zpx();
@@ -1450,44 +1543,44 @@ static void op0x17(void) { //undocumented
 }
 
 static void op0x18(void) {
-    cpu.ticks = 2;
+    cpu().ticks = 2;
 
     imp();
     clc();
 }
 
 static void op0x19(void) {
-    cpu.ticks = 4;
+    cpu().ticks = 4;
 
     absy_t();
     ora();
 }
 
 static void op0x1A(void) { //nop
-    cpu.ticks = 2;
+    cpu().ticks = 2;
 }
 
 static void op0x1B(void) { //undocumented
-    cpu.ticks = 7;
+    cpu().ticks = 7;
 
     absy();
     slo();
 }
 
 static void op0x1C(void) { //nop
-    cpu.ticks = 4;
+    cpu().ticks = 4;
     //();
 }
 
 static void op0x1D(void) {
-    cpu.ticks = 4;
+    cpu().ticks = 4;
 
     absx_t();
     ora();
 }
 
 static void op0x1E(void) {
-    cpu.ticks = 7;
+    cpu().ticks = 7;
 
     absx();
     asl();
@@ -1495,337 +1588,337 @@ static void op0x1E(void) {
 
 
 static void op0x1F(void) { //undocumented
-    cpu.ticks = 7;
+    cpu().ticks = 7;
 
     absx();
     slo();
 }
 
 static void op0x20(void) {
-    cpu.ticks = 6;
+    cpu().ticks = 6;
 
     abso();
     jsr();
 }
 
 static void op0x21(void) {
-    cpu.ticks = 6;
+    cpu().ticks = 6;
 
     indx();
     op_and();
 }
 
 static void op0x23(void) { //undocumented
-    cpu.ticks = 8;
+    cpu().ticks = 8;
 
     indx();
     rla();
 }
 
 static void op0x24(void) {
-    cpu.ticks = 3;
+    cpu().ticks = 3;
 
     zp();
     op_bitZP();
 }
 
 static void op0x25(void) {
-    cpu.ticks = 3;
+    cpu().ticks = 3;
 
     zp();
     op_and();
 }
 
 static void op0x26(void) {
-    cpu.ticks = 5;
+    cpu().ticks = 5;
 
     zp();
     rolZP();
 }
 
 static void op0x27(void) { //undocumented
-    cpu.ticks = 5;
+    cpu().ticks = 5;
 
     zp();
     rla();
 }
 
 static void op0x28(void) {
-    cpu.ticks = 4;
+    cpu().ticks = 4;
 
     imp();
     plp();
 }
 
 static void op0x29(void) {
-    cpu.ticks = 2;
+    cpu().ticks = 2;
 
     imm();
     op_and();
 }
 
 static void op0x2A(void) {
-    cpu.ticks = 2;
+    cpu().ticks = 2;
 
     //acc();
     rola();
 }
 
 static void op0x2B(void) { //undocumented
-    cpu.ticks = 2;
+    cpu().ticks = 2;
 
     imm();
     anc();
 }
 
 static void op0x2C(void) {
-    cpu.ticks = 4;
+    cpu().ticks = 4;
 
     abso();
     op_bit();
 }
 
 static void op0x2D(void) {
-    cpu.ticks = 4;
+    cpu().ticks = 4;
 
     abso();
     op_and();
 }
 
 static void op0x2E(void) {
-    cpu.ticks = 6;
+    cpu().ticks = 6;
 
     abso();
     rol();
 }
 
 static void op0x2F(void) { //undocumented
-    cpu.ticks = 6;
+    cpu().ticks = 6;
 
     abso();
     rla();
 }
 
 static void op0x30(void) {
-    cpu.ticks = 2;
+    cpu().ticks = 2;
 
     rel();
     bmi();
 }
 
 static void op0x31(void) {
-    cpu.ticks = 5;
+    cpu().ticks = 5;
 
     indy_t();
     op_and();
 }
 
 static void op0x33(void) { //undocumented
-    cpu.ticks = 8;
+    cpu().ticks = 8;
 
     indy();
     rla();
 }
 
 static void op0x34(void) { //nop
-    cpu.ticks = 4;
+    cpu().ticks = 4;
 
     zpx();
 }
 
 static void op0x35(void) {
-    cpu.ticks = 4;
+    cpu().ticks = 4;
 
     zpx();
     op_and();
 }
 
 static void op0x36(void) {
-    cpu.ticks = 6;
+    cpu().ticks = 6;
 
     zpx();
     rol();
 }
 
 static void op0x37(void) { //undocumented
-    cpu.ticks = 6;
+    cpu().ticks = 6;
 
     zpx();
     rla();
 }
 
 static void op0x38(void) {
-    cpu.ticks = 2;
+    cpu().ticks = 2;
 
     imp();
     sec();
 }
 
 static void op0x39(void) {
-    cpu.ticks = 4;
+    cpu().ticks = 4;
 
     absy_t();
     op_and();
 }
 
 static void op0x3A(void) { //nop
-    cpu.ticks = 2;
+    cpu().ticks = 2;
 }
 
 static void op0x3B(void) { //undocumented
-    cpu.ticks = 7;
+    cpu().ticks = 7;
 
     absy();
     rla();
 }
 
 static void op0x3C(void) { //nop
-    cpu.ticks = 4;
+    cpu().ticks = 4;
 
     absx_t();
 }
 
 static void op0x3D(void) {
-    cpu.ticks = 4;
+    cpu().ticks = 4;
 
     absx_t();
     op_and();
 }
 
 static void op0x3E(void) {
-    cpu.ticks = 7;
+    cpu().ticks = 7;
 
     absx();
     rol();
 }
 
 static void op0x3F(void) { //undocumented
-    cpu.ticks = 7;
+    cpu().ticks = 7;
 
     absx();
     rla();
 }
 
 static void op0x40(void) {
-    cpu.ticks = 6;
+    cpu().ticks = 6;
 
     imp();
     rti();
 }
 
 static void op0x41(void) {
-    cpu.ticks = 6;
+    cpu().ticks = 6;
 
     indx();
     eor();
 }
 
 static void op0x43(void) { //undocumented
-    cpu.ticks = 8;
+    cpu().ticks = 8;
 
     indx();
     sre();
 }
 
 static void op0x44(void) { //nop
-    cpu.ticks = 3;
+    cpu().ticks = 3;
 
     zp();
 }
 
 static void op0x45(void) {
-    cpu.ticks = 3;
+    cpu().ticks = 3;
 
     zp();
     eorZP();
 }
 
 static void op0x46(void) {
-    cpu.ticks = 5;
+    cpu().ticks = 5;
 
     zp();
     lsrZP();
 }
 
 static void op0x47(void) { //undocumented
-    cpu.ticks = 5;
+    cpu().ticks = 5;
 
     zp();
     sre();
 }
 
 static void op0x48(void) {
-    cpu.ticks = 3;
+    cpu().ticks = 3;
 
     imp();
     pha();
 }
 
 static void op0x49(void) {
-    cpu.ticks = 2;
+    cpu().ticks = 2;
 
     imm();
     eor();
 }
 
 static void op0x4A(void) {
-    cpu.ticks = 2;
+    cpu().ticks = 2;
 
 //	acc();
     lsra();
 }
 
 static void op0x4B(void) { //undocumented
-    cpu.ticks = 2;
+    cpu().ticks = 2;
 
     imm();
     alr();
 }
 
 static void op0x4C(void) {
-    cpu.ticks = 3;
+    cpu().ticks = 3;
 
     abso();
     jmp();
 }
 
 static void op0x4D(void) {
-    cpu.ticks = 4;
+    cpu().ticks = 4;
 
     abso();
     eor();
 }
 
 static void op0x4E(void) {
-    cpu.ticks = 6;
+    cpu().ticks = 6;
 
     abso();
     lsr();
 }
 
 static void op0x4F(void) { //undocumented
-    cpu.ticks = 6;
+    cpu().ticks = 6;
 
     abso();
     sre();
 }
 
 static void op0x50(void) {
-    cpu.ticks = 2;
+    cpu().ticks = 2;
 
     rel();
     bvc();
 }
 
 static void op0x51(void) {
-    cpu.ticks = 5;
+    cpu().ticks = 5;
 
     indy_t();
     eor();
 }
 
 static void op0x53(void) { //undocumented
-    cpu.ticks = 8;
+    cpu().ticks = 8;
 
     //zp(); BUG
     indy();
@@ -1833,469 +1926,469 @@ static void op0x53(void) { //undocumented
 }
 
 static void op0x54(void) { //nop
-    cpu.ticks = 4;
+    cpu().ticks = 4;
 
     zpx();
 }
 
 static void op0x55(void) {
-    cpu.ticks = 4;
+    cpu().ticks = 4;
 
     zpx();
     eor();
 }
 
 static void op0x56(void) {
-    cpu.ticks = 6;
+    cpu().ticks = 6;
 
     zpx();
     lsr();
 }
 
 static void op0x57(void) { //undocumented
-    cpu.ticks = 6;
+    cpu().ticks = 6;
 
     zpx();
     sre();
 }
 
 static void op0x58(void) {
-    cpu.ticks = 2;
+    cpu().ticks = 2;
 
     imp();
     cli_();
 }
 
 static void op0x59(void) {
-    cpu.ticks = 4;
+    cpu().ticks = 4;
 
     absy_t();
     eor();
 }
 
 static void op0x5A(void) { //nop
-    cpu.ticks = 2;
+    cpu().ticks = 2;
 }
 
 static void op0x5B(void) { //undocumented
-    cpu.ticks = 7;
+    cpu().ticks = 7;
 
     absy();
     sre();
 }
 
 static void op0x5C(void) { //nop
-    cpu.ticks = 4;
+    cpu().ticks = 4;
 
     absx_t();
 }
 
 static void op0x5D(void) {
-    cpu.ticks = 4;
+    cpu().ticks = 4;
 
     absx_t();
     eor();
 }
 
 static void op0x5E(void) {
-    cpu.ticks = 7;
+    cpu().ticks = 7;
 
     absx();
     lsr();
 }
 
 static void op0x5F(void) { //undocumented
-    cpu.ticks = 7;
+    cpu().ticks = 7;
 
     absx();
     sre();
 }
 
 static void op0x60(void) {
-    cpu.ticks = 6;
+    cpu().ticks = 6;
 
     imp();
     rts();
 }
 
 static void op0x61(void) {
-    cpu.ticks = 6;
+    cpu().ticks = 6;
 
     indx();
     adc();
 }
 
 static void op0x63(void) { //undocumented
-    cpu.ticks = 8;
+    cpu().ticks = 8;
 
     indx();
     rra();
 }
 
 static void op0x64(void) {
-    cpu.ticks = 3;
+    cpu().ticks = 3;
 
     zp();
 }
 
 static void op0x65(void) {
-    cpu.ticks = 3;
+    cpu().ticks = 3;
 
     zp();
     adcZP();
 }
 
 static void op0x66(void) {
-    cpu.ticks = 5;
+    cpu().ticks = 5;
 
     zp();
     rorZP();
 }
 
 static void op0x67(void) { //undocumented
-    cpu.ticks = 5;
+    cpu().ticks = 5;
 
     zp();
     rra();
 }
 
 static void op0x68(void) {
-    cpu.ticks = 4;
+    cpu().ticks = 4;
 
     imp();
     pla();
 }
 
 static void op0x69(void) {
-    cpu.ticks = 2;
+    cpu().ticks = 2;
     
     imm();
     adc();
 }
 
 static void op0x6A(void) {
-    cpu.ticks = 2;
+    cpu().ticks = 2;
 
 //	acc();
     rora();
 }
 
 static void op0x6B(void) { //undocumented
-    cpu.ticks = 2;
+    cpu().ticks = 2;
 
     imm();
     arr();
 }
 
 static void op0x6C(void) {
-    cpu.ticks = 5;
+    cpu().ticks = 5;
 
     ind();
     jmp();
 }
 
 static void op0x6D(void) {
-    cpu.ticks = 4;
+    cpu().ticks = 4;
 
     abso();
     adc();
 }
 
 static void op0x6E(void) {
-    cpu.ticks = 6;
+    cpu().ticks = 6;
 
     abso();
     ror();
 }
 
 static void op0x6F(void) { //undocumented
-    cpu.ticks = 6;
+    cpu().ticks = 6;
 
     abso();
     rra();
 }
 
 static void op0x70(void) {
-    cpu.ticks = 2;
+    cpu().ticks = 2;
 
     rel();
     bvs();
 }
 
 static void op0x71(void) {
-    cpu.ticks = 5;
+    cpu().ticks = 5;
 
     indy_t();
     adc();
 }
 
 static void op0x73(void) { //undocumented
-    cpu.ticks = 8;
+    cpu().ticks = 8;
 
     indy();
     rra();
 }
 
 static void op0x74(void) { //nop
-    cpu.ticks = 4;
+    cpu().ticks = 4;
 
     zpx();
 }
 
 static void op0x75(void) {
-    cpu.ticks = 4;
+    cpu().ticks = 4;
 
     zpx();
     adc();
 }
 
 static void op0x76(void) {
-    cpu.ticks = 6;
+    cpu().ticks = 6;
 
     zpx();
     ror();
 }
 
 static void op0x77(void) { //undocumented
-    cpu.ticks = 6;
+    cpu().ticks = 6;
 
     zpx();
     rra();
 }
 
 static void op0x78(void) {
-    cpu.ticks = 2;
+    cpu().ticks = 2;
 
     imp();
     sei_();
 }
 
 static void op0x79(void) {
-    cpu.ticks = 4;
+    cpu().ticks = 4;
 
     absy_t();
     adc();
 }
 
 static void op0x7A(void) { //nop
-    cpu.ticks = 2;
+    cpu().ticks = 2;
 }
 
 static void op0x7B(void) { //undocumented
-    cpu.ticks = 7;
+    cpu().ticks = 7;
 
     absy();
     rra();
 }
 
 static void op0x7C(void) { //nop
-    cpu.ticks = 4;
+    cpu().ticks = 4;
 
     absx_t();
 }
 
 static void op0x7D(void) {
-    cpu.ticks = 4;
+    cpu().ticks = 4;
 
     absx_t();
     adc();
 }
 
 static void op0x7E(void) {
-    cpu.ticks = 7;
+    cpu().ticks = 7;
 
     absx();
     ror();
 }
 
 static void op0x7F(void) { //undocumented
-    cpu.ticks = 7;
+    cpu().ticks = 7;
 
     absx();
     rra();
 }
 
 static void op0x80(void) { //nop
-    cpu.ticks = 2;
+    cpu().ticks = 2;
 
     imm();
 }
 
 static void op0x81(void) {
-    cpu.ticks = 6;
+    cpu().ticks = 6;
 
     indx();
     sta();
 }
 
 static void op0x82(void) { //nop
-    cpu.ticks = 2;
+    cpu().ticks = 2;
 
     imm();
 }
 
 static void op0x83(void) { //undocumented
-    cpu.ticks = 6;
+    cpu().ticks = 6;
 
     indx();
     sax();
 }
 
 static void op0x84(void) {
-    cpu.ticks = 3;
+    cpu().ticks = 3;
 
     zp();
     sty();
 }
 
 static void op0x85(void) {
-    cpu.ticks = 3;
+    cpu().ticks = 3;
 
     zp();
     sta();
 }
 
 static void op0x86(void) {
-    cpu.ticks = 3;
+    cpu().ticks = 3;
 
     zp();
     stx();
 }
 
 static void op0x87(void) { //undocumented
-    cpu.ticks = 3;
+    cpu().ticks = 3;
 
     zp();
     sax();
 }
 
 static void op0x88(void) {
-    cpu.ticks = 2;
+    cpu().ticks = 2;
 
     imp();
     dey();
 }
 
 static void op0x89(void) { //nop
-    cpu.ticks = 2;
+    cpu().ticks = 2;
 
     imm();
 }
 
 static void op0x8A(void) {
-    cpu.ticks = 2;
+    cpu().ticks = 2;
 
     imp();
     txa();
 }
 
 static void op0x8B(void) { //undocumented
-    cpu.ticks = 2;
+    cpu().ticks = 2;
 
     imm();
     xaa();
 }
 
 static void op0x8C(void) {
-    cpu.ticks = 4;
+    cpu().ticks = 4;
 
     abso();
     sty();
 }
 
 static void op0x8D(void) {
-    cpu.ticks = 4;
+    cpu().ticks = 4;
 
     abso();
     sta();
 }
 
 static void op0x8E(void) {
-    cpu.ticks = 4;
+    cpu().ticks = 4;
 
     abso();
     stx();
 }
 
 static void op0x8F(void) { //undocumented
-    cpu.ticks = 4;
+    cpu().ticks = 4;
 
     abso();
     sax();
 }
 
 static void op0x90(void) {
-    cpu.ticks = 2;
+    cpu().ticks = 2;
 
     rel();
     bcc();
 }
 
 static void op0x91(void) {
-    cpu.ticks = 6;
+    cpu().ticks = 6;
 
     indy();
     sta();
 }
 
 static void op0x93(void) { //undocumented
-    cpu.ticks = 6;
+    cpu().ticks = 6;
 
     indy();
     ahx();
 }
 
 static void op0x94(void) {
-    cpu.ticks = 4;
+    cpu().ticks = 4;
 
     zpx();
     sty();
 }
 
 static void op0x95(void) {
-    cpu.ticks = 4;
+    cpu().ticks = 4;
 
     zpx();
     sta();
 }
 
 static void op0x96(void) {
-    cpu.ticks = 4;
+    cpu().ticks = 4;
 
     zpy();
     stx();
 }
 
 static void op0x97(void) { //undocumented
-    cpu.ticks = 4;
+    cpu().ticks = 4;
 
     zpy();
     sax();
 }
 
 static void op0x98(void) {
-    cpu.ticks = 2;
+    cpu().ticks = 2;
 
     imp();
     tya();
 }
 
 static void op0x99(void) {
-    cpu.ticks = 5;
+    cpu().ticks = 5;
 
     absy();
     sta();
 }
 
 static void op0x9A(void) {
-    cpu.ticks = 2;
+    cpu().ticks = 2;
 
     imp();
     txs();
 }
 
 static void op0x9B(void) { //undocumented
-    cpu.ticks = 5;
+    cpu().ticks = 5;
 
     absy();
     //tas();
@@ -2303,7 +2396,7 @@ static void op0x9B(void) { //undocumented
 }
 
 static void op0x9C(void) { //undocumented
-    cpu.ticks = 5;
+    cpu().ticks = 5;
 
     absy();
     //shy();
@@ -2311,648 +2404,651 @@ static void op0x9C(void) { //undocumented
 }
 
 static void op0x9D(void) {
-    cpu.ticks = 5;
+    cpu().ticks = 5;
 
     absx();
     sta();
 }
 
 static void op0x9E(void) { //undocumented
-    cpu.ticks = 5;
+    cpu().ticks = 5;
 
     absx();
     //shx();
 }
 
 static void op0x9F(void) { //undocumented
-    cpu.ticks = 5;
+    cpu().ticks = 5;
 
     absx();
     ahx();
 }
 
 static void op0xA0(void) {
-    cpu.ticks = 2;
+    cpu().ticks = 2;
 
     imm();
     ldy();
 }
 
 static void op0xA1(void) {
-    cpu.ticks = 6;
+    cpu().ticks = 6;
 
     indx();
     lda();
 }
 
 static void op0xA2(void) {
-    cpu.ticks = 2;
+    cpu().ticks = 2;
 
     imm();
     ldx();
 }
 
 static void op0xA3(void) { //undocumented
-    cpu.ticks = 6;
+    cpu().ticks = 6;
 
     indx();
     lax();
 }
 
 static void op0xA4(void) {
-    cpu.ticks = 3;
+    cpu().ticks = 3;
 
     zp();
     ldyZP();
 }
 
 static void op0xA5(void) {
-    cpu.ticks = 3;
+    cpu().ticks = 3;
 
     zp();
     ldaZP();
 }
 
 static void op0xA6(void) {
-    cpu.ticks = 3;
+    cpu().ticks = 3;
 
     zp();
     ldxZP();
 }
 
 static void op0xA7(void) { //undocumented
-    cpu.ticks = 3;
+    cpu().ticks = 3;
 
     zp();
     lax();
 }
 
 static void op0xA8(void) {
-    cpu.ticks = 2;
+    cpu().ticks = 2;
 
     imp();
     tay();
 }
 
 static void op0xA9(void) {
-    cpu.ticks = 2;
+    cpu().ticks = 2;
 
     imm();
     lda();
 }
 
 static void op0xAA(void) {
-    cpu.ticks = 2;
+    cpu().ticks = 2;
 
     imp();
     tax();
 }
 
 static void op0xAB(void) { //undocumented
-    cpu.ticks = 2;
+    cpu().ticks = 2;
 
     imm();
     lxa();
 }
 
 static void op0xAC(void) {
-    cpu.ticks = 4;
+    cpu().ticks = 4;
 
     abso();
     ldy();
 }
 
 static void op0xAD(void) {
-    cpu.ticks = 4;
+    cpu().ticks = 4;
 
     abso();
     lda();
 }
 
 static void op0xAE(void) {
-    cpu.ticks = 4;
+    cpu().ticks = 4;
 
     abso();
     ldx();
 }
 
 static void op0xAF(void) { //undocumented
-    cpu.ticks = 4;
+    cpu().ticks = 4;
 
     abso();
     lax();
 }
 
 static void op0xB0(void) {
-    cpu.ticks = 2;
+    cpu().ticks = 2;
 
     rel();
     bcs();
 }
 
 static void op0xB1(void) {
-    cpu.ticks = 5;
+    cpu().ticks = 5;
 
     indy_t();
     lda();
 }
 
 static void op0xB3(void) { //undocumented
-    cpu.ticks = 5;
+    cpu().ticks = 5;
 
     indy_t();
     lax();
 }
 
 static void op0xB4(void) {
-    cpu.ticks = 4;
+    cpu().ticks = 4;
 
     zpx();
     ldy();
 }
 
 static void op0xB5(void) {
-    cpu.ticks = 4;
+    cpu().ticks = 4;
 
     zpx();
     lda();
 }
 
 static void op0xB6(void) {
-    cpu.ticks = 4;
+    cpu().ticks = 4;
 
     zpy();
     ldx();
 }
 
 static void op0xB7(void) { //undocumented
-    cpu.ticks = 4;
+    cpu().ticks = 4;
 
     zpy();
     lax();
 }
 
 static void op0xB8(void) {
-    cpu.ticks = 2;
+    cpu().ticks = 2;
 
     imp();
     clv();
 }
 
 static void op0xB9(void) {
-    cpu.ticks = 4;
+    cpu().ticks = 4;
 
     absy_t();
     lda();
 }
 
 static void op0xBA(void) {
-    cpu.ticks = 2;
+    cpu().ticks = 2;
 
     imp();
     tsx();
 }
 
 static void op0xBB(void) { //undocumented
-    cpu.ticks = 4;
+    cpu().ticks = 4;
 
     absy_t();
     las();
 }
 
 static void op0xBC(void) {
-    cpu.ticks = 4;
+    cpu().ticks = 4;
 
     absx_t();
     ldy();
 }
 
 static void op0xBD(void) {
-    cpu.ticks = 4;
+    cpu().ticks = 4;
 
     absx_t();
     lda();
 }
 
 static void op0xBE(void) {
-    cpu.ticks = 4;
+    cpu().ticks = 4;
 
     absy_t();
     ldx();
 }
 
 static void op0xBF(void) { //undocumented
-    cpu.ticks = 4;
+    cpu().ticks = 4;
 
     absy_t();
     lax();
 }
 
 static void op0xC0(void) {
-    cpu.ticks = 2;
+    cpu().ticks = 2;
 
     imm();
     cpy();
 }
 
 static void op0xC1(void) {
-    cpu.ticks = 6;
+    cpu().ticks = 6;
 
     indx();
     cmp();
 }
 
 static void op0xC2(void) { //nop
-    cpu.ticks = 2;
+    cpu().ticks = 2;
 
     imm();
 }
 
 static void op0xC3(void) { //undocumented
-    cpu.ticks = 8;
+    cpu().ticks = 8;
 
     indx();
     dcp();
 }
 
 static void op0xC4(void) {
-    cpu.ticks = 3;
+    cpu().ticks = 3;
 
     zp();
     cpyZP();
 }
 
 static void op0xC5(void) {
-    cpu.ticks = 3;
+    cpu().ticks = 3;
 
     zp();
     cmpZP();
 }
 
 static void op0xC6(void) {
-    cpu.ticks = 5;
+    cpu().ticks = 5;
 
     zp();
     decZP();
 }
 
 static void op0xC7(void) { //undocumented
-    cpu.ticks = 5;
+    cpu().ticks = 5;
 
     zp();
     dcp();
 }
 
 static void op0xC8(void) {
-    cpu.ticks = 2;
+    cpu().ticks = 2;
 
     imp();
     iny();
 }
 
 static void op0xC9(void) {
-    cpu.ticks = 2;
+    cpu().ticks = 2;
 
     imm();
     cmp();
 }
 
 static void op0xCA(void) {
-    cpu.ticks = 2;
+    cpu().ticks = 2;
 
     imp();
     dex();
 }
 
 static void op0xCB(void) { //undocumented
-    cpu.ticks = 2;
+    cpu().ticks = 2;
 
     imm();
     axs();
 }
 
 static void op0xCC(void) {
-    cpu.ticks = 4;
+    cpu().ticks = 4;
 
     abso();
     cpy();
 }
 
 static void op0xCD(void) {
-    cpu.ticks = 4;
+    cpu().ticks = 4;
 
     abso();
     cmp();
 }
 
 static void op0xCE(void) {
-    cpu.ticks = 6;
+    cpu().ticks = 6;
 
     abso();
     dec();
 }
 
 static void op0xCF(void) { //undocumented
-    cpu.ticks = 6;
+    cpu().ticks = 6;
 
     abso();
     dcp();
 }
 
 static void op0xD0(void) {
-    cpu.ticks = 2;
+    cpu().ticks = 2;
 
     rel();
     bne();
+#if LOOPIDIOMS
+    if((cpu().reladdr & 0x8000) && !(cpu().cpustatus & FLAG_ZERO)) { loopIdiom(0xD0, lineCyclesLeft()); }
+#endif
 }
 
 static void op0xD1(void) {
-    cpu.ticks = 5;
+    cpu().ticks = 5;
 
     indy_t();
     cmp();
 }
 
 static void op0xD3(void) { //undocumented
-    cpu.ticks = 8;
+    cpu().ticks = 8;
 
     indy();
     dcp();
 }
 
 static void op0xD4(void) { //nop
-    cpu.ticks = 4;
+    cpu().ticks = 4;
 
     zpx();
 }
 
 static void op0xD5(void) {
-    cpu.ticks = 4;
+    cpu().ticks = 4;
 
     zpx();
     cmp();
 }
 
 static void op0xD6(void) {
-    cpu.ticks = 6;
+    cpu().ticks = 6;
 
     zpx();
     dec();
 }
 
 static void op0xD7(void) { //undocumented
-    cpu.ticks = 6;
+    cpu().ticks = 6;
 
     zpx();
     dcp();
 }
 
 static void op0xD8(void) {
-    cpu.ticks = 2;
+    cpu().ticks = 2;
 
     imp();
     cld();
 }
 
 static void op0xD9(void) {
-    cpu.ticks = 4;
+    cpu().ticks = 4;
 
     absy_t();
     cmp();
 }
 
 static void op0xDA(void) { //nop
-    cpu.ticks = 2;
+    cpu().ticks = 2;
 }
 
 static void op0xDB(void) { //undocumented
-    cpu.ticks = 7;
+    cpu().ticks = 7;
 
     absy();
     dcp();
 }
 
 static void op0xDC(void) { //nop
-    cpu.ticks = 4;
+    cpu().ticks = 4;
 
     absx_t();
 }
 
 static void op0xDD(void) {
-    cpu.ticks = 4;
+    cpu().ticks = 4;
 
     absx_t();
     cmp();
 }
 
 static void op0xDE(void) {
-    cpu.ticks = 7;
+    cpu().ticks = 7;
 
     absx();
     dec();
 }
 
 static void op0xDF(void) { //undocumented
-    cpu.ticks = 7;
+    cpu().ticks = 7;
 
     absx();
     dcp();
 }
 
 static void op0xE0(void) {
-    cpu.ticks = 2;
+    cpu().ticks = 2;
 
     imm();
     cpx();
 }
 
 static void op0xE1(void) {
-    cpu.ticks = 5;
+    cpu().ticks = 5;
 
     indx();
     sbc();
 }
 
 static void op0xE2(void) { //NOP
-    cpu.ticks = 2;
+    cpu().ticks = 2;
 
     imm();
 }
 
 static void op0xE3(void) { //undocumented
-    cpu.ticks = 8;
+    cpu().ticks = 8;
 
     indx();
     isb();
 }
 
 static void op0xE4(void) {
-    cpu.ticks = 3;
+    cpu().ticks = 3;
 
     zp();
     cpxZP();
 }
 
 static void op0xE5(void) {
-    cpu.ticks = 3;
+    cpu().ticks = 3;
 
     zp();
     sbcZP();
 }
 
 static void op0xE6(void) {
-    cpu.ticks = 5;
+    cpu().ticks = 5;
 
     zp();
     incZP();
 }
 
 static void op0xE7(void) { //undocumented
-    cpu.ticks = 5;
+    cpu().ticks = 5;
 
     zp();
     isb();
 }
 
 static void op0xE8(void) {
-    cpu.ticks = 2;
+    cpu().ticks = 2;
 
     imp();
     inx();
 }
 
 static void op0xE9(void) {
-    cpu.ticks = 2;
+    cpu().ticks = 2;
 
     imm();
     sbc();
 }
 
 static void op0xEA(void) {
-    cpu.ticks = 2;
+    cpu().ticks = 2;
 }
 
 static void op0xEB(void) {
-    cpu.ticks = 2;
+    cpu().ticks = 2;
     imm();
     sbc();
 }
 
 static void op0xEC(void) {
-    cpu.ticks = 4;
+    cpu().ticks = 4;
     abso();
     cpx();
 }
 
 static void op0xED(void) {
-    cpu.ticks = 4;
+    cpu().ticks = 4;
     abso();
     sbc();
 }
 
 static void op0xEE(void) {
-    cpu.ticks = 6;
+    cpu().ticks = 6;
     abso();
     inc();
 }
 
 static void op0xEF(void) { //undocumented
-    cpu.ticks = 6;
+    cpu().ticks = 6;
     abso();
     isb();
 }
 
 static void op0xF0(void) {
-    cpu.ticks = 2;
+    cpu().ticks = 2;
     rel();
     beq();
 }
 
 static void op0xF1(void) {
-    cpu.ticks = 5;
+    cpu().ticks = 5;
     indy_t();
     sbc();
 }
 
 static void op0xF3(void) { //undocumented
-    cpu.ticks = 8;
+    cpu().ticks = 8;
     indy();
     isb();
 }
 
 static void op0xF4(void) { //nop
-    cpu.ticks = 4;
+    cpu().ticks = 4;
     zpx();
 }
 
 static void op0xF5(void) {
-    cpu.ticks = 4;
+    cpu().ticks = 4;
 
     zpx();
     sbc();
 }
 
 static void op0xF6(void) {
-    cpu.ticks = 6;
+    cpu().ticks = 6;
 
     zpx();
     inc();
 }
 
 static void op0xF7(void) { //undocumented
-    cpu.ticks = 6;
+    cpu().ticks = 6;
 
     zpx();
     isb();
 }
 
 static void op0xF8(void) {
-    cpu.ticks = 2;
+    cpu().ticks = 2;
 
     imp();
     sed();
 }
 
 static void op0xF9(void) {
-    cpu.ticks = 4;
+    cpu().ticks = 4;
 
     absy_t();
     sbc();
 }
 
 static void op0xFA(void) { //nop
-    cpu.ticks = 2;
+    cpu().ticks = 2;
 }
 
 static void op0xFB(void) { //undocumented
-    cpu.ticks = 7;
+    cpu().ticks = 7;
 
     absy();
     isb();
 }
 
 static void op0xFC(void) { //nop
-    cpu.ticks = 4;
+    cpu().ticks = 4;
 
     absx_t();
 }
 
 static void op0xFD(void) {
-    cpu.ticks = 4;
+    cpu().ticks = 4;
 
     absx_t();
     sbc();
 }
 
 static void op0xFE(void) {
-    cpu.ticks = 7;
+    cpu().ticks = 7;
 
     absx();
     inc();
 }
 
 static void op0xFF(void) { //undocumented
-    cpu.ticks = 7;
+    cpu().ticks = 7;
 
     absx();
     isb();
@@ -2974,21 +3070,25 @@ static void opPATCHF2(void) {
 #endif
 }
 
+static void opPATCH32(void);
+static void opPATCH42(void);
+static void opPATCH52(void);
+
 using op_ptr_t = void (*)(void);
 
 static const op_ptr_t statictable[256] = {
         /*        	0   	1   	2   	3   	4   	5   	6   	7   	8	   9   		A   	B   	C   	D   	E   	F */
-        /* 0  */    op0x0, op0x1, opKIL, op0x3, op0x4, op0x5, op0x6, op0x7, op0x8, op0x9, op0xA, op0xB, op0xC, op0xD,
+        /* 0  */    op0x0, op0x1, op0x2, op0x3, op0x4, op0x5, op0x6, op0x7, op0x8, op0x9, op0xA, op0xB, op0xC, op0xD,
                     op0xE, op0xF,
         /* 1  */    op0x10, op0x11, opKIL, op0x13, op0x14, op0x15, op0x16, op0x17, op0x18, op0x19, op0x1A, op0x1B,
                     op0x1C, op0x1D, op0x1E, op0x1F,
         /* 2  */    op0x20, op0x21, opKIL, op0x23, op0x24, op0x25, op0x26, op0x27, op0x28, op0x29, op0x2A, op0x2B,
                     op0x2C, op0x2D, op0x2E, op0x2F,
-        /* 3  */    op0x30, op0x31, opKIL, op0x33, op0x34, op0x35, op0x36, op0x37, op0x38, op0x39, op0x3A, op0x3B,
+        /* 3  */    op0x30, op0x31, opPATCH32, op0x33, op0x34, op0x35, op0x36, op0x37, op0x38, op0x39, op0x3A, op0x3B,
                     op0x3C, op0x3D, op0x3E, op0x3F,
-        /* 4  */    op0x40, op0x41, opKIL, op0x43, op0x44, op0x45, op0x46, op0x47, op0x48, op0x49, op0x4A, op0x4B,
+        /* 4  */    op0x40, op0x41, opPATCH42, op0x43, op0x44, op0x45, op0x46, op0x47, op0x48, op0x49, op0x4A, op0x4B,
                     op0x4C, op0x4D, op0x4E, op0x4F,
-        /* 5  */    op0x50, op0x51, opKIL, op0x53, op0x54, op0x55, op0x56, op0x57, op0x58, op0x59, op0x5A, op0x5B,
+        /* 5  */    op0x50, op0x51, opPATCH52, op0x53, op0x54, op0x55, op0x56, op0x57, op0x58, op0x59, op0x5A, op0x5B,
                     op0x5C, op0x5D, op0x5E, op0x5F,
         /* 6  */    op0x60, op0x61, opKIL, op0x63, op0x64, op0x65, op0x66, op0x67, op0x68, op0x69, op0x6A, op0x6B,
                     op0x6C, op0x6D, op0x6E, op0x6F,
@@ -3012,6 +3112,51 @@ static const op_ptr_t statictable[256] = {
                     op0xFC, op0xFD, op0xFE, op0xFF
 };
 
+static void opPATCH32(void) {
+#if APPLY_PATCHES && PATCH_BASIC_FP
+    uint16_t address = cpu().pc - 1;
+
+    if((*cpu().plamap_r)[address >> 8] == r_bas && !monitorActive() && basicFP(address)) { return; }
+
+    //BASIC ROM not mapped in, watched by the monitor or error condition: execute the original opcode
+    statictable[basicFPOpcode(address)]();
+#else
+    opKIL();
+#endif
+}
+
+static void opPATCH42(void) {
+#if APPLY_PATCHES && PATCH_KERNAL_EDITOR
+    uint16_t address = cpu().pc - 1;
+
+    if((*cpu().plamap_r)[address >> 8] == r_ker && !monitorActive() && kernalEditor(address)) { return; }
+
+    //KERNAL ROM not mapped in, watched by the monitor or line not in RAM: execute the original opcode
+    statictable[kernalEditorOpcode(address)]();
+#else
+    opKIL();
+#endif
+}
+
+static void opPATCH52(void) {
+#if APPLY_PATCHES && PATCH_DECRUNCH
+    uint16_t address = cpu().pc - 1;
+
+    if(address != DECRUNCH_TRAP_ADDRESS) {
+        opKIL();
+        return;
+    }
+
+    //JMP ($0014) of BASIC SYS, then look for a decruncher at its target
+    op0x6C();
+
+    //KERNAL copied to RAM or page trapped by the monitor: only the jump
+    if((*cpu().plamap_r)[address >> 8] == r_ker) { decrunch(); }
+#else
+    opKIL();
+#endif
+}
+
 __attribute__((unused)) static const uint8_t cyclesTable[256] =
         {
                 7, 6, 2, 8, 3, 3, 5, 5, 3, 2, 2, 2, 4, 4, 6, 6,  // $00
@@ -3054,31 +3199,31 @@ __attribute__((unused)) static const uint8_t writeCycleTable[256] =
 
 
 void cpu_nmi() {
-    cpu.nmiLine = 1;
+    cpu().nmiLine = 1;
     Serial.println("nmiLine=1");
 }
 
 void cpu_clearNmi() {
-    cpu.nmi = 0;
+    cpu().nmi = 0;
 }
 
 void cpu_nmi_do() {
-    if(cpu.nmi) { return; }
-    cpu.nmi = 1;
-    cpu.nmiLine = 0;
-    push16(cpu.pc);
-    push8(cpu.cpustatus & ~FLAG_BREAK);
-    cpu.cpustatus |= FLAG_INTERRUPT;
-    cpu.pc = read6502(0xFFFA) | (read6502(0xFFFB) << 8);
-    cpu.ticks = 7;
+    if(cpu().nmi) { return; }
+    cpu().nmi = 1;
+    cpu().nmiLine = 0;
+    push16(cpu().pc);
+    push8(cpu().cpustatus & ~FLAG_BREAK);
+    cpu().cpustatus |= FLAG_INTERRUPT;
+    cpu().pc = read6502(0xFFFA) | (read6502(0xFFFB) << 8);
+    cpu().ticks = 7;
 }
 
 static inline void cpu_irq() {
-    push16(cpu.pc);
-    push8(cpu.cpustatus & ~FLAG_BREAK);
-    cpu.cpustatus |= FLAG_INTERRUPT;
-    cpu.pc = read6502(0xFFFE) | (read6502(0xFFFF) << 8);
-    cpu.ticks = 7;
+    push16(cpu().pc);
+    push8(cpu().cpustatus & ~FLAG_BREAK);
+    cpu().cpustatus |= FLAG_INTERRUPT;
+    cpu().pc = read6502(0xFFFE) | (read6502(0xFFFF) << 8);
+    cpu().ticks = 7;
 }
 
 inline void cia_clock()  __attribute__((always_inline));
@@ -3093,70 +3238,141 @@ void cia_clockt(int ticks) {
     cia2_clock(ticks);
 }
 
-void cpu_clock(int cycles) {
-    static int c = 0;
+//monitored: stops before instructions for the monitor, a stopped CPU keeps its cycles for later
+template<bool monitored>
+static inline void clock(int cycles) {
+    //Turbo: the CPU gets turbo cycles per C64 cycle, but not while exact timing is needed
+    unsigned turbo = cpu().exactTiming ? 1 : cpu().turbo;
 
-    cpu.lineCyclesAbs += cycles;
-    c += cycles;
+    cpu().lineCyclesAbs += cycles;
+    cpu().clockCycles += cycles * turbo;
 
-    while(c > 0) {
+    while(cpu().clockCycles > 0) {
         uint8_t opcode;
-        cpu.ticks = 0;
+        cpu().ticks = 0;
+
+        if(monitored && monitorInstruction()) { break; }
 
         //NMI
 
-        if(!cpu.nmi && ((cpu.cia2.R[CIA_ICR] & CIA_ICR_IR) | cpu.nmiLine)) {
+        if(!cpu().nmi && ((cpu().cia2.R[CIA_ICR] & CIA_ICR_IR) | cpu().nmiLine)) {
+            COUNT(nmis);
             cpu_nmi_do();
             goto nostatic;
         }
 
-        if(!(cpu.cpustatus & FLAG_INTERRUPT)) {
-            if(((cpu.vic.R[VIC_IRQST] | cpu.cia1.R[CIA_ICR]) & CIA_ICR_IR)) {
+        if(!(cpu().cpustatus & FLAG_INTERRUPT)) {
+            if(((cpu().vic.R[VIC_IRQST] | cpu().cia1.R[CIA_ICR]) & CIA_ICR_IR)) {
+                COUNT(irqs);
                 cpu_irq();
                 goto nostatic;
             }
         }
 
-        cpu.cpustatus |= FLAG_CONSTANT;
-        opcode = read6502(cpu.pc++);
+        cpu().cpustatus |= FLAG_CONSTANT;
+        opcode = read6502(cpu().pc++);
+        COUNT(opcodes[opcode]);
+        HEAT(executes, cpu().pc - 1);
+#if TRACE
+        traceInstruction(cpu().pc - 1, opcode);
+#endif
         statictable[opcode]();
         nostatic:
 
-        cia_clockt(cpu.ticks);
-        c -= cpu.ticks;
-        cpu.lineCycles += cpu.ticks;
+        if(turbo == 1) {
+            cia_clockt(cpu().ticks);
+        } else {
+            unsigned t = cpu().turboTicks + cpu().ticks;
+            cia_clockt(t / turbo);
+            cpu().turboTicks = t % turbo;
+        }
+        cpu().clockCycles -= cpu().ticks;
+        cpu().lineCycles += cpu().ticks;
+
+#if PROFILER
+        if((cpu().profilerCountdown -= cpu().ticks) <= 0) { profilerSample(); }
+#endif
 
-        if(cpu.exactTiming) {
-            uint32_t t = cpu.lineCycles * MCU_C64_RATIO;
-            while(ARM_DWT_CYCCNT - cpu.lineStartTime < t) {}
+        if(cpu().exactTiming) {
+            turbo = 1; //switched on by this instruction, see cpu_setExactTiming()
+            uint32_t t = cpu().lineCycles * MCU_C64_RATIO;
+            while(ARM_DWT_CYCCNT - cpu().lineStartTime < t) {}
         }
     }
 }
 
+void cpu_clock(int cycles) {
+    //one test per call, the loop without the monitor has no test per instruction
+    if(monitorStep()) {
+        clock<true>(cycles);
+    } else {
+        clock<false>(cycles);
+    }
+}
+
+//Runs instructions while running() returns true, without interrupts and without clocking the CIAs.
+//Returns the number of cycles, cpu().ticks is left unchanged.
+uint32_t cpu_runWhile(bool (*running)(), uint32_t maxCycles) {
+    uint16_t ticks = cpu().ticks;
+    uint32_t cycles = 0;
+
+    while(cycles < maxCycles && running()) {
+        cpu().ticks = 0;
+        cpu().cpustatus |= FLAG_CONSTANT;
+        uint8_t opcode = read6502(cpu().pc++);
+        COUNT(opcodes[opcode]);
+        HEAT(executes, cpu().pc - 1);
+        statictable[opcode]();
+        cycles += cpu().ticks;
+    }
+
+    cpu().ticks = ticks;
+    return cycles;
+}
+
 //Enable "ExactTiming" Mode
 void cpu_setExactTiming() {
-    if(!cpu.exactTiming) {
+    if(!cpu().iecBus) { return; }
+
+    if(!cpu().exactTiming) {
         //enable exact timing
         LED_ON();
         setAudioOff();
         tvic::displaySimpleModeScreen();
+
+        //the rest of the cpu_clock() call runs at 1x: drop the turbo cycles not yet spent
+        if(cpu().turbo > 1) {
+            cpu().clockCycles /= (int) cpu().turbo;
+            cpu().turboTicks = 0;
+        }
     }
-    cpu.exactTiming = 1;
-    cpu.exactTimingStartTime = ARM_DWT_CYCCNT;
+    cpu().exactTiming = 1;
+    cpu().exactTimingStartTime = ARM_DWT_CYCCNT;
 }
 
 //Disable "ExactTiming" Mode
 void cpu_disableExactTiming() {
-    cpu.exactTiming = 0;
+    cpu().exactTiming = 0;
     setAudioOn();
     LED_OFF();
 }
 
+//Set the CPU cycles per C64 cycle, VIC, CIAs and SID keep their speed
+void cpu_setTurbo(unsigned turbo) {
+    cpu().turbo = (turbo < 1) ? 1 : (turbo > TURBO_MAX) ? TURBO_MAX : turbo;
+    cpu().turboTicks = 0;
+
+    Serial.print("CPU turbo ");
+    Serial.print(cpu().turbo);
+    Serial.println("x");
+}
+
 void cpu_reset() {
     enableCycleCounter();
-    cpu.exactTiming = 0;
-    cpu.nmi = 0;
-    cpu.cpustatus = FLAG_CONSTANT;
-    cpu.pc = read6502(0xFFFC) | (read6502(0xFFFD) << 8);
-    cpu.sp = 0xFD;
+    cpu().exactTiming = 0;
+    cpu().nmi = 0;
+    cpu().clockCycles = 0;
+    cpu().cpustatus = FLAG_CONSTANT;
+    cpu().pc = read6502(0xFFFC) | (read6502(0xFFFD) << 8);
+    cpu().sp = 0xFD;
 }
\ No newline at end of file
@@ -49,6 +49,12 @@
 #include "keyboard.h"
 #include "cia1.h"
 #include "cia2.h"
+#include "decrunch.h"
+#include "profiler.h"
+#include "trace.h"
+#include "counters.h"
+#include "heatmap.h"
+#include "vic_journal.h"
 
 
 #include <reSID.h>
@@ -58,6 +64,15 @@ extern AudioOutputAnalog audioout;
 
 #define BASE_STACK     0x100
 
+#define FLAG_CARRY     0x01
+#define FLAG_ZERO      0x02
+#define FLAG_INTERRUPT 0x04
+#define FLAG_DECIMAL   0x08
+#define FLAG_BREAK     0x10
+#define FLAG_CONSTANT  0x20
+#define FLAG_OVERFLOW  0x40
+#define FLAG_SIGN      0x80
+
 struct tio {
     uint32_t gpioa;
     uint32_t gpiob;
@@ -66,9 +81,14 @@ struct tio {
     uint32_t gpioe;
 }__attribute__((packed, aligned(4)));
 
+static_assert(TURBO >= 1 && TURBO <= TURBO_MAX, "TURBO must be 1 to TURBO_MAX");
+
 struct tcpu {
     uint32_t exactTimingStartTime{};
     uint8_t exactTiming{};
+    uint8_t iecBus{1}; //0: nothing on the IEC bus, no exact timing
+    uint8_t turbo{TURBO}; //CPU cycles per C64 cycle, kept across resets
+    uint8_t turboTicks{}; //CPU cycles not yet seen by the CIAs
 
     //6502 CPU registers
     uint8_t sp{};
@@ -85,6 +105,7 @@ struct tcpu {
 
     uint16_t lineCyclesAbs{}; //for debug
     uint16_t ticks{};
+    int clockCycles{}; //cycles left of the current cpu_clock() call
     unsigned lineCycles{};
     unsigned long lineStartTime{};
 
@@ -98,22 +119,75 @@ struct tcpu {
     tvic vic;
     tcia cia1{};
     tcia cia2{};
+    uint8_t sid[0x20]{}; //registers written to the SID, most of them can't be read back
+    AudioPlaySID *sidChip{&playSID}; //the SID that plays them, nullptr: no SID
+
+    uint16_t rtcLines{1}; //raster lines until the next check of the CIA TOD alarms
+    uint32_t bootCycles{}; //FASTBOOT 1: cycles of the KERNAL boot still to run, see machine.h
+    tdecrunchRun decrunch{}; //fast run of a decruncher, see decrunch.h
+#if MONITOR
+    struct {
+        bool active; //a client watches the CPU, see monitor.h
+        bool step;
+        bool traps;
+    } monitor{};
+#endif
+#if PROFILER
+    int profilerCountdown{PROFILER_INTERVAL}; //cycles until the next sample, see profiler.h
+#endif
+#if MACHINES > 1
+    struct tliveView *liveView{}; //shared memory of the machine, nullptr: none, see live_view.h
+#endif
 
     uint8_t RAM[1 << 16]{};
 
     uint8_t cartrigeLO[1]{}; //TODO
     uint8_t cartrigeHI[1]{}; //TODO
+
+    //instrumentation builds
+#if PROFILER
+    tprofile profile{};
+#endif
+#if TRACE
+    ttrace trace{};
+#endif
+#if COUNTERS
+    tcounters counters{};
+#endif
+#if HEATMAP
+    theatmaps heatmap{};
+#endif
+#if VIC_JOURNAL
+    tvicJournals vicJournal{};
+#endif
 };
 
 extern struct tio io;
-extern struct tcpu cpu;
+
+#if MACHINES > 1
+//The machine bound to the current thread, see machine.h. __thread: no TLS wrapper call per access.
+extern __thread struct tcpu *machine;
+#else
+extern struct tcpu c64; //the one machine of the firmware
+#endif
+
+//The machine the core works on
+static inline __attribute__((always_inline)) struct tcpu &cpu() {
+#if MACHINES > 1
+    return *machine;
+#else
+    return c64;
+#endif
+}
 
 void cpu_reset();
 void cpu_nmi();
 void cpu_clearNmi();
 void cpu_clock(int cycles);
+uint32_t cpu_runWhile(bool (*running)(), uint32_t maxCycles);
 void cpu_setExactTiming();
 void cpu_disableExactTiming();
+void cpu_setTurbo(unsigned turbo);
 void cia_clockt(int ticks);
 
 #endif // TEENSY64_CPU_H
\ No newline at end of file
@@ -0,0 +1,129 @@
+/*
+	Copyright Frank Bösing, Karsten Fleischer, 2026
+
+	This file is part of Teensy64.
+
+    Teensy64 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Teensy64 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Teensy64.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von Teensy64.
+
+    Teensy64 ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Teensy64 wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+*/
+
+#include "teensy64.h"
+#include "decrunch.h"
+#include "monitor.h"
+
+namespace {
+
+struct tdecruncher {
+    const char *name;
+    const char *signature; //code at the SYS target, "??" for bytes that depend on the packed program
+};
+
+//Families of crunchers, the signature covers only the code from the SYS target on.
+//The stubs copy the decruncher to the zero page, the stack and/or $0334 and jump there.
+//Only stubs checked against a packed program are listed, each with its test program in
+//examples/SDCARD/C64 (make check in extras/Host runs them):
+//  Exomizer SFX    Radwar.prg
+//Other crunchers (Exomizer mem/level, ByteBoozer, PuCrunch, ...) run normally until a
+//signature is added together with a program packed by them.
+const tdecruncher decrunchers[] = {
+        {"Exomizer SFX",
+                "A0 ?? 78 E6 01 BA BD ?? ?? 9D FC 00 CA D0 F7 4C ?? ??"},
+};
+
+inline uint8_t read6502(uint16_t address) {
+    return (*cpu().plamap_r)[address >> 8](address);
+}
+
+inline uint8_t hexDigit(char c) {
+    return c <= '9' ? c - '0' : c - 'A' + 10;
+}
+
+bool matches(const char *signature, uint16_t address) {
+    for(const char *s = signature;; s += 3, address++) {
+        if(s[0] != '?' && read6502(address) != (hexDigit(s[0]) << 4 | hexDigit(s[1]))) { return false; }
+        if(!s[2]) { return true; }
+    }
+}
+
+//The stubs start with SEI, the decruncher is done when it enables interrupts again
+bool decrunching() {
+    if(cpu().cpustatus & FLAG_INTERRUPT) {
+        cpu().decrunch.seenSei = true;
+        return true;
+    }
+
+    return !cpu().decrunch.seenSei;
+}
+
+//Runs the decruncher for DECRUNCH_LOAD percent of a raster line period, in steps of
+//CHUNK cycles between which the MCU cycle counter is checked
+void slice() {
+    static const uint32_t timeSlice = F_CPU / LINEFREQ * DECRUNCH_LOAD / 100;
+    const uint32_t CHUNK = 64;
+    uint32_t sliceStart = ARM_DWT_CYCCNT;
+
+    do {
+        cpu().decrunch.cycles += cpu_runWhile(decrunching, min(CHUNK, DECRUNCH_MAXCYCLES - cpu().decrunch.cycles));
+        if(!decrunching() || cpu().decrunch.cycles >= DECRUNCH_MAXCYCLES) { break; }
+    } while(ARM_DWT_CYCCNT - sliceStart < timeSlice);
+
+    if(decrunching() && cpu().decrunch.cycles < DECRUNCH_MAXCYCLES) { return; }
+
+    Serial.printf("Decrunched %s, cycles skipped: %u\n", decrunchers[cpu().decrunch.decruncher - 1].name, (unsigned) cpu().decrunch.cycles);
+    cpu().decrunch.decruncher = 0;
+}
+}
+
+bool decrunch() {
+    //already running (SYS in the decruncher), the monitor sees each instruction
+    if(cpu().decrunch.decruncher || monitorActive()) { return false; }
+
+    for(unsigned i = 0; i < sizeof(decrunchers) / sizeof(decrunchers[0]); i++) {
+        if(matches(decrunchers[i].signature, cpu().pc)) {
+            cpu().decrunch.decruncher = i + 1;
+            cpu().decrunch.cycles = 0;
+            cpu().decrunch.seenSei = false;
+            slice();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void decrunchLine() {
+    if(!cpu().decrunch.decruncher) { return; }
+
+    if(monitorActive()) {
+        cpu().decrunch.decruncher = 0;
+        return;
+    }
+
+    slice();
+}
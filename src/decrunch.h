@@ -0,0 +1,75 @@
+/*
+	Copyright Frank Bösing, Karsten Fleischer, 2026
+
+	This file is part of Teensy64.
+
+    Teensy64 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Teensy64 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Teensy64.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von Teensy64.
+
+    Teensy64 ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Teensy64 wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+*/
+
+#pragma once
+
+#ifndef TEENSY64_DECRUNCH_H
+#define TEENSY64_DECRUNCH_H
+
+#include <cstdint>
+
+/*
+  Fast decrunching of packed programs.
+
+  The JMP ($0014) at the end of BASIC SYS ($E144) is patched with DECRUNCH_TRAP_OPCODE.
+  After the jump, the code at the SYS target is compared with the signatures of known
+  decruncher stubs. On a match, the decruncher's own code runs in a tight loop without
+  VIC, CIAs, SID and pacing until it clears the interrupt flag again, which all known
+  decrunchers do right before they jump to the unpacked program.
+  The loop runs at the SYS and at the start of each following raster line, for
+  DECRUNCH_LOAD percent of the line period as measured with the MCU cycle counter. The line
+  itself runs normally in the remaining time, so the display, sound and input keep going.
+  RAM and registers end up exactly as after a normal run, only the emulated time
+  spent for decrunching is skipped. A decruncher that waits for the VIC or a CIA gets
+  there in the normal lines, after DECRUNCH_MAXCYCLES the fast run ends.
+*/
+
+#define DECRUNCH_TRAP_OPCODE 0x52
+#define DECRUNCH_TRAP_ADDRESS 0xE144
+
+//The fast run of a machine, cpu().decrunch
+struct tdecrunchRun {
+    uint32_t cycles;    //skipped so far
+    uint8_t decruncher; //0: no fast run, else index + 1
+    uint8_t seenSei;
+};
+
+// Called after the jump of SYS, starts the fast run of a known decruncher at cpu().pc, returns false if none was found.
+bool decrunch();
+
+// Called at the start of each raster line, continues a fast run.
+void decrunchLine();
+
+#endif // TEENSY64_DECRUNCH_H
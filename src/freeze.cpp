@@ -0,0 +1,207 @@
+/*
+	Copyright Frank Bösing, Karsten Fleischer, 2026
+
+	This file is part of Teensy64.
+
+    Teensy64 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Teensy64 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Teensy64.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von Teensy64.
+
+    Teensy64 ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Teensy64 wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+*/
+
+#include <cstring>
+#include "teensy64.h"
+#include "patches.h"
+#include "machine_state.h"
+#include "freeze.h"
+
+namespace {
+
+const char FREEZE_MAGIC[6] = {'T', '6', '4', 'F', 'R', 'Z'};
+const uint16_t FREEZE_VERSION = 3;
+const uint32_t CHUNK = 4096; //bytes written or read per line clock tick
+
+struct tfreezeHeader {
+    char magic[6];
+    uint16_t version;
+    uint8_t pal;
+    uint8_t reserved[3];
+    uint32_t stateSize; //sizeof(tmachineState), followed by the colour RAM and the 64 KB RAM
+};
+
+enum tfreezeRequest : uint8_t {
+    REQUEST_NONE, REQUEST_FREEZE, REQUEST_RESUME
+};
+
+volatile tfreezeRequest request = REQUEST_NONE;
+
+tmachineState state;
+FsFile file;
+
+//The file after the header, written or read CHUNK bytes per tick while the machine waits
+struct {
+    tfreezeRequest op; //REQUEST_NONE: no transfer
+    unsigned part;
+    uint32_t offset;
+    uint32_t startTime;
+} transfer;
+
+const unsigned PARTS = 3;
+
+uint8_t *partData(unsigned part) {
+    return part == 0 ? (uint8_t *) &state : part == 1 ? cpu().vic.colorRAM : cpu().RAM;
+}
+
+uint32_t partSize(unsigned part) {
+    return part == 0 ? sizeof(state) : part == 1 ? sizeof(cpu().vic.colorRAM) : sizeof(cpu().RAM);
+}
+
+void startTransfer(tfreezeRequest op) {
+    transfer.op = op;
+    transfer.part = 0;
+    transfer.offset = 0;
+}
+
+bool startFreeze() {
+    if(!SDinitialized) {
+        Serial.println("SD Card not initialized");
+        return false;
+    }
+
+    transfer.startTime = millis();
+    tfreezeHeader header{};
+
+    memcpy(header.magic, FREEZE_MAGIC, sizeof(header.magic));
+    header.version = FREEZE_VERSION;
+    header.pal = PAL;
+    header.stateSize = sizeof(state);
+    machineStateSave(state);
+
+    if(SD.exists(FREEZE_FILE)) { SD.remove(FREEZE_FILE); }
+    file = SD.open(FREEZE_FILE, FILE_WRITE);
+    if(!file || file.write(&header, sizeof(header)) != sizeof(header)) {
+        Serial.printf("Freeze: could not create %s\n", FREEZE_FILE);
+        file.close();
+        return false;
+    }
+
+    startTransfer(REQUEST_FREEZE);
+    return true;
+}
+
+bool startResume() {
+    if(!SDinitialized) {
+        Serial.println("SD Card not initialized");
+        return false;
+    }
+
+    transfer.startTime = millis();
+    tfreezeHeader header;
+
+    file = SD.open(FREEZE_FILE, FILE_READ);
+    if(!file) {
+        Serial.printf("Freeze: %s not found\n", FREEZE_FILE);
+        return false;
+    }
+
+    if(file.size() != sizeof(header) + sizeof(state) + sizeof(cpu().vic.colorRAM) + sizeof(cpu().RAM)
+       || file.read(&header, sizeof(header)) != sizeof(header)
+       || memcmp(header.magic, FREEZE_MAGIC, sizeof(header.magic)) != 0
+       || header.version != FREEZE_VERSION || header.pal != PAL || header.stateSize != sizeof(state)) {
+        file.close();
+        Serial.printf("Freeze: %s has a wrong format or version\n", FREEZE_FILE);
+        return false;
+    }
+
+    startTransfer(REQUEST_RESUME);
+    return true;
+}
+
+void finishTransfer(bool ok) {
+    bool resume = transfer.op == REQUEST_RESUME;
+
+    file.close();
+    transfer.op = REQUEST_NONE;
+
+    if(resume && !ok) {
+        //RAM may be partially overwritten, a reset is the only safe state
+        Serial.printf("Freeze: reading %s failed\n", FREEZE_FILE);
+        resetMachine();
+        return;
+    }
+
+    if(resume) { machineStateLoad(state); }
+
+    Serial.printf("Freeze %s %s (%u ms)\n", FREEZE_FILE, resume ? "resumed" : ok ? "saved" : "failed",
+                  (unsigned) (millis() - transfer.startTime));
+}
+
+//The next chunk of the file
+void transferStep() {
+    uint8_t *p = partData(transfer.part) + transfer.offset;
+    uint32_t n = min(CHUNK, partSize(transfer.part) - transfer.offset);
+    bool ok = (transfer.op == REQUEST_FREEZE) ? file.write(p, n) == n : file.read(p, n) == (int) n;
+
+    if(!ok) {
+        finishTransfer(false);
+        return;
+    }
+
+    transfer.offset += n;
+    if(transfer.offset == partSize(transfer.part)) {
+        transfer.offset = 0;
+        if(++transfer.part == PARTS) { finishTransfer(true); }
+    }
+}
+
+}
+
+void freezeRequest() {
+    request = REQUEST_FREEZE;
+}
+
+void resumeRequest() {
+    request = REQUEST_RESUME;
+}
+
+bool freezeBusy() {
+    return transfer.op != REQUEST_NONE;
+}
+
+bool freezePoll() {
+    if(freezeBusy()) {
+        transferStep();
+        return true;
+    }
+
+    if(request == REQUEST_NONE) { return false; }
+
+    tfreezeRequest r = request;
+    request = REQUEST_NONE;
+
+    return (r == REQUEST_FREEZE) ? startFreeze() : startResume();
+}
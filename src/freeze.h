@@ -0,0 +1,65 @@
+/*
+	Copyright Frank Bösing, Karsten Fleischer, 2026
+
+	This file is part of Teensy64.
+
+    Teensy64 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Teensy64 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Teensy64.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von Teensy64.
+
+    Teensy64 ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Teensy64 wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+*/
+
+#pragma once
+
+#ifndef TEENSY64_FREEZE_H
+#define TEENSY64_FREEZE_H
+
+/*
+  Freezing the machine to a file on the SD card and resuming it later.
+
+  The file holds the CPU registers, RAM, colour RAM, VIC, CIAs (including timer latches
+  and TOD), the SID registers and the memory configuration in a versioned binary format.
+  The internal state of the SID (oscillators, envelopes) can't be read from reSID, the
+  voices restart from the restored registers. The state of external IEC devices is not saved.
+
+  Freeze is Ctrl+Alt+S, resume is Ctrl+Alt+L, both use FREEZE_FILE. The line clock
+  interrupt opens the file in one tick, then writes or reads it in chunks of up to 4 KB,
+  one per tick, 19 ticks for the 66 KB, while the machine waits. The time an SD card takes for a chunk has not been
+  measured yet, the total is printed with the result.
+*/
+
+void freezeRequest();
+void resumeRequest();
+
+// Called by the line clock interrupt between two raster lines. True while the file is
+// being written or read, then the machine has to wait.
+bool freezePoll();
+
+// A freeze or resume is in progress.
+bool freezeBusy();
+
+#endif // TEENSY64_FREEZE_H
@@ -0,0 +1,125 @@
+/*
+	Copyright Frank Bösing, Karsten Fleischer, 2026
+
+	This file is part of Teensy64.
+
+    Teensy64 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Teensy64 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Teensy64.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von Teensy64.
+
+    Teensy64 ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Teensy64 wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+*/
+
+#include <cmath>
+#include <cstring>
+#include "settings.h"
+
+#if HEATMAP
+
+#include "teensy64.h"
+#include "pla.h"
+#include "heatmap.h"
+
+namespace {
+
+volatile bool request = false;
+
+uint32_t largest(const uint32_t *counts) {
+    uint32_t m = 0;
+
+    for(unsigned i = 0; i < HEATMAP_ENTRIES; i++) { m = max(m, counts[i]); }
+
+    return m;
+}
+
+uint8_t scale(uint32_t count, uint32_t largest) {
+    if(count == 0) { return 0; }
+
+    return 32 + (uint8_t) (223.0f * logf(count) / logf(largest + 1));
+}
+
+//What the CPU reads in the page
+const char *mapping(uint8_t page) {
+    r_ptr_t r = (*cpu().plamap_r)[page];
+
+    if(r == r_ram) { return "RAM"; }
+    if(r == r_bas) { return "BASIC"; }
+    if(r == r_ker) { return "KERNAL"; }
+    if(r == r_chr) { return "CHAR"; }
+
+    return "I/O";
+}
+
+}
+
+void heatmapReset() {
+    memset(&cpu().heatmap, 0, sizeof(cpu().heatmap));
+}
+
+void heatmapFrame() {
+    theatmaps &heatmap = cpu().heatmap;
+
+    if(++heatmap.current.frames < HEATMAP_FRAMES) { return; }
+
+    heatmap.window = heatmap.current;
+    heatmap.maxReads = largest(heatmap.window.reads);
+    heatmap.maxWrites = largest(heatmap.window.writes);
+    heatmap.maxExecutes = largest(heatmap.window.executes);
+    memset(&heatmap.current, 0, sizeof(heatmap.current));
+}
+
+void heatmapColor(unsigned entry, uint8_t rgb[3]) {
+    const theatmaps &heatmap = cpu().heatmap;
+
+    rgb[0] = scale(heatmap.window.writes[entry], heatmap.maxWrites);
+    rgb[1] = scale(heatmap.window.reads[entry], heatmap.maxReads);
+    rgb[2] = scale(heatmap.window.executes[entry], heatmap.maxExecutes);
+}
+
+void heatmapRequest() {
+    request = true;
+}
+
+void heatmapPoll() {
+    if(!request) { return; }
+
+    const theatmap &window = cpu().heatmap.window;
+
+    request = false;
+    Serial.printf("Heatmap: %u frames, %u bytes per entry\n", (unsigned) window.frames, 1u << HEATMAP_SHIFT);
+    Serial.printf("addr  map        reads    writes  executes\n");
+
+    for(unsigned i = 0; i < HEATMAP_ENTRIES; i++) {
+        if(!(window.reads[i] | window.writes[i] | window.executes[i])) { continue; }
+
+        uint16_t address = i << HEATMAP_SHIFT;
+
+        Serial.printf("$%04X %-6s %9u %9u %9u\n", address, mapping(address >> 8), (unsigned) window.reads[i],
+                      (unsigned) window.writes[i], (unsigned) window.executes[i]);
+    }
+}
+
+#endif
@@ -0,0 +1,96 @@
+/*
+	Copyright Frank Bösing, Karsten Fleischer, 2026
+
+	This file is part of Teensy64.
+
+    Teensy64 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Teensy64 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Teensy64.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von Teensy64.
+
+    Teensy64 ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Teensy64 wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+*/
+
+#pragma once
+
+#ifndef TEENSY64_HEATMAP_H
+#define TEENSY64_HEATMAP_H
+
+#include <cstdint>
+#include "settings.h"
+
+/*
+  Memory access heatmap, an instrumentation build with HEATMAP 1: reads, writes and
+  executed instructions of the CPU per 2^HEATMAP_SHIFT bytes (a page by default).
+
+    - reads: all reads of the CPU, the opcode and operand fetches and the stack included
+    - writes: all writes of the CPU, the stack included
+    - executes: the instructions that start in the entry
+
+  The counts are collected over a window of HEATMAP_FRAMES frames, the last complete
+  window is kept. Ctrl+Alt+H prints it on Serial, one line per entry that was touched,
+  with the current read mapping of the page: the pages with many accesses to I/O are the
+  ones that go through the device handlers. The batch runner draws it into an image next
+  to the screenshot of each program (see heatmapColor()).
+  Only the CPU is counted, not the VIC. The native replacements of ROM routines and the
+  loop idioms run without the interpreter, their accesses are not counted.
+*/
+
+#if HEATMAP
+const unsigned HEATMAP_ENTRIES = 0x10000 >> HEATMAP_SHIFT;
+
+struct theatmap {
+    uint32_t frames;
+    uint32_t reads[HEATMAP_ENTRIES];
+    uint32_t writes[HEATMAP_ENTRIES];
+    uint32_t executes[HEATMAP_ENTRIES];
+};
+
+// The heatmap of a machine, cpu().heatmap.
+struct theatmaps {
+    theatmap current; //the window being counted
+    theatmap window;  //the last complete window
+    uint32_t maxReads, maxWrites, maxExecutes; //largest counts of the window, the scale of heatmapColor()
+};
+
+#define HEAT(counts, address) (cpu().heatmap.current.counts[(uint16_t) (address) >> HEATMAP_SHIFT]++)
+
+void heatmapReset();
+
+// Called at the start of each frame, ends the window after HEATMAP_FRAMES frames.
+void heatmapFrame();
+
+// Colour of an entry of the last window, log scaled: red writes, green reads, blue executes.
+void heatmapColor(unsigned entry, uint8_t rgb[3]);
+
+void heatmapRequest();
+
+// Called by the line clock interrupt between two raster lines.
+void heatmapPoll();
+#else
+#define HEAT(counts, address)
+#endif
+
+#endif // TEENSY64_HEATMAP_H
@@ -0,0 +1,394 @@
+/*
+	Copyright Frank Bösing, Karsten Fleischer, 2026
+
+	This file is part of Teensy64.
+
+    Teensy64 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Teensy64 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Teensy64.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von Teensy64.
+
+    Teensy64 ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Teensy64 wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+*/
+
+#include <cstring>
+#include "teensy64.h"
+#include "patches.h"
+#include "keyboard.h"
+#include "input.h"
+
+tinput inputState;
+
+namespace {
+
+const char INPUT_MAGIC[6] = {'T', '6', '4', 'I', 'N', 'P'};
+const uint16_t INPUT_VERSION = 2;
+const unsigned EVENT_BUFFER = 64;
+
+struct tinputHeader {
+    char magic[6];
+    uint16_t version;
+    uint8_t pal;
+    uint8_t reserved[3];
+};
+
+enum tinputType : uint8_t {
+    EVENT_KEYBOARD,     //value: tinput.kv
+    EVENT_JOYSTICKS,    //value: joyA | joyB << 8
+    EVENT_KEY,          //value: character put into the keyboard buffer
+    EVENT_NMI,
+    EVENT_RESET,
+    EVENT_TURBO,        //value: CPU cycles per C64 cycle
+    EVENT_HASH,         //value: machineHash() before the line, every INPUT_HASH_FRAMES frames
+    EVENT_END
+};
+
+struct tinputEvent {
+    uint64_t cycle;
+    uint32_t value;
+    tinputType type;
+    uint8_t reserved[3];
+};
+
+enum tinputMode : uint8_t {
+    MODE_OFF, MODE_RECORD, MODE_REPLAY
+};
+
+enum tinputRequest : uint8_t {
+    REQUEST_NONE, REQUEST_RECORD, REQUEST_REPLAY
+};
+
+volatile tinputRequest request = REQUEST_NONE;
+tinputMode mode = MODE_OFF;
+
+//Inputs that change the machine, set by the USB interrupt or the main loop
+volatile char pendingKey = 0;
+volatile bool pendingNMI = false;
+volatile bool pendingReset = false;
+volatile uint8_t pendingTurbo = 0;
+
+uint64_t cycle;
+uint32_t startTime;
+uint32_t hashLines;     //record: lines until the next hash
+uint32_t hashes;        //replay: hashes compared
+uint32_t divergence;    //replay: first frame that differs from the recording, 0: none
+
+tinputEvent events[EVENT_BUFFER];
+unsigned eventCount;  //record: events in the buffer, replay: events read into the buffer
+unsigned eventIndex;  //replay: next event
+FsFile file;
+
+uint32_t frame() {
+    return cycle / (CYCLESPERRASTERLINE * LINECNT);
+}
+
+//Hash (FNV-1a) of RAM, colour RAM and the CPU registers, the RAM 32 bits at a time
+uint32_t machineHash() {
+    const uint8_t registers[] = {(uint8_t) cpu().pc, (uint8_t) (cpu().pc >> 8), cpu().a, cpu().x, cpu().y,
+                                 cpu().sp, cpu().cpustatus};
+    uint32_t h = 2166136261u;
+
+    for(unsigned i = 0; i < sizeof(cpu().RAM); i += 4) {
+        uint32_t w;
+
+        memcpy(&w, &cpu().RAM[i], sizeof(w)); //the RAM may be unaligned
+        h = (h ^ w) * 16777619u;
+    }
+    for(uint8_t c : cpu().vic.colorRAM) { h = (h ^ c) * 16777619u; }
+    for(uint8_t r : registers) { h = (h ^ r) * 16777619u; }
+
+    return h;
+}
+
+bool flush() {
+    size_t size = eventCount * sizeof(tinputEvent);
+    bool ok = file.write(events, size) == size;
+
+    eventCount = 0;
+    return ok;
+}
+
+void stop() {
+    if(mode == MODE_RECORD) {
+        events[eventCount++] = {cycle, 0, EVENT_END, {}};
+        flush();
+        Serial.printf("Input recorded to %s, %u frames\n", INPUT_FILE, (unsigned) frame());
+    } else if(mode == MODE_REPLAY) {
+        uint32_t t = millis() - startTime;
+        uint32_t frames = frame();
+
+        Serial.printf("Replay of %s finished, %u frames in %u ms (%.1f fps)\n", INPUT_FILE,
+                      (unsigned) frames, (unsigned) t, t ? frames * 1000.0f / t : 0.0f);
+        if(divergence) {
+            Serial.printf("Replay diverged from the recording at frame %u\n", (unsigned) divergence);
+        } else {
+            Serial.printf("Replay matches the recording, %u hashes compared\n", (unsigned) hashes);
+        }
+    }
+
+    file.close();
+    mode = MODE_OFF;
+}
+
+void record(tinputType type, uint32_t value) {
+    if(mode != MODE_RECORD) { return; }
+
+    events[eventCount++] = {cycle, value, type, {}};
+
+    if(eventCount == EVENT_BUFFER && !flush()) {
+        Serial.println("Input: write error, recording stopped");
+        stop();
+    }
+}
+
+bool start(tinputMode m) {
+    if(!SDinitialized) {
+        Serial.println("SD Card not initialized");
+        return false;
+    }
+
+    tinputHeader header{};
+
+    if(m == MODE_RECORD) {
+        memcpy(header.magic, INPUT_MAGIC, sizeof(header.magic));
+        header.version = INPUT_VERSION;
+        header.pal = PAL;
+
+        if(SD.exists(INPUT_FILE)) { SD.remove(INPUT_FILE); }
+        file = SD.open(INPUT_FILE, FILE_WRITE);
+        if(!file || file.write(&header, sizeof(header)) != sizeof(header)) {
+            Serial.printf("Input: could not create %s\n", INPUT_FILE);
+            file.close();
+            return false;
+        }
+    } else {
+        file = SD.open(INPUT_FILE, FILE_READ);
+        if(!file || file.read(&header, sizeof(header)) != sizeof(header)
+           || memcmp(header.magic, INPUT_MAGIC, sizeof(header.magic)) != 0
+           || header.version != INPUT_VERSION || header.pal != PAL) {
+            Serial.printf("Input: %s not found or wrong format\n", INPUT_FILE);
+            file.close();
+            return false;
+        }
+    }
+
+    mode = m;
+    cycle = 0;
+    eventCount = 0;
+    eventIndex = 0;
+    startTime = millis();
+    hashLines = INPUT_HASH_FRAMES * LINECNT;
+    hashes = 0;
+    divergence = 0;
+
+    //Record and replay both start from the same state, and with no keys pressed
+    memset(&inputState, 0, sizeof(inputState));
+    pendingKey = 0;
+    pendingNMI = false;
+    pendingTurbo = cpu().turbo; //recorded, a reset keeps the turbo
+    pendingReset = true;
+
+    Serial.printf("Input %s %s\n", (m == MODE_RECORD) ? "recording to" : "replaying", INPUT_FILE);
+    return true;
+}
+
+//Next recorded event, nullptr at the end of the file
+const tinputEvent *nextEvent() {
+    if(eventIndex == eventCount) {
+        eventCount = file.read(events, sizeof(events)) / sizeof(tinputEvent);
+        eventIndex = 0;
+        if(eventCount == 0) { return nullptr; }
+    }
+
+    return &events[eventIndex];
+}
+
+void apply(tinputType type, uint32_t value) {
+    switch(type) {
+        case EVENT_KEYBOARD:
+            inputState.kv = value;
+            break;
+        case EVENT_JOYSTICKS:
+            inputState.joyA = value & 0xFF;
+            inputState.joyB = value >> 8;
+            break;
+        case EVENT_KEY:
+            cpu().RAM[631] = value;
+            cpu().RAM[198] = 1;
+            break;
+        case EVENT_NMI:
+            cpu_nmi();
+            break;
+        case EVENT_RESET:
+            resetMachine();
+            break;
+        case EVENT_TURBO:
+            cpu_setTurbo(value);
+            break;
+        case EVENT_HASH:
+            hashes++;
+            if(divergence == 0 && value != machineHash()) {
+                divergence = frame();
+                Serial.printf("Replay diverges from the recording at frame %u\n", (unsigned) divergence);
+            }
+            break;
+        case EVENT_END:
+            break;
+    }
+}
+
+void replayLine() {
+    const tinputEvent *e;
+
+    while((e = nextEvent()) != nullptr && e->cycle <= cycle) {
+        eventIndex++;
+
+        if(e->type == EVENT_END) {
+            stop();
+            return;
+        }
+
+        apply(e->type, e->value);
+    }
+
+    if(e == nullptr) {
+        Serial.println("Input: replay file ends without end marker");
+        stop();
+    }
+}
+
+void liveLine() {
+    tinput live;
+
+    sampleInput(live);
+
+    //first, a replay compares it before it applies the events of the same cycle
+    if(INPUT_HASH_FRAMES && mode == MODE_RECORD && --hashLines == 0) {
+        hashLines = INPUT_HASH_FRAMES * LINECNT;
+        record(EVENT_HASH, machineHash());
+    }
+
+    if(live.kv != inputState.kv) {
+        record(EVENT_KEYBOARD, live.kv);
+        apply(EVENT_KEYBOARD, live.kv);
+    }
+
+    if(live.joyA != inputState.joyA || live.joyB != inputState.joyB) {
+        record(EVENT_JOYSTICKS, live.joyA | (live.joyB << 8));
+        apply(EVENT_JOYSTICKS, live.joyA | (live.joyB << 8));
+    }
+
+    //The key waits until the keyboard buffer is empty
+    if(pendingKey != 0 && cpu().RAM[198] == 0) {
+        record(EVENT_KEY, (uint8_t) pendingKey);
+        apply(EVENT_KEY, (uint8_t) pendingKey);
+        pendingKey = 0;
+    }
+
+    if(pendingNMI) {
+        pendingNMI = false;
+        record(EVENT_NMI, 0);
+        apply(EVENT_NMI, 0);
+    }
+
+    if(pendingTurbo != 0) {
+        uint8_t turbo = pendingTurbo;
+        pendingTurbo = 0;
+        record(EVENT_TURBO, turbo);
+        apply(EVENT_TURBO, turbo);
+    }
+
+    if(pendingReset) {
+        pendingReset = false;
+        record(EVENT_RESET, 0);
+        apply(EVENT_RESET, 0);
+    }
+}
+
+}
+
+bool inputKey(char key) {
+    if(pendingKey != 0) { return false; }
+
+    pendingKey = key;
+    return true;
+}
+
+void inputNMI() {
+    pendingNMI = true;
+}
+
+void inputReset() {
+    pendingReset = true;
+}
+
+void inputTurbo(unsigned turbo) {
+    pendingTurbo = turbo;
+}
+
+void inputRecordToggle() {
+    request = REQUEST_RECORD;
+}
+
+void inputReplayToggle() {
+    request = REQUEST_REPLAY;
+}
+
+uint32_t inputDivergence() {
+    return divergence;
+}
+
+void inputPoll() {
+    if(request == REQUEST_NONE) { return; }
+
+    tinputRequest r = request;
+    request = REQUEST_NONE;
+
+    tinputMode m = (r == REQUEST_RECORD) ? MODE_RECORD : MODE_REPLAY;
+
+    if(mode == m) {
+        stop();
+        return;
+    }
+
+    if(mode != MODE_OFF) { stop(); }
+
+    start(m);
+}
+
+void inputLine() {
+    if(mode == MODE_REPLAY) {
+        //Live inputs are dropped, except the hotkeys of the emulator itself
+        pendingKey = 0;
+        pendingNMI = false;
+        pendingReset = false;
+        pendingTurbo = 0;
+        replayLine();
+    } else {
+        liveLine();
+    }
+
+    cycle += CYCLESPERRASTERLINE;
+}
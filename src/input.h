@@ -0,0 +1,97 @@
+/*
+	Copyright Frank Bösing, Karsten Fleischer, 2026
+
+	This file is part of Teensy64.
+
+    Teensy64 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Teensy64 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Teensy64.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von Teensy64.
+
+    Teensy64 ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Teensy64 wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+*/
+
+#pragma once
+
+#ifndef TEENSY64_INPUT_H
+#define TEENSY64_INPUT_H
+
+#include <cstdint>
+
+/*
+  Input of the emulated machine, taken over at the start of each raster line.
+
+  The USB keyboard and the joystick pins change at any time. The CIA ports only see the
+  state latched by inputLine(), and the inputs that change the machine directly (keys put
+  into the keyboard buffer, RESTORE, reset and CPU turbo) wait for the next line as well.
+  So every input change happens at a known emulated cycle.
+
+  Ctrl+Alt+I records all input changes with their cycle to INPUT_FILE, Ctrl+Alt+P replays
+  it, pressing them again stops. Both start with a reset of the machine, at the CPU turbo of
+  the recording. The replay ignores the live input and prints the time it took at the end,
+  for use as a benchmark.
+  A replay only follows the recording as long as the program does not depend on the host
+  clock: the TOD of the CIAs, the SID oscillators read back from reSID and the duration of
+  the exact timing mode after IEC activity are not recorded, neither are freeze, resume,
+  rewind and the reset pin. So the recording has a hash of RAM, colour RAM and the CPU
+  registers every INPUT_HASH_FRAMES frames, one pass over the RAM in the line clock
+  interrupt. The replay compares them and prints the first frame that differs.
+*/
+
+struct tinput {
+    union {
+        uint32_t kv;
+        struct {
+            uint8_t ke,   //modifier keys
+            kdummy,
+            k,            //first key
+            k2;           //second key
+        };
+    };
+    uint8_t joyA;         //bits of CIA1 port A pulled low by a joystick
+    uint8_t joyB;         //bits of CIA1 port B pulled low by a joystick
+};
+
+extern tinput inputState;
+
+// Put a key into the keyboard buffer, false while the previous one is still pending.
+bool inputKey(char key);
+void inputNMI();
+void inputReset();
+void inputTurbo(unsigned turbo);
+
+void inputRecordToggle();
+void inputReplayToggle();
+
+// Replay: the first frame that differed from the recording, 0: none so far.
+uint32_t inputDivergence();
+
+// Called by the line clock interrupt between two raster lines.
+void inputPoll();
+
+// Called by the line clock interrupt before each raster line.
+void inputLine();
+
+#endif // TEENSY64_INPUT_H
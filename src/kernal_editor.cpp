@@ -0,0 +1,267 @@
+/*
+	Copyright Frank Bösing, Karsten Fleischer, 2026
+
+	This file is part of Teensy64.
+
+    Teensy64 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Teensy64 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Teensy64.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von Teensy64.
+
+    Teensy64 ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Teensy64 wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+*/
+
+#include "teensy64.h"
+#include "roms.h"
+#include "pla.h"
+#include "kernal_editor.h"
+
+namespace {
+
+inline uint8_t read6502(uint16_t address) {
+    return (*cpu().plamap_r)[address >> 8](address);
+}
+
+inline void write6502(uint16_t address, uint8_t value) {
+    (*cpu().plamap_w)[address >> 8](address, value);
+}
+
+//Extra cycle of LDA (zp),Y, same rule as indy_t() in cpu.cpp
+inline unsigned indyPenalty(uint16_t base, uint8_t y) {
+    return ((base + y) & 0xFF) != (base & 0xFF);
+}
+
+//The loops below keep their pointers in registers and do all accesses at once. So a screen line
+//must neither overlap the zero page and the stack nor any I/O registers, else the ROM code runs.
+inline bool lineIsSafe(uint16_t address) {
+    uint16_t last = address + 39;
+
+    return address >= 0x0200 && last > address && (last < 0xD000 || address >= 0xE000);
+}
+
+inline bool colourLineIsSafe(uint16_t address) {
+    return address + 39 < 0xDC00;
+}
+
+//Return address a JSR leaves on the stack below the current stack pointer
+inline void jsrLeftover(uint8_t offset, uint16_t address) {
+    cpu().RAM[BASE_STACK + ((cpu().sp - offset) & 0xFF)] = address >> 8;
+    cpu().RAM[BASE_STACK + ((cpu().sp - offset - 1) & 0xFF)] = address & 0xFF;
+}
+
+inline void setFlags(uint8_t mask, uint8_t flags) {
+    cpu().cpustatus = (cpu().cpustatus & ~mask) | flags;
+}
+
+inline void rts() {
+    cpu().pc = (cpu().RAM[BASE_STACK + ((cpu().sp + 1) & 0xFF)] | (cpu().RAM[BASE_STACK + ((cpu().sp + 2) & 0xFF)] << 8)) + 1;
+    cpu().sp += 2;
+}
+
+const uint8_t *const ldtb2 = &rom_kernal[0xECF0 - 0xE000]; //low bytes of the screen line addresses
+
+//$E544: line link table for an empty screen, continues at $E55A
+bool clsLinks(unsigned &ticks) {
+    if(cpu().cpustatus & FLAG_DECIMAL) { return false; }
+
+    uint8_t a = 0;
+    uint8_t y = cpu().RAM[0x288] | 0x80;
+    uint8_t v = 0;
+
+    ticks = 12;
+
+    for(uint8_t x = 0; x < 0x1A; x++) {
+        cpu().RAM[0xD9 + x] = y;
+
+        uint16_t sum = a + 0x28;
+        v = ~(a ^ 0x28) & (a ^ sum) & 0x80;
+        a = sum;
+
+        if(sum > 0xFF) {
+            y++;
+            ticks += 4;
+        } else {
+            ticks += 3;
+        }
+
+        ticks += 15;
+    }
+
+    ticks -= 1;
+
+    cpu().a = a;
+    cpu().x = 0x1A;
+    cpu().y = y;
+    setFlags(FLAG_SIGN | FLAG_ZERO | FLAG_CARRY | FLAG_OVERFLOW, FLAG_ZERO | FLAG_CARRY | (v ? FLAG_OVERFLOW : 0));
+    cpu().pc = 0xE55A;
+
+    return true;
+}
+
+//$E916: line links after scrolling up, continues at $E929
+bool scrollLinks(unsigned &ticks) {
+    uint8_t a = 0, y = 0;
+
+    ticks = 2;
+
+    for(uint8_t x = 0; x < 0x18; x++) {
+        a = cpu().RAM[0xD9 + x] & 0x7F;
+        y = cpu().RAM[0xDA + x];
+
+        if(y & 0x80) {
+            a |= 0x80;
+            ticks += 4;
+        } else {
+            ticks += 3;
+        }
+
+        cpu().RAM[0xD9 + x] = a;
+        ticks += 21;
+    }
+
+    ticks -= 1;
+
+    cpu().a = a;
+    cpu().x = 0x18;
+    cpu().y = y;
+    setFlags(FLAG_SIGN | FLAG_ZERO | FLAG_CARRY, FLAG_ZERO | FLAG_CARRY);
+    cpu().pc = 0xE929;
+
+    return true;
+}
+
+//$E9C8 MOVLIN: copy the line at ($AC) to ($D1), colours included
+bool movlin(unsigned &ticks) {
+    uint8_t hi = (cpu().a & 0x03) | cpu().RAM[0x288];
+    uint8_t chi = (hi & 0x03) | 0xD8;
+    uint8_t dchi = (cpu().RAM[0xD2] & 0x03) | 0xD8;
+    uint16_t src = cpu().RAM[0xAC] | (hi << 8);
+    uint16_t csrc = cpu().RAM[0xAC] | (chi << 8);
+    uint16_t dst = cpu().RAM[0xD1] | (cpu().RAM[0xD2] << 8);
+    uint16_t cdst = cpu().RAM[0xD1] | (dchi << 8);
+
+    if(!lineIsSafe(src) || !lineIsSafe(dst) || !colourLineIsSafe(csrc) || !colourLineIsSafe(cdst)) { return false; }
+
+    cpu().RAM[0xAD] = hi;
+    cpu().RAM[0xF3] = cpu().RAM[0xD1];
+    cpu().RAM[0xF4] = dchi;
+    cpu().RAM[0xAE] = cpu().RAM[0xAC];
+    cpu().RAM[0xAF] = chi;
+
+    jsrLeftover(0, 0xE9D1);
+    jsrLeftover(2, 0xE9E2);
+
+    ticks = 9 + 56 + 2 + 6 - 1;
+
+    uint8_t a = 0;
+
+    for(int y = 39; y >= 0; y--) {
+        write6502(dst + y, read6502(src + y));
+        a = read6502(csrc + y);
+        write6502(cdst + y, a);
+        ticks += 27 + indyPenalty(src, y) + indyPenalty(csrc, y);
+    }
+
+    cpu().a = a;
+    cpu().y = 0xFF;
+    setFlags(FLAG_SIGN | FLAG_ZERO, FLAG_SIGN);
+    rts();
+
+    return true;
+}
+
+//$E9FF CLRLN: fill line X with spaces in the current colour
+bool clrln(unsigned &ticks) {
+    uint8_t lo = ldtb2[cpu().x];
+    uint8_t hi = (cpu().RAM[(uint8_t) (0xD9 + cpu().x)] & 0x03) | cpu().RAM[0x288];
+    uint8_t chi = (hi & 0x03) | 0xD8;
+    uint16_t dst = lo | (hi << 8);
+    uint16_t cdst = lo | (chi << 8);
+
+    if(!lineIsSafe(dst) || !colourLineIsSafe(cdst)) { return false; }
+
+    cpu().RAM[0xD1] = lo;
+    cpu().RAM[0xD2] = hi;
+    cpu().RAM[0xF3] = lo;
+    cpu().RAM[0xF4] = chi;
+
+    jsrLeftover(0, 0xEA09);
+
+    ticks = 2 + 32 + ((0xF0 + cpu().x) >> 8) + 28 + 40 * 35 - 1 + 6;
+
+    for(int y = 39; y >= 0; y--) {
+        write6502(cdst + y, cpu().RAM[0x286]);
+        write6502(dst + y, 0x20);
+    }
+
+    cpu().a = 0x20;
+    cpu().y = 0xFF;
+    setFlags(FLAG_SIGN | FLAG_ZERO, FLAG_SIGN);
+    rts();
+
+    return true;
+}
+
+struct teditorpatch {
+    uint16_t address;
+    uint8_t opcode;
+    bool (*fn)(unsigned &ticks);
+};
+
+const teditorpatch editorpatches[] = {
+        {0xE544, 0xAD, clsLinks},
+        {0xE916, 0xA2, scrollLinks},
+        {0xE9C8, 0x29, movlin},
+        {0xE9FF, 0xA0, clrln},
+};
+
+}
+
+uint8_t kernalEditorOpcode(uint16_t address) {
+    for(const auto &p : editorpatches) {
+        if(p.address == address) { return p.opcode; }
+    }
+
+    return 0x02; //KIL
+}
+
+bool kernalKeyboardWait() {
+    return cpu().pc >= 0xE5CD && cpu().pc <= 0xE5D5 && (*cpu().plamap_r)[cpu().pc >> 8] == r_ker;
+}
+
+bool kernalEditor(uint16_t address) {
+    for(const auto &p : editorpatches) {
+        if(p.address == address) {
+            unsigned ticks;
+
+            if(!p.fn(ticks)) { return false; }
+
+            cpu().ticks = (ticks + KERNALEDITOR_CYCLEDIVIDER - 1) / KERNALEDITOR_CYCLEDIVIDER;
+            return true;
+        }
+    }
+
+    return false;
+}
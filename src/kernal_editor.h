@@ -0,0 +1,69 @@
+/*
+	Copyright Frank Bösing, Karsten Fleischer, 2026
+
+	This file is part of Teensy64.
+
+    Teensy64 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Teensy64 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Teensy64.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von Teensy64.
+
+    Teensy64 ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Teensy64 wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+*/
+
+#pragma once
+
+#ifndef TEENSY64_KERNAL_EDITOR_H
+#define TEENSY64_KERNAL_EDITOR_H
+
+#include <cstdint>
+
+/*
+  Native versions of the loops of the KERNAL screen editor.
+
+  CHROUT, scrolling, inserting lines and clearing the screen spend nearly all of their
+  time in a few loops, which are patched with KERNALEDITOR_TRAP_OPCODE in rom_kernal:
+
+  $E544  set up the line link table (clear screen)
+  $E916  line link update after scrolling up
+  $E9C8  MOVLIN: copy a screen line and its colours
+  $E9FF  CLRLN: clear a screen line with the current colour
+
+  The native code produces the same RAM, colour RAM, registers, flags and - with
+  KERNALEDITOR_CYCLEDIVIDER 1 - the same number of cycles as the ROM code.
+*/
+
+#define KERNALEDITOR_TRAP_OPCODE 0x42
+
+// Runs the routine trapped at address natively, returns false if the ROM code has to run instead.
+bool kernalEditor(uint16_t address);
+
+// Returns the original ROM opcode of a trapped address.
+uint8_t kernalEditorOpcode(uint16_t address);
+
+// Returns true while the KERNAL waits for a key in the loop at $E5CD-$E5D5.
+bool kernalKeyboardWait();
+
+#endif // TEENSY64_KERNAL_EDITOR_H
@@ -38,6 +38,15 @@
 
 #include "keyboard_usb.h"
 #include "cia6526.h"
+#include "warp.h"
+#include "freeze.h"
+#include "rewind.h"
+#include "input.h"
+#include "profiler.h"
+#include "trace.h"
+#include "counters.h"
+#include "heatmap.h"
+#include "vic_journal.h"
 
 USBHost myusb;
 
@@ -57,18 +66,10 @@ const char *hotkeys[] = {"\x45RUN", //F12
 char *_sendString = nullptr;
 
 void sendKey(char key) {
-    while(true) {
-        noInterrupts();
-        if(cpu.RAM[198] == 0) { break; }
-        interrupts();
+    //The key goes into the keyboard buffer at the start of a raster line
+    while(!inputKey(key)) {
         delay(1);
-        //asm volatile("wfi");
     }
-
-    cpu.RAM[631] = key;
-    cpu.RAM[198] = 1;
-
-    interrupts();
 }
 
 void do_sendString() {
@@ -196,44 +197,53 @@ struct {
         Werden Nullen bei den Eingangs-Portbits PB0-PB7/$DC01 festgestellt (KERNAL $EAAB), so sind die entsprechende(n) Taste(n) gedrückt.
 */
 
+static uint8_t readJoystick(uint8_t up, uint8_t down, uint8_t left, uint8_t right, uint8_t btn) {
+    uint8_t v = 0;
+
+    if(digitalRead(up) == 0) { v |= CIA1_PR_JOY_UP; }
+    if(digitalRead(down) == 0) { v |= CIA1_PR_JOY_DOWN; }
+    if(digitalRead(left) == 0) { v |= CIA1_PR_JOY_LEFT; }
+    if(digitalRead(right) == 0) { v |= CIA1_PR_JOY_RIGHT; }
+    if(digitalRead(btn) == 0) { v |= CIA1_PR_JOY_BTN; }
+
+    return v;
+}
+
+void sampleInput(tinput &in) {
+    uint8_t joy1 = readJoystick(PIN_JOY1_1, PIN_JOY1_2, PIN_JOY1_3, PIN_JOY1_4, PIN_JOY1_BTN);
+    uint8_t joy2 = readJoystick(PIN_JOY2_1, PIN_JOY2_2, PIN_JOY2_3, PIN_JOY2_4, PIN_JOY2_BTN);
+
+    in.kv = kbdData.kv;
+    in.joyA = cpu().swapJoysticks ? joy1 : joy2;
+    in.joyB = cpu().swapJoysticks ? joy2 : joy1;
+}
+
 uint8_t cia1PORTA() {
     uint8_t v;
 
-    v = ~cpu.cia1.R[CIA_DDRA] | (cpu.cia1.R[CIA_PRA] & cpu.cia1.R[CIA_DDRA]);
+    v = ~cpu().cia1.R[CIA_DDRA] | (cpu().cia1.R[CIA_PRA] & cpu().cia1.R[CIA_DDRA]);
 
-    if(!cpu.swapJoysticks) {
-        if(digitalRead(PIN_JOY2_1) == 0) { v &= ~CIA1_PR_JOY_UP; }
-        if(digitalRead(PIN_JOY2_2) == 0) { v &= ~CIA1_PR_JOY_DOWN; }
-        if(digitalRead(PIN_JOY2_3) == 0) { v &= ~CIA1_PR_JOY_LEFT; }
-        if(digitalRead(PIN_JOY2_4) == 0) { v &= ~CIA1_PR_JOY_RIGHT; }
-        if(digitalRead(PIN_JOY2_BTN) == 0) { v &= ~CIA1_PR_JOY_BTN; }
-    } else {
-        if(digitalRead(PIN_JOY1_1) == 0) { v &= ~CIA1_PR_JOY_UP; }
-        if(digitalRead(PIN_JOY1_2) == 0) { v &= ~CIA1_PR_JOY_DOWN; }
-        if(digitalRead(PIN_JOY1_3) == 0) { v &= ~CIA1_PR_JOY_LEFT; }
-        if(digitalRead(PIN_JOY1_4) == 0) { v &= ~CIA1_PR_JOY_RIGHT; }
-        if(digitalRead(PIN_JOY1_BTN) == 0) { v &= ~CIA1_PR_JOY_BTN; }
-    }
+    v &= ~inputState.joyA;
 
-    if(!kbdData.kv) { return v; } //Keine Taste gedrückt
+    if(!inputState.kv) { return v; } //Keine Taste gedrückt
 
-    uint8_t filter = ~cpu.cia1.R[CIA_PRB] & cpu.cia1.R[CIA_DDRB];
+    uint8_t filter = ~cpu().cia1.R[CIA_PRB] & cpu().cia1.R[CIA_DDRB];
 
-    if(kbdData.k) {
-        if(keymatrixmap[1][kbdData.k] & filter) { v &= ~keymatrixmap[0][kbdData.k]; }
+    if(inputState.k) {
+        if(keymatrixmap[1][inputState.k] & filter) { v &= ~keymatrixmap[0][inputState.k]; }
     }
 
-    if(kbdData.ke) {
-        if(kbdData.ke & 0x02) { //Shift-links
+    if(inputState.ke) {
+        if(inputState.ke & 0x02) { //Shift-links
             if(keymatrixmap[1][0xff] & filter) { v &= ~keymatrixmap[0][0xff]; }
         }
-        if(kbdData.ke & 0x20) { //Shift-rechts
+        if(inputState.ke & 0x20) { //Shift-rechts
             if(keymatrixmap[1][0xfe] & filter) { v &= ~keymatrixmap[0][0xfe]; }
         }
-        if(kbdData.ke & 0x11) { //Control
+        if(inputState.ke & 0x11) { //Control
             if(keymatrixmap[1][0xfd] & filter) { v &= ~keymatrixmap[0][0xfd]; }
         }
-        if(kbdData.ke & 0x88) { //Windows (=> Commodore)
+        if(inputState.ke & 0x88) { //Windows (=> Commodore)
             if(keymatrixmap[1][0xfc] & filter) { v &= ~keymatrixmap[0][0xfc]; }
         }
     }
@@ -245,40 +255,28 @@ uint8_t cia1PORTA() {
 uint8_t cia1PORTB() {
     uint8_t v;
 
-    v = ~cpu.cia1.R[0x03] | (cpu.cia1.R[0x00] & cpu.cia1.R[0x02]);
+    v = ~cpu().cia1.R[0x03] | (cpu().cia1.R[0x00] & cpu().cia1.R[0x02]);
 
-    if(!cpu.swapJoysticks) {
-        if(digitalRead(PIN_JOY1_1) == 0) { v &= ~CIA1_PR_JOY_UP; }
-        if(digitalRead(PIN_JOY1_2) == 0) { v &= ~CIA1_PR_JOY_DOWN; }
-        if(digitalRead(PIN_JOY1_3) == 0) { v &= ~CIA1_PR_JOY_LEFT; }
-        if(digitalRead(PIN_JOY1_4) == 0) { v &= ~CIA1_PR_JOY_RIGHT; }
-        if(digitalRead(PIN_JOY1_BTN) == 0) { v &= ~CIA1_PR_JOY_BTN; }
-    } else {
-        if(digitalRead(PIN_JOY2_1) == 0) { v &= ~CIA1_PR_JOY_UP; }
-        if(digitalRead(PIN_JOY2_2) == 0) { v &= ~CIA1_PR_JOY_DOWN; }
-        if(digitalRead(PIN_JOY2_3) == 0) { v &= ~CIA1_PR_JOY_LEFT; }
-        if(digitalRead(PIN_JOY2_4) == 0) { v &= ~CIA1_PR_JOY_RIGHT; }
-        if(digitalRead(PIN_JOY2_BTN) == 0) { v &= ~CIA1_PR_JOY_BTN; }
-    }
+    v &= ~inputState.joyB;
 
-    if(!kbdData.kv) { return v; } //Keine Taste gedrückt
+    if(!inputState.kv) { return v; } //Keine Taste gedrückt
 
-    uint8_t filter = ~cpu.cia1.R[0x00] & cpu.cia1.R[0x02];
-    if(kbdData.k) {
-        if(keymatrixmap[0][kbdData.k] & filter) v &= ~keymatrixmap[1][kbdData.k];
+    uint8_t filter = ~cpu().cia1.R[0x00] & cpu().cia1.R[0x02];
+    if(inputState.k) {
+        if(keymatrixmap[0][inputState.k] & filter) v &= ~keymatrixmap[1][inputState.k];
     }
 
-    if(kbdData.ke) {
-        if(kbdData.ke & 0x02) { //Shift-links
+    if(inputState.ke) {
+        if(inputState.ke & 0x02) { //Shift-links
             if(keymatrixmap[0][0xff] & filter) { v &= ~keymatrixmap[1][0xff]; }
         }
-        if(kbdData.ke & 0x20) { //Shift-rechts
+        if(inputState.ke & 0x20) { //Shift-rechts
             if(keymatrixmap[0][0xfe] & filter) { v &= ~keymatrixmap[1][0xfe]; }
         }
-        if(kbdData.ke & 0x11) { //Control
+        if(inputState.ke & 0x11) { //Control
             if(keymatrixmap[0][0xfd] & filter) { v &= ~keymatrixmap[1][0xfd]; }
         }
-        if(kbdData.ke & 0x88) { //Windows (=> Commodore)
+        if(inputState.ke & 0x88) { //Windows (=> Commodore)
             if(keymatrixmap[0][0xfc] & filter) { v &= ~keymatrixmap[1][0xfc]; }
         }
     }
@@ -302,33 +300,92 @@ void usbKeyboardmatrix(void *keys) { //Interrupt
         //RESET
         if(kbdData.ke == 0x05 && kbdData.k == 0x4c) {
             //resetExternal();
-            resetMachine();
+            inputReset();
+        } else if(kbdData.ke == 0x05 && kbdData.k == 0x16) { //Ctrl+Alt+S: freeze
+            freezeRequest();
+
+            return;
+        } else if(kbdData.ke == 0x05 && kbdData.k == 0x0f) { //Ctrl+Alt+L: resume
+            resumeRequest();
+
+            return;
+        } else if(kbdData.ke == 0x05 && kbdData.k == 0x15) { //Ctrl+Alt+R: rewind
+            rewindRequest();
+
+            return;
+        } else if(kbdData.ke == 0x05 && kbdData.k == 0x0c) { //Ctrl+Alt+I: record input
+            inputRecordToggle();
+
+            return;
+        } else if(kbdData.ke == 0x05 && kbdData.k == 0x13) { //Ctrl+Alt+P: replay input
+            inputReplayToggle();
+
+
+            return;
+#if PROFILER
+        } else if(kbdData.ke == 0x05 && kbdData.k == 0x12) { //Ctrl+Alt+O: profile
+            profilerRequest();
+
+            return;
+#endif
+#if TRACE
+        } else if(kbdData.ke == 0x05 && kbdData.k == 0x17) { //Ctrl+Alt+T: trace
+            traceRequest();
+
+            return;
+#endif
+#if COUNTERS
+        } else if(kbdData.ke == 0x05 && kbdData.k == 0x06) { //Ctrl+Alt+C: counters
+            countersRequest();
+
+            return;
+#endif
+#if HEATMAP
+        } else if(kbdData.ke == 0x05 && kbdData.k == 0x0b) { //Ctrl+Alt+H: heatmap
+            heatmapRequest();
+
+            return;
+#endif
+#if VIC_JOURNAL
+        } else if(kbdData.ke == 0x05 && kbdData.k == 0x19) { //Ctrl+Alt+V: VIC journal
+            vicJournalRequest();
+
+            return;
+#endif
         } else if(kbdData.k == 0x46) { //RESTORE - "Druck"
             kbdData.k = kbdData.k2;
             kbdData.k2 = 0;
 
-            cpu_nmi();
+            inputNMI();
 
             return;
         } else if(kbdData.k2 == 0x46) { //RESTORE - "Druck"
             kbdData.k2 = 0;
 
-            cpu_nmi();
+            inputNMI();
 
             return;
         } else if(kbdData.k == 72) {
-            cpu.vic.nextPalette();
+            cpu().vic.nextPalette();
+
+            return;
+        } else if(kbdData.k == 0x47) { //Warp mode - "Rollen"
+            warpToggle();
+
+            return;
+        } else if(kbdData.k == 0x4D) { //CPU turbo 1x, 2x, 4x... - "Ende"
+            inputTurbo(cpu().turbo < TURBO_MAX ? cpu().turbo * 2 : 1);
 
             return;
         } else if(kbdData.k == 0x53) {// Joystick - Swap " Numlock"
-            cpu.swapJoysticks = (cpu.swapJoysticks + 1) & 0x01;
+            cpu().swapJoysticks = (cpu().swapJoysticks + 1) & 0x01;
 
             //Todo: Add some indication here
             Serial.print("Joysticks ");
-            Serial.println((cpu.swapJoysticks) ? "swapped" : "default");
+            Serial.println((cpu().swapJoysticks) ? "swapped" : "default");
 
             //TODO: Does not work: Bug in USB Code ?
-            keyboard.numLock(cpu.swapJoysticks);
+            keyboard.numLock(cpu().swapJoysticks);
 
             return;
         } else if(kbdData.ke == 0x10) {
@@ -39,6 +39,7 @@
 #define TEENSY64_KEYBOARD_H
 
 #include <cstdint>
+#include "input.h"
 
 void initKeyboard();
 void initJoysticks();
@@ -48,4 +49,7 @@ void do_sendString();//call in yield()
 uint8_t cia1PORTA(void);
 uint8_t cia1PORTB(void);
 
+// Current state of the USB keyboard and the joysticks, mapped to the CIA1 ports.
+void sampleInput(tinput &in);
+
 #endif // TEENSY64_KEYBOARD_H
\ No newline at end of file
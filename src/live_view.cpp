@@ -0,0 +1,136 @@
+/*
+	Copyright Frank Bösing, Karsten Fleischer, 2026
+
+	This file is part of Teensy64.
+
+    Teensy64 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Teensy64 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Teensy64.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von Teensy64.
+
+    Teensy64 ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Teensy64 wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+*/
+
+#include <cstring>
+#include "settings.h"
+
+#if MACHINES > 1
+
+#include <atomic>
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace {
+
+//before SdFat.h (in teensy64.h) defines O_RDWR and friends for its own files
+const int SHM_FLAGS = O_CREAT | O_RDWR | O_TRUNC;
+
+}
+
+#include "teensy64.h"
+#include "live_view.h"
+
+namespace {
+
+const unsigned HEADER_SIZE = 4096; //the machine starts page aligned
+
+inline uint32_t offset(const tliveView *view, const void *p) {
+    return (const uint8_t *) p - (const uint8_t *) view;
+}
+
+}
+
+void *liveViewMap(const char *name, unsigned size) {
+    if(strlen(name) >= sizeof(tliveView::name)) {
+        Serial.printf("Live view %s: name too long\n", name);
+        return nullptr;
+    }
+
+    size += HEADER_SIZE;
+
+    int fd = shm_open(name, SHM_FLAGS, 0644);
+
+    if(fd < 0) {
+        Serial.printf("Live view %s: %s\n", name, strerror(errno));
+        return nullptr;
+    }
+
+    void *p = MAP_FAILED;
+
+    if(ftruncate(fd, size) == 0) { p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0); }
+
+    if(p == MAP_FAILED) {
+        Serial.printf("Live view %s: %s\n", name, strerror(errno));
+        close(fd);
+        shm_unlink(name);
+        return nullptr;
+    }
+
+    close(fd);
+
+    tliveView *view = (tliveView *) p;
+
+    view->size = size;
+    strcpy(view->name, name);
+
+    return (uint8_t *) p + HEADER_SIZE;
+}
+
+void liveViewPublish(tcpu *m) {
+    tliveView *view = (tliveView *) ((uint8_t *) m - HEADER_SIZE);
+
+    m->liveView = view;
+
+    view->version = LIVE_VIEW_VERSION;
+    view->machine = offset(view, m);
+    view->ram = offset(view, m->RAM);
+    view->colorRAM = offset(view, m->vic.colorRAM);
+    view->vic = offset(view, m->vic.R);
+    view->cia1 = offset(view, m->cia1.R);
+    view->cia2 = offset(view, m->cia2.R);
+    view->sid = offset(view, m->sid);
+    view->pc = offset(view, &m->pc);
+    view->a = offset(view, &m->a);
+    view->x = offset(view, &m->x);
+    view->y = offset(view, &m->y);
+    view->sp = offset(view, &m->sp);
+    view->status = offset(view, &m->cpustatus);
+    view->rasterLine = offset(view, &m->vic.rasterLine);
+
+    std::atomic_thread_fence(std::memory_order_release);
+    memcpy(view->magic, LIVE_VIEW_MAGIC, sizeof(view->magic));
+}
+
+void liveViewUnmap(tliveView *view) {
+    char name[sizeof(view->name)];
+
+    strcpy(name, view->name);
+    munmap(view, view->size);
+    shm_unlink(name);
+}
+
+#endif
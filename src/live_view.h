@@ -0,0 +1,93 @@
+/*
+	Copyright Frank Bösing, Karsten Fleischer, 2026
+
+	This file is part of Teensy64.
+
+    Teensy64 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Teensy64 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Teensy64.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von Teensy64.
+
+    Teensy64 ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Teensy64 wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+*/
+
+#pragma once
+
+#ifndef TEENSY64_LIVE_VIEW_H
+#define TEENSY64_LIVE_VIEW_H
+
+#include <cstdint>
+
+/*
+  Live view for host builds (MACHINES > 1): a machine created with a name (see
+  machineCreate()) lives in a POSIX shared memory segment of that name, so other processes,
+  e.g. memory viewers or test scripts, can map it and read RAM and chip registers while it
+  runs, without copies and without stopping the emulation:
+
+    int fd = shm_open("/t64", O_RDONLY, 0);
+    const uint8_t *view = (const uint8_t *) mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    const tliveView *header = (const tliveView *) view;
+    const uint8_t *ram = view + header->ram;
+
+  The segment starts with a tliveView, the machine follows at header->machine. The offsets
+  in the header are all a reader needs, the layout of tcpu may change between builds.
+  Readers see the state as it is while the emulation writes it, not a consistent snapshot.
+  The segment is removed by machineDestroy().
+*/
+
+#define LIVE_VIEW_MAGIC   "T64LIVE" //valid once the header is complete
+#define LIVE_VIEW_VERSION 1
+
+struct tliveView {
+    char magic[8];
+    uint32_t version;
+    uint32_t size; //of the segment in bytes
+    char name[64];
+
+    //offsets from the start of the segment
+    uint32_t machine;    //struct tcpu
+    uint32_t ram;        //64 KB
+    uint32_t colorRAM;   //1 KB, one nibble per byte
+    uint32_t vic;        //0x40 registers
+    uint32_t cia1;       //0x10 registers
+    uint32_t cia2;       //0x10 registers
+    uint32_t sid;        //0x20 registers, as written
+    uint32_t pc;         //uint16_t
+    uint32_t a, x, y, sp, status;
+    uint32_t rasterLine; //uint16_t
+};
+
+struct tcpu;
+
+// Memory for a machine in the segment name, nullptr if it can't be created. Used by machineCreate().
+void *liveViewMap(const char *name, unsigned size);
+
+// Fills in the header for the machine m placed at liveViewMap().
+void liveViewPublish(tcpu *m);
+
+// Unmaps and removes the segment of m, after the machine has been destroyed.
+void liveViewUnmap(tliveView *view);
+
+#endif // TEENSY64_LIVE_VIEW_H
@@ -0,0 +1,254 @@
+/*
+	Copyright Frank Bösing, Karsten Fleischer, 2026
+
+	This file is part of Teensy64.
+
+    Teensy64 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Teensy64 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Teensy64.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von Teensy64.
+
+    Teensy64 ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Teensy64 wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+*/
+
+#include <cstring>
+#include "teensy64.h"
+#include "roms.h"
+#include "pla.h"
+#include "cia6526.h"
+#include "loop_idioms.h"
+#include "monitor.h"
+
+namespace {
+
+inline uint8_t read6502(uint16_t address) {
+    return (*cpu().plamap_r)[address >> 8](address);
+}
+
+//Memory behind a read handler, nullptr for I/O and everything else with side effects
+const uint8_t *readablePage(uint8_t page) {
+    r_ptr_t r = (*cpu().plamap_r)[page];
+    uint32_t address = page << 8;
+
+    if(r == r_ram) { return &cpu().RAM[address]; }
+    if(r == r_bas) { return &rom_basic[address & (sizeof(rom_basic) - 1)]; }
+    if(r == r_ker) { return &rom_kernal[address & (sizeof(rom_kernal) - 1)]; }
+    if(r == r_chr) { return &rom_characters[address & (sizeof(rom_characters) - 1)]; }
+
+    return nullptr;
+}
+
+//Pointer to len bytes at address if they are plain memory in one piece, else nullptr
+const uint8_t *readableRange(uint16_t address, unsigned len) {
+    unsigned last = address + len - 1;
+
+    if(last > 0xFFFF) { return nullptr; }
+
+    const uint8_t *p = readablePage(address >> 8);
+
+    if(p == nullptr) { return nullptr; }
+
+    for(unsigned page = (address >> 8) + 1; page <= (last >> 8); page++) {
+        if(readablePage(page) != p + ((page - (address >> 8)) << 8)) { return nullptr; }
+    }
+
+    return p + (address & 0xFF);
+}
+
+uint8_t *writableRange(uint16_t address, unsigned len) {
+    unsigned last = address + len - 1;
+
+    if(last > 0xFFFF) { return nullptr; }
+
+    for(unsigned page = address >> 8; page <= (last >> 8); page++) {
+        if((*cpu().plamap_w)[page] != w_ram) { return nullptr; }
+    }
+
+    return &cpu().RAM[address];
+}
+
+//Limits budget to the cycles until the next timer underflow of the CIA
+int timerBudget(const tcia &cia, int budget) {
+    if((cia.R[CIA_CRA] & 0x21) == 0x01) {
+        budget = min(budget, (int) (cia.R[CIA_TALO] | (cia.R[CIA_TAHI] << 8)));
+    }
+
+    if((cia.R[CIA_CRB] & 0x61) == 0x01) {
+        budget = min(budget, (int) (cia.R[CIA_TBLO] | (cia.R[CIA_TBHI] << 8)));
+    }
+
+    return budget;
+}
+
+bool interruptPending() {
+    if(!cpu().nmi && ((cpu().cia2.R[CIA_ICR] & CIA_ICR_IR) | cpu().nmiLine)) { return true; }
+
+    return !(cpu().cpustatus & FLAG_INTERRUPT) && ((cpu().vic.R[VIC_IRQST] | cpu().cia1.R[CIA_ICR]) & CIA_ICR_IR);
+}
+
+enum tindex {
+    INDEX_X, INDEX_Y
+};
+
+struct tloop {
+    bool copy;
+    bool indirect;
+    tindex index;
+    int8_t step;
+    uint16_t src, dst;
+    unsigned ticks; //per iteration without page crossings
+};
+
+//Decodes the loop body between start and the branch, returns false if it is no copy or fill loop
+bool decode(uint16_t start, uint16_t branch, tloop &loop) {
+    uint8_t code[7];
+    unsigned len = branch - start;
+
+    if(len != 3 && len != 4 && len != 5 && len != 7) { return false; }
+
+    for(unsigned i = 0; i < len; i++) { code[i] = read6502(start + i); }
+
+    uint8_t step = code[len - 1];
+    const uint8_t *store;
+
+    loop.copy = len == 5 || len == 7;
+    loop.indirect = len == 3 || len == 5;
+
+    if(loop.indirect) {
+        if(loop.copy && code[0] != 0xB1) { return false; } //LDA (zp),Y
+        store = &code[loop.copy ? 2 : 0];
+        if(store[0] != 0x91) { return false; } //STA (zp),Y
+        loop.index = INDEX_Y;
+        loop.src = cpu().RAM[code[1]] | (cpu().RAM[(uint8_t) (code[1] + 1)] << 8);
+        loop.dst = cpu().RAM[store[1]] | (cpu().RAM[(uint8_t) (store[1] + 1)] << 8);
+        loop.ticks = loop.copy ? 5 + 6 + 2 : 6 + 2;
+    } else {
+        store = &code[loop.copy ? 3 : 0];
+        if(store[0] == 0x9D && (!loop.copy || code[0] == 0xBD)) { //STA abs,X  LDA abs,X
+            loop.index = INDEX_X;
+        } else if(store[0] == 0x99 && (!loop.copy || code[0] == 0xB9)) { //STA abs,Y  LDA abs,Y
+            loop.index = INDEX_Y;
+        } else {
+            return false;
+        }
+        loop.src = code[1] | (code[2] << 8);
+        loop.dst = store[1] | (store[2] << 8);
+        loop.ticks = loop.copy ? 4 + 5 + 2 : 5 + 2;
+    }
+
+    if(loop.index == INDEX_X && step == 0xE8) { loop.step = 1; }        //INX
+    else if(loop.index == INDEX_X && step == 0xCA) { loop.step = -1; }  //DEX
+    else if(loop.index == INDEX_Y && step == 0xC8) { loop.step = 1; }   //INY
+    else if(loop.index == INDEX_Y && step == 0x88) { loop.step = -1; }  //DEY
+    else { return false; }
+
+    return true;
+}
+
+//Extra cycle of the load, same rules as absx_t()/absy_t() and indy_t() in cpu.cpp
+inline unsigned loadPenalty(const tloop &loop, uint8_t index) {
+    if(!loop.copy) { return 0; }
+    if(loop.indirect) { return ((loop.src + index) & 0xFF) != (loop.src & 0xFF); }
+    return ((loop.src & 0xFF) + index) >> 8;
+}
+
+}
+
+void loopIdiom(uint8_t branchOpcode, int lineCycles) {
+    //Only lines where the CPU owns all cycles, without badline or sprite DMA
+    if(cpu().exactTiming || cpu().vic.badline || cpu().vic.R[VIC_MxE] || interruptPending()) { return; }
+
+    //the monitor sees each iteration
+    if(monitorActive()) { return; }
+
+    uint16_t start = cpu().pc;
+    uint16_t branch = start - (int16_t) cpu().reladdr - 2;
+    tloop loop;
+
+    if(!decode(start, branch, loop)) { return; }
+
+    uint8_t &reg = (loop.index == INDEX_X) ? cpu().x : cpu().y;
+    uint8_t r = reg;
+
+    //Number of further iterations that end with a taken branch
+    unsigned maxIterations;
+
+    if(branchOpcode == 0xD0) { //BNE
+        maxIterations = (loop.step > 0) ? 255 - r : r - 1;
+    } else { //BPL
+        maxIterations = (loop.step > 0) ? 127 - r : r;
+    }
+
+    //Stay within the current raster line and before the next timer interrupt, so interrupts
+    //and the state at the end of each line are the same as with the interpreter
+    int budget = min(lineCycles, timerBudget(cpu().cia2, timerBudget(cpu().cia1, 0x10000)) * cpu().turbo
+                                 - (int) cpu().turboTicks - (int) cpu().ticks);
+    unsigned branchTicks = cpu().ticks;
+    unsigned iterations = 0;
+    unsigned ticks = 0;
+
+    for(uint8_t index = r; iterations < maxIterations; index += loop.step) {
+        unsigned t = loop.ticks + branchTicks + loadPenalty(loop, index);
+
+        if((int) (ticks + t) > budget) { break; }
+
+        ticks += t;
+        iterations++;
+    }
+
+    if(iterations == 0) { return; }
+
+    uint8_t first = (loop.step > 0) ? r : r - iterations + 1; //lowest index
+    uint8_t *dst = writableRange(loop.dst + first, iterations);
+
+    if(dst == nullptr) { return; }
+
+    uint16_t dstFirst = loop.dst + first;
+    uint16_t dstLast = dstFirst + iterations - 1;
+
+    if(dstLast >= start && dstFirst <= branch + 1) { return; } //self-modifying
+
+    if(loop.copy) {
+        const uint8_t *src = readableRange(loop.src + first, iterations);
+
+        if(src == nullptr) { return; }
+
+        if(src + iterations <= dst || dst + iterations <= src) {
+            memcpy(dst, src, iterations);
+        } else if(loop.step > 0) {
+            for(unsigned i = 0; i < iterations; i++) { dst[i] = src[i]; }
+        } else {
+            for(unsigned i = iterations; i-- > 0;) { dst[i] = src[i]; }
+        }
+
+        cpu().a = dst[(loop.step > 0) ? iterations - 1 : 0];
+    } else {
+        memset(dst, cpu().a, iterations);
+    }
+
+    reg = r + loop.step * (int) iterations;
+    cpu().cpustatus = (cpu().cpustatus & ~(FLAG_SIGN | FLAG_ZERO)) | (reg & FLAG_SIGN) | (reg ? 0 : FLAG_ZERO);
+    cpu().ticks += ticks;
+}
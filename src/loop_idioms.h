@@ -0,0 +1,63 @@
+/*
+	Copyright Frank Bösing, Karsten Fleischer, 2026
+
+	This file is part of Teensy64.
+
+    Teensy64 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Teensy64 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Teensy64.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von Teensy64.
+
+    Teensy64 ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Teensy64 wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+*/
+
+#pragma once
+
+#ifndef TEENSY64_LOOP_IDIOMS_H
+#define TEENSY64_LOOP_IDIOMS_H
+
+#include <cstdint>
+
+/*
+  Recognition of the canonical copy and fill loops at their backward branch:
+
+    LDA abs,X / STA abs,X / INX|DEX / BNE|BPL    (same with Y)
+    STA abs,X / INX|DEX / BNE|BPL                (same with Y)
+    LDA (zp),Y / STA (zp),Y / INY|DEY / BNE|BPL
+    STA (zp),Y / INY|DEY / BNE|BPL
+
+  When the branch is taken, as many iterations as fit into the rest of the raster line
+  and before the next CIA timer underflow run as one memcpy/memset, with the same
+  registers, flags and cycles as the 6502 code.
+  The last iteration (the one that leaves the loop) is always left to the interpreter.
+  Loops that touch I/O, the zero page or their own code are not accelerated, neither
+  are badlines, lines with sprites and the exact timing mode.
+  Within a line, the VIC may see the written bytes a few cycles earlier.
+*/
+
+// Called after a taken backward branch with the opcode of the branch and the CPU cycles left in the raster line.
+void loopIdiom(uint8_t branchOpcode, int lineCycles);
+
+#endif // TEENSY64_LOOP_IDIOMS_H
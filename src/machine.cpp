@@ -0,0 +1,166 @@
+/*
+	Copyright Frank Bösing, Karsten Fleischer, 2026
+
+	This file is part of Teensy64.
+
+    Teensy64 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Teensy64 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Teensy64.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von Teensy64.
+
+    Teensy64 ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Teensy64 wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+*/
+
+#include "teensy64.h"
+#include "boot_snapshot.h"
+#include "machine.h"
+#include "decrunch.h"
+#include "counters.h"
+#include "heatmap.h"
+#include "vic_journal.h"
+#if MACHINES > 1
+#include <new>
+#include "vic_pipeline.h"
+#include "video_stream.h"
+#include "live_view.h"
+#endif
+
+#if MACHINES > 1
+
+tcpu *machineCreate(tpixel *frameBuffer, AudioPlaySID *sid, const char *liveView) {
+    void *p = liveView ? liveViewMap(liveView, sizeof(tcpu)) : nullptr;
+    tcpu *m = p ? new(p) tcpu() : new tcpu(); //without the live view if it can't be created
+
+    if(p) { liveViewPublish(m); }
+
+    m->vic.frameBuffer = frameBuffer;
+    m->sidChip = sid;
+    m->iecBus = 0; //no drives on the host
+
+    return m;
+}
+
+void machineDestroy(tcpu *m) {
+    videoStreamStop(m->vic);
+    vicPipelineStop(m->vic);
+
+    if(machine == m) { machine = nullptr; }
+
+    if(m->liveView) {
+        tliveView *view = m->liveView;
+
+        m->~tcpu();
+        liveViewUnmap(view);
+    } else {
+        delete m;
+    }
+}
+
+#endif
+
+void machineReset() {
+    resetPLA();
+    resetCia1();
+    resetCia2();
+    cpu().vic.reset();
+    cpu_reset();
+}
+
+namespace {
+
+void booted() {
+#if FASTBOOT == 1
+    cpu().RAM[678] = (PAL == 1) ? 1 : 0; //PAL/NTSC switch, C64-Autodetection does not work with FASTBOOT
+#endif
+
+#if COUNTERS
+    countersReset(); //a new run
+#endif
+#if HEATMAP
+    heatmapReset();
+#endif
+#if VIC_JOURNAL
+    vicJournalReset();
+#endif
+}
+
+}
+
+void machineBoot() {
+#if FASTBOOT == 1
+    cpu().bootCycles = 2e6; //run by machineLine(), then booted()
+#else
+#if FASTBOOT == 2
+    bootSnapshotRestore();
+#endif
+    booted();
+#endif
+}
+
+bool machineBooting() {
+    return cpu().bootCycles != 0;
+}
+
+void machineLine() {
+    cpu().lineStartTime = ARM_DWT_CYCCNT;
+    cpu().lineCycles = cpu().lineCyclesAbs = 0;
+
+#if FASTBOOT == 1
+    if(cpu().bootCycles) {
+        //the KERNAL boot without the VIC, a slice per line keeps the line clock interrupt short
+        uint32_t cycles = min(cpu().bootCycles, (uint32_t) FASTBOOT_SLICE);
+        uint8_t turbo = cpu().turbo;
+
+        //at 1x: the PAL/NTSC detection of the KERNAL, which sets up the CIA timers, depends on the CPU speed
+        cpu().turbo = 1;
+        cpu_clock(cycles);
+        cpu().turbo = turbo;
+        cpu().bootCycles -= cycles;
+        if(!cpu().bootCycles) { booted(); }
+        return;
+    }
+#endif
+
+    decrunchLine();
+
+    if(!cpu().exactTiming) {
+        tvic::render();
+    } else {
+        tvic::renderSimple();
+    }
+
+#if HEATMAP
+    if(cpu().vic.rasterLine == 0) { heatmapFrame(); }
+#endif
+#if VIC_JOURNAL
+    if(cpu().vic.rasterLine == 0) { vicJournalNextFrame(); }
+#endif
+
+    if(--cpu().rtcLines == 0) {
+        cpu().rtcLines = (unsigned short)LINEFREQ / 10; // 10Hz
+        cia1_checkRTCAlarm();
+        cia2_checkRTCAlarm();
+    }
+}
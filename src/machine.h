@@ -0,0 +1,93 @@
+/*
+	Copyright Frank Bösing, Karsten Fleischer, 2026
+
+	This file is part of Teensy64.
+
+    Teensy64 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Teensy64 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Teensy64.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von Teensy64.
+
+    Teensy64 ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Teensy64 wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+*/
+
+#pragma once
+
+#ifndef TEENSY64_MACHINE_H
+#define TEENSY64_MACHINE_H
+
+#include "cpu.h"
+
+/*
+  The emulated machine: CPU, PLA maps, VIC, CIAs, RAM and the SID it plays on, all in one
+  struct tcpu, with the state the core keeps about it: a fast decrunch, the flags of the
+  monitor and the data of the instrumentation builds. The core works on the machine that
+  cpu() returns.
+
+  The firmware has exactly one machine, cpu() returns the static object and costs nothing.
+  With MACHINES > 1 (host builds), cpu() returns the machine bound to the current thread, so
+  each thread can run its own machines:
+
+    tcpu *m = machineCreate(frameBuffer, nullptr);
+    machineBind(m);
+    machineReset();
+    machineBoot();
+    while(machineBooting()) { machineLine(); }
+    for(...) { machineLine(); }
+
+  A machine must not run on two threads at the same time. Warp, freeze, rewind and input
+  recording are parts of the firmware and work on its one machine.
+*/
+
+#if MACHINES > 1
+
+// Frame buffer of ILI9341_TFTHEIGHT x ILI9341_TFTWIDTH pixels, nullptr: the display. sid nullptr: no SID.
+// The machine has nothing on its IEC bus and never switches to exact timing.
+// With a liveView name, the machine lives in shared memory of that name, see live_view.h.
+tcpu *machineCreate(tpixel *frameBuffer, AudioPlaySID *sid, const char *liveView = nullptr);
+void machineDestroy(tcpu *m);
+
+// Binds m to the current thread, until the next machineBind().
+inline void machineBind(tcpu *m) {
+    machine = m;
+}
+
+#endif
+
+// Resets the chips of the machine.
+void machineReset();
+
+// Boots the machine after machineReset(), as set with FASTBOOT.
+// With FASTBOOT 1, the KERNAL boot runs in the next machineLine() calls, FASTBOOT_SLICE
+// cycles each, without drawing lines.
+void machineBoot();
+
+// True while the boot of FASTBOOT 1 is still running.
+bool machineBooting();
+
+// Emulates one raster line.
+void machineLine();
+
+#endif // TEENSY64_MACHINE_H
@@ -0,0 +1,155 @@
+/*
+	Copyright Frank Bösing, Karsten Fleischer, 2026
+
+	This file is part of Teensy64.
+
+    Teensy64 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Teensy64 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Teensy64.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von Teensy64.
+
+    Teensy64 ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Teensy64 wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+*/
+
+#include <cstring>
+#include "teensy64.h"
+#include "machine_state.h"
+
+namespace {
+
+void saveCia(tmachineCia &s, const tcia &cia) {
+    memcpy(s.R, cia.R, sizeof(s.R));
+    memcpy(s.W, cia.W, sizeof(s.W));
+    s.TODelapsed = millis() - cia.TOD;
+    s.TODfrozenMillis = cia.TODfrozenMillis;
+    s.TODAlarm = cia.TODAlarm;
+    s.TODstopped = cia.TODstopped;
+    s.TODfrozen = cia.TODfrozen;
+}
+
+void loadCia(tcia &cia, const tmachineCia &s) {
+    memcpy(cia.R, s.R, sizeof(cia.R));
+    memcpy(cia.W, s.W, sizeof(cia.W));
+    cia.TOD = millis() - s.TODelapsed;
+    cia.TODfrozenMillis = s.TODfrozenMillis;
+    cia.TODAlarm = s.TODAlarm;
+    cia.TODstopped = s.TODstopped;
+    cia.TODfrozen = s.TODfrozen;
+}
+
+}
+
+void machineStateSave(tmachineState &s) {
+    s.pc = cpu().pc;
+    s.sp = cpu().sp;
+    s.a = cpu().a;
+    s.x = cpu().x;
+    s.y = cpu().y;
+    s.cpustatus = cpu().cpustatus;
+    s.nmi = cpu().nmi;
+    s.nmiLine = cpu().nmiLine;
+    s.exrom = cpu()._exrom;
+    s.game = cpu()._game;
+    s.turboTicks = cpu().turboTicks;
+    s.clockCycles = cpu().clockCycles;
+    s.decrunch = cpu().decrunch;
+
+    memcpy(s.vic, cpu().vic.R, sizeof(s.vic));
+    s.rasterLine = cpu().vic.rasterLine;
+    s.intRasterLine = cpu().vic.intRasterLine;
+    s.vcbase = cpu().vic.vcbase;
+    s.rc = cpu().vic.rc;
+    s.borderFlag = cpu().vic.borderFlag;
+    s.borderFlagH = cpu().vic.borderFlagH;
+    s.idle = cpu().vic.idle;
+    s.denLatch = cpu().vic.denLatch;
+    s.badline = cpu().vic.badline;
+    s.BAsignal = cpu().vic.BAsignal;
+    s.lineHasSprites = cpu().vic.lineHasSprites;
+    s.spriteCycles0_2 = cpu().vic.spriteCycles0_2;
+    s.spriteCycles3_7 = cpu().vic.spriteCycles3_7;
+    s.fgcollision = cpu().vic.fgcollision;
+    memcpy(s.lineMemChr, cpu().vic.lineMemChr, sizeof(s.lineMemChr));
+    memcpy(s.lineMemCol, cpu().vic.lineMemCol, sizeof(s.lineMemCol));
+
+    saveCia(s.cia1, cpu().cia1);
+    saveCia(s.cia2, cpu().cia2);
+
+    memcpy(s.sid, cpu().sid, sizeof(s.sid));
+}
+
+void machineStateLoad(const tmachineState &s) {
+    cpu().pc = s.pc;
+    cpu().sp = s.sp;
+    cpu().a = s.a;
+    cpu().x = s.x;
+    cpu().y = s.y;
+    cpu().cpustatus = s.cpustatus;
+    cpu().nmi = s.nmi;
+    cpu().nmiLine = s.nmiLine;
+    cpu()._exrom = s.exrom;
+    cpu()._game = s.game;
+    cpu().turboTicks = s.turboTicks;
+    cpu().clockCycles = s.clockCycles;
+    cpu().decrunch = s.decrunch;
+    if(cpu().exactTiming) { cpu_disableExactTiming(); }
+
+    //6510 port: memory configuration
+    (*cpu().plamap_w)[0](1, cpu().RAM[1]);
+
+    memcpy(cpu().vic.R, s.vic, sizeof(cpu().vic.R));
+    cpu().vic.rasterLine = s.rasterLine;
+    cpu().vic.intRasterLine = s.intRasterLine;
+    cpu().vic.vcbase = s.vcbase;
+    cpu().vic.rc = s.rc;
+    cpu().vic.borderFlag = s.borderFlag;
+    cpu().vic.borderFlagH = s.borderFlagH;
+    cpu().vic.idle = s.idle;
+    cpu().vic.denLatch = s.denLatch;
+    cpu().vic.badline = s.badline;
+    cpu().vic.BAsignal = s.BAsignal;
+    cpu().vic.lineHasSprites = s.lineHasSprites;
+    cpu().vic.spriteCycles0_2 = s.spriteCycles0_2;
+    cpu().vic.spriteCycles3_7 = s.spriteCycles3_7;
+    cpu().vic.fgcollision = s.fgcollision;
+    memcpy(cpu().vic.lineMemChr, s.lineMemChr, sizeof(cpu().vic.lineMemChr));
+    memcpy(cpu().vic.lineMemCol, s.lineMemCol, sizeof(cpu().vic.lineMemCol));
+
+    loadCia(cpu().cia1, s.cia1);
+    loadCia(cpu().cia2, s.cia2);
+    cia2_restorePorts();
+
+    memcpy(cpu().sid, s.sid, sizeof(cpu().sid));
+    if(!cpu().sidChip) { return; }
+
+    //control registers last, they start the voices
+    cpu().sidChip->reset();
+    for(unsigned i = 0; i < sizeof(s.sid); i++) {
+        if(i != 0x04 && i != 0x0B && i != 0x12) { cpu().sidChip->setreg(i, s.sid[i]); }
+    }
+    cpu().sidChip->setreg(0x04, s.sid[0x04]);
+    cpu().sidChip->setreg(0x0B, s.sid[0x0B]);
+    cpu().sidChip->setreg(0x12, s.sid[0x12]);
+}
@@ -0,0 +1,90 @@
+/*
+	Copyright Frank Bösing, Karsten Fleischer, 2026
+
+	This file is part of Teensy64.
+
+    Teensy64 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Teensy64 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Teensy64.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von Teensy64.
+
+    Teensy64 ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Teensy64 wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+*/
+
+#pragma once
+
+#ifndef TEENSY64_MACHINE_STATE_H
+#define TEENSY64_MACHINE_STATE_H
+
+#include <cstdint>
+#include "decrunch.h"
+
+/*
+  The state of the machine without RAM and colour RAM: CPU registers, a fast decrunch in
+  progress, memory configuration, VIC registers and the state of the current raster line,
+  CIAs with latches and TOD and the SID registers. Used by freeze and rewind, both save RAM and colour RAM their own way.
+
+  It is only consistent between two raster lines.
+*/
+
+struct tmachineCia {
+    uint8_t R[0x10];
+    uint8_t W[0x10];
+    uint32_t TODelapsed; //millis() - TOD
+    uint32_t TODfrozenMillis;
+    uint32_t TODAlarm;
+    uint8_t TODstopped;
+    uint8_t TODfrozen;
+};
+
+struct tmachineState {
+    //CPU
+    uint16_t pc;
+    uint8_t sp, a, x, y, cpustatus;
+    uint8_t nmi, nmiLine;
+    uint8_t exrom, game;
+    uint8_t turboTicks;
+    int32_t clockCycles;
+    tdecrunchRun decrunch;
+
+    //VIC
+    uint8_t vic[0x40];
+    uint16_t rasterLine, intRasterLine, vcbase;
+    uint8_t rc, borderFlag, borderFlagH, idle, denLatch, badline, BAsignal;
+    uint8_t lineHasSprites, spriteCycles0_2, spriteCycles3_7, fgcollision;
+    uint8_t lineMemChr[40];
+    uint8_t lineMemCol[40];
+
+    tmachineCia cia1, cia2;
+
+    uint8_t sid[0x20];
+};
+
+void machineStateSave(tmachineState &s);
+
+// RAM has to be restored before, the memory configuration depends on it.
+void machineStateLoad(const tmachineState &s);
+
+#endif // TEENSY64_MACHINE_STATE_H
@@ -0,0 +1,1054 @@
+/*
+	Copyright Frank Bösing, Karsten Fleischer, 2026
+
+	This file is part of Teensy64.
+
+    Teensy64 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Teensy64 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Teensy64.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von Teensy64.
+
+    Teensy64 ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Teensy64 wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+*/
+
+#include <cstring>
+#include "settings.h"
+
+#if MONITOR
+
+#if MACHINES > 1
+#include <cerrno>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include "teensy64.h"
+#include "pla.h"
+#include "roms.h"
+#include "machine.h"
+#include "basic_fp.h"
+#include "kernal_editor.h"
+#include "decrunch.h"
+#include "monitor.h"
+
+namespace {
+
+const uint8_t STX = 0x02;
+const uint8_t API_VERSION = 0x02;
+const uint32_t EVENT = 0xFFFFFFFF; //request id of events
+
+enum : uint8_t {
+    CMD_MEMORY_GET = 0x01,
+    CMD_MEMORY_SET = 0x02,
+    CMD_CHECKPOINT_GET = 0x11,
+    CMD_CHECKPOINT_SET = 0x12,
+    CMD_CHECKPOINT_DELETE = 0x13,
+    CMD_CHECKPOINT_LIST = 0x14,
+    CMD_CHECKPOINT_TOGGLE = 0x15,
+    CMD_REGISTERS_GET = 0x31,
+    CMD_REGISTERS_SET = 0x32,
+    CMD_ADVANCE_INSTRUCTIONS = 0x71,
+    CMD_KEYBOARD_FEED = 0x72,
+    CMD_EXECUTE_UNTIL_RETURN = 0x73,
+    CMD_PING = 0x81,
+    CMD_BANKS_AVAILABLE = 0x82,
+    CMD_REGISTERS_AVAILABLE = 0x83,
+    CMD_VICE_INFO = 0x85,
+    CMD_EXIT = 0xAA,
+    CMD_QUIT = 0xBB,
+    CMD_RESET = 0xCC,
+
+    EVENT_STOPPED = 0x62,
+    EVENT_RESUMED = 0x63
+};
+
+enum : uint8_t {
+    ERR_OK = 0x00,
+    ERR_NOT_FOUND = 0x01,
+    ERR_MEMSPACE = 0x02,
+    ERR_LENGTH = 0x80,
+    ERR_PARAMETER = 0x81,
+    ERR_API_VERSION = 0x82,
+    ERR_COMMAND = 0x83,
+    ERR_FAILED = 0x8F
+};
+
+enum : uint8_t {
+    OP_LOAD = 1, OP_STORE = 2, OP_EXEC = 4
+};
+
+const uint8_t OP_TRAP = 0x02; //fetched instead of the opcode at a checkpoint, see op0x2() in cpu.cpp
+
+enum : uint16_t {
+    BANK_CPU, BANK_RAM, BANK_ROM, BANK_IO, BANKS
+};
+
+const char *const bankNames[BANKS] = {"cpu", "ram", "rom", "io"};
+
+struct tregister {
+    uint8_t id;
+    uint8_t bits;
+    const char *name;
+};
+
+const tregister registers[] = {
+        {0x00, 8,  "A"},
+        {0x01, 8,  "X"},
+        {0x02, 8,  "Y"},
+        {0x03, 16, "PC"},
+        {0x04, 8,  "SP"},
+        {0x05, 8,  "FL"},
+        {0x35, 16, "LIN"},
+        {0x36, 16, "CYC"},
+        {0x37, 8,  "00"},
+        {0x38, 8,  "01"}
+};
+
+const unsigned NUM_REGISTERS = sizeof(registers) / sizeof(registers[0]);
+
+struct tcheckpoint {
+    uint32_t id;
+    uint16_t start;
+    uint16_t end;
+    uint8_t op;
+    bool stop;
+    bool enabled;
+    bool temporary;
+    uint32_t hits;
+    uint32_t ignore;
+};
+
+const unsigned HEADER = 11;    //bytes of a request before the body
+const unsigned MAX_BODY = 256; //MEMORY_SET: only the parameters, the data goes to memory as it comes in
+
+struct {
+    bool connected;
+    bool stopped;
+    bool stopEvent; //the machine stopped, the events are not sent yet
+    bool skip;      //the checkpoints at skipPc don't hit for one instruction, the machine stopped there
+    bool skipArmed;
+    uint16_t skipPc;
+    int parked;     //cycles of the CPU when a trap stopped it
+
+    bool stepping;
+    uint32_t steps;
+    bool stepOver;
+    bool over;      //stepping over a subroutine
+    uint16_t overPc;
+    uint8_t overSp;
+    bool untilReturn;
+    uint8_t returnSp;
+    uint8_t opcode; //at the PC of the last check
+
+    tcheckpoint checkpoints[MONITOR_CHECKPOINTS];
+    unsigned numCheckpoints;
+    uint32_t nextId;
+    bool hit;       //a checkpoint stopped the machine
+    tcheckpoint hitCheckpoint;
+
+    uint8_t marks[3][0x10000 / 8]; //addresses with enabled checkpoints, by op >> 1: load, store, exec
+    uint8_t pageOps[256];          //ops of the checkpoints in each page
+    uint8_t ops;                   //ops of all checkpoints
+    bool trapsChanged; //the tables with the traps must be made again
+    const rarray_t *bankRead; //the tables of the PLA behind the traps
+    const warray_t *bankWrite;
+    rarray_t trapRead;
+    warray_t trapWrite;
+
+    uint8_t request[HEADER + MAX_BODY];
+    uint32_t received;
+    uint32_t address; //MEMORY_SET: where the next byte goes, > 0xFFFF: drop it
+    uint16_t bank;
+} monitor;
+
+/*****************************************************************************************************/
+/* Port **********************************************************************************************/
+/*****************************************************************************************************/
+
+#if MACHINES > 1
+
+int listener = -1;
+int client = -1;
+uint8_t rx[4096];
+unsigned rxLen, rxPos;
+
+void portOpen() {
+    sockaddr_in address{};
+    int one = 1;
+
+    address.sin_family = AF_INET;
+    address.sin_port = htons(MONITOR_TCP);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    listener = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+    setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    if(bind(listener, (sockaddr *) &address, sizeof(address)) != 0 || listen(listener, 1) != 0) {
+        Serial.printf("Monitor: TCP port %d: %s\n", MONITOR_TCP, strerror(errno));
+        close(listener);
+        listener = -1;
+        return;
+    }
+
+    Serial.printf("Monitor on TCP port %d\n", MONITOR_TCP);
+}
+
+void portClose() {
+    close(client);
+    client = -1;
+    rxLen = rxPos = 0;
+}
+
+bool portConnected() {
+    if(client < 0 && listener >= 0) { client = accept(listener, nullptr, nullptr); }
+
+    return client >= 0;
+}
+
+int portRead() {
+    if(client < 0) { return -1; }
+
+    if(rxPos == rxLen) {
+        ssize_t n = recv(client, rx, sizeof(rx), MSG_DONTWAIT);
+
+        if(n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) { return -1; }
+
+        if(n <= 0) {
+            portClose();
+            return -1;
+        }
+
+        rxLen = n;
+        rxPos = 0;
+    }
+
+    return rx[rxPos++];
+}
+
+void portWrite(const uint8_t *data, unsigned len) {
+    while(len && client >= 0) {
+        ssize_t n = send(client, data, len, MSG_NOSIGNAL);
+
+        if(n <= 0) {
+            portClose();
+            return;
+        }
+
+        data += n;
+        len -= n;
+    }
+}
+
+#else
+
+void portOpen() {
+    MONITOR_PORT.begin(115200);
+}
+
+void portClose() {}
+
+bool portConnected() {
+    return MONITOR_PORT;
+}
+
+int portRead() {
+    return MONITOR_PORT.read();
+}
+
+void portWrite(const uint8_t *data, unsigned len) {
+    MONITOR_PORT.write(data, len);
+}
+
+#endif
+
+/*****************************************************************************************************/
+/* Memory ********************************************************************************************/
+/*****************************************************************************************************/
+
+r_ptr_t ioRead(uint8_t page) {
+    if(page < 0xD0 || page > 0xDD) { return page >= 0xD0 && page < 0xE0 ? nullptr : r_ram; }
+    if(page < 0xD4) { return r_vic; }
+    if(page < 0xD8) { return r_sid; }
+    if(page < 0xDC) { return r_col; }
+    return page == 0xDC ? r_cia1 : r_cia2;
+}
+
+w_ptr_t ioWrite(uint8_t page) {
+    if(page < 0xD0 || page > 0xDD) { return page >= 0xD0 && page < 0xE0 ? nullptr : w_ram; }
+    if(page < 0xD4) { return w_vic; }
+    if(page < 0xD8) { return w_sid; }
+    if(page < 0xDC) { return w_col; }
+    return page == 0xDC ? w_cia1 : w_cia2;
+}
+
+//The tables of the PLA without the traps, the monitor itself doesn't hit its checkpoints
+inline const rarray_t &readTable() {
+    return cpu().monitor.traps ? *monitor.bankRead : *cpu().plamap_r;
+}
+
+inline const warray_t &writeTable() {
+    return cpu().monitor.traps ? *monitor.bankWrite : *cpu().plamap_w;
+}
+
+//The original opcode of a ROM byte the emulator patched with a trap, the debugger disassembles the real code
+uint8_t unpatched(uint16_t address, r_ptr_t r, uint8_t value) {
+#if APPLY_PATCHES
+    if(r == r_ker && (address == 0xFFD5 || address == 0xFFD8)) { return 0x4C; } //JMP of LOAD and SAVE
+#if PATCH_BASIC_FP
+    if(r == r_bas && value == 0x32 && basicFPOpcode(address) != 0x02) { return basicFPOpcode(address); }
+#endif
+#if PATCH_KERNAL_EDITOR
+    if(r == r_ker && value == 0x42 && kernalEditorOpcode(address) != 0x02) { return kernalEditorOpcode(address); }
+#endif
+#if PATCH_DECRUNCH
+    if(r == r_ker && address == DECRUNCH_TRAP_ADDRESS) { return 0x6C; } //JMP ($0014) of SYS
+#endif
+#endif
+
+    return value;
+}
+
+uint8_t peek(uint16_t address, uint16_t bank, bool sideEffects) {
+    uint8_t page = address >> 8;
+    r_ptr_t r;
+
+    switch(bank) {
+        case BANK_RAM:
+            return cpu().RAM[address];
+        case BANK_ROM:
+            r = (page >= 0xE0) ? r_ker : (page >= 0xD0) ? r_chr : (page >= 0xA0 && page < 0xC0) ? r_bas : r_ram;
+            break;
+        case BANK_IO:
+            r = ioRead(page);
+            break;
+        default:
+            r = readTable()[page];
+            break;
+    }
+
+    if(r == nullptr) { return 0xFF; } //open I/O
+
+    //the registers as they are, without clearing the interrupt flags or latches
+    if(!sideEffects) {
+        if(r == r_vic) { return cpu().vic.R[address & 0x3F]; }
+        if(r == r_cia1) { return cpu().cia1.R[address & 0x0F]; }
+        if(r == r_cia2) { return cpu().cia2.R[address & 0x0F]; }
+    }
+
+    return unpatched(address, r, r(address));
+}
+
+void poke(uint16_t address, uint16_t bank, uint8_t value) {
+    w_ptr_t w;
+
+    switch(bank) {
+        case BANK_RAM:
+        case BANK_ROM:
+            w = (address < 2) ? writeTable()[0] : w_ram; //$00/$01 are the port of the CPU
+            break;
+        case BANK_IO:
+            w = ioWrite(address >> 8);
+            break;
+        default:
+            w = writeTable()[address >> 8];
+            break;
+    }
+
+    if(w) { w(address, value); }
+}
+
+/*****************************************************************************************************/
+/* Responses *****************************************************************************************/
+/*****************************************************************************************************/
+
+inline void put16(uint8_t *p, uint16_t value) {
+    p[0] = value;
+    p[1] = value >> 8;
+}
+
+inline void put32(uint8_t *p, uint32_t value) {
+    put16(p, value);
+    put16(p + 2, value >> 16);
+}
+
+inline uint16_t get16(const uint8_t *p) {
+    return p[0] | (p[1] << 8);
+}
+
+inline uint32_t get32(const uint8_t *p) {
+    return get16(p) | (get16(p + 2) << 16);
+}
+
+void sendHeader(uint8_t type, uint8_t error, uint32_t id, uint32_t length) {
+    uint8_t header[12] = {STX, API_VERSION};
+
+    put32(&header[2], length);
+    header[6] = type;
+    header[7] = error;
+    put32(&header[8], id);
+
+    portWrite(header, sizeof(header));
+}
+
+void respond(uint8_t type, uint32_t id, uint8_t error = ERR_OK, const uint8_t *body = nullptr, uint32_t length = 0) {
+    sendHeader(type, error, id, length);
+    if(length) { portWrite(body, length); }
+}
+
+void respondCheckpoint(const tcheckpoint &cp, uint32_t id) {
+    uint8_t body[23];
+
+    put32(&body[0], cp.id);
+    body[4] = monitor.stopped && cp.start <= cpu().pc && cpu().pc <= cp.end; //currently hit
+    put16(&body[5], cp.start);
+    put16(&body[7], cp.end);
+    body[9] = cp.stop;
+    body[10] = cp.enabled;
+    body[11] = cp.op;
+    body[12] = cp.temporary;
+    put32(&body[13], cp.hits);
+    put32(&body[17], cp.ignore);
+    body[21] = 0; //no condition
+    body[22] = 0; //main memory
+
+    respond(CMD_CHECKPOINT_GET, id, ERR_OK, body, sizeof(body));
+}
+
+uint16_t registerValue(uint8_t id) {
+    switch(id) {
+        case 0x00: return cpu().a;
+        case 0x01: return cpu().x;
+        case 0x02: return cpu().y;
+        case 0x03: return cpu().pc;
+        case 0x04: return cpu().sp;
+        case 0x05: return cpu().cpustatus;
+        case 0x35: return cpu().vic.rasterLine;
+        case 0x36: return cpu().lineCycles;
+        case 0x37: return cpu().RAM[0];
+        default: return cpu().RAM[1];
+    }
+}
+
+void respondRegisters(uint32_t id) {
+    uint8_t body[2 + NUM_REGISTERS * 4];
+    uint8_t *p = &body[2];
+
+    put16(body, NUM_REGISTERS);
+
+    for(const tregister &r : registers) {
+        p[0] = 3;
+        p[1] = r.id;
+        put16(&p[2], registerValue(r.id));
+        p += 4;
+    }
+
+    respond(CMD_REGISTERS_GET, id, ERR_OK, body, sizeof(body));
+}
+
+void respondPc(uint8_t type) {
+    uint8_t body[2];
+
+    put16(body, cpu().pc);
+    respond(type, EVENT, ERR_OK, body, sizeof(body));
+}
+
+/*****************************************************************************************************/
+/* Running and stopping ******************************************************************************/
+/*****************************************************************************************************/
+
+//Handlers of the pages with checkpoints
+uint8_t r_trap(uint32_t address);
+void w_trap(uint32_t address, uint8_t value);
+
+void setTraps(bool on) {
+    if(cpu().monitor.traps) {
+        cpu().plamap_r = (rarray_t *) monitor.bankRead;
+        cpu().plamap_w = (warray_t *) monitor.bankWrite;
+        cpu().monitor.traps = false;
+    }
+
+    if(on) {
+        cpu().monitor.traps = true;
+        monitorBank();
+    }
+}
+
+void update() {
+    bool traps = monitor.connected && monitor.ops;
+    bool step = monitor.stopped || monitor.stepping || monitor.untilReturn || monitor.skip;
+
+    if(traps != cpu().monitor.traps || monitor.trapsChanged) { setTraps(traps); }
+    monitor.trapsChanged = false;
+
+    cpu().monitor.step = monitor.connected && step;
+    cpu().monitor.active = cpu().monitor.step || traps;
+}
+
+inline bool marked(uint8_t op, uint16_t address) {
+    return monitor.marks[op >> 1][address >> 3] & (1 << (address & 7));
+}
+
+//The bitmaps of the enabled checkpoints
+void updateMarks() {
+    memset(monitor.marks, 0, sizeof(monitor.marks));
+    memset(monitor.pageOps, 0, sizeof(monitor.pageOps));
+    monitor.ops = 0;
+
+    for(unsigned i = 0; i < monitor.numCheckpoints; i++) {
+        const tcheckpoint &cp = monitor.checkpoints[i];
+
+        if(!cp.enabled) { continue; }
+
+        for(uint32_t address = cp.start; address <= cp.end; address++) {
+            for(uint8_t op = OP_LOAD; op <= OP_EXEC; op <<= 1) {
+                if(cp.op & op) { monitor.marks[op >> 1][address >> 3] |= 1 << (address & 7); }
+            }
+            monitor.pageOps[address >> 8] |= cp.op;
+        }
+
+        monitor.ops |= cp.op;
+    }
+
+    monitor.trapsChanged = true;
+}
+
+bool stop() {
+    monitor.stopped = true;
+    monitor.stopEvent = true;
+    monitor.stepping = false;
+    monitor.over = false;
+    monitor.untilReturn = false;
+    cpu().monitor.step = true;
+    cpu().monitor.active = true;
+
+    return true;
+}
+
+void sendStopped() {
+    monitor.stopEvent = false;
+
+    if(monitor.hit) {
+        monitor.hit = false;
+        respondCheckpoint(monitor.hitCheckpoint, EVENT);
+    }
+
+    respondRegisters(EVENT);
+    respondPc(EVENT_STOPPED);
+}
+
+void resume() {
+    monitor.stopped = false;
+    monitor.skip = true;
+    monitor.skipArmed = false;
+    monitor.skipPc = cpu().pc;
+    cpu().clockCycles += monitor.parked;
+    monitor.parked = 0;
+    respondPc(EVENT_RESUMED);
+}
+
+void removeCheckpoint(unsigned i) {
+    monitor.checkpoints[i] = monitor.checkpoints[--monitor.numCheckpoints];
+    updateMarks();
+}
+
+//Checkpoints without stop only log their hits, on the log port (Serial)
+void logHit(const tcheckpoint &cp, uint16_t address, uint8_t op, uint8_t value) {
+    static const char *const names[] = {"load", "store", "exec"};
+
+    Serial.printf("Monitor: checkpoint %u %s $%04X = $%02X, PC $%04X, line %u cycle %u\n", (unsigned) cp.id,
+                  names[op >> 1], address, value, cpu().pc, cpu().vic.rasterLine, cpu().lineCycles);
+}
+
+//The checkpoints on op at address count a hit, true if one of them stops the CPU.
+//Loads and stores stop it at the end of the instruction, execution before the instruction.
+bool checkpoint(uint16_t address, uint8_t op, uint8_t value) {
+    bool stopping = false;
+
+    if(op == OP_EXEC && monitor.skip && address == monitor.skipPc) { return false; }
+
+    for(unsigned i = 0; i < monitor.numCheckpoints; i++) {
+        tcheckpoint &cp = monitor.checkpoints[i];
+
+        if(!cp.enabled || !(cp.op & op) || address < cp.start || address > cp.end) { continue; }
+
+        cp.hits++;
+
+        if(cp.ignore) {
+            cp.ignore--;
+            continue;
+        }
+
+        if(!cp.stop) {
+            logHit(cp, address, op, value);
+            continue;
+        }
+
+        if(stopping) { continue; }
+
+        stopping = true;
+        monitor.hit = true;
+        monitor.hitCheckpoint = cp;
+        if(cp.temporary) { removeCheckpoint(i--); }
+    }
+
+    if(!stopping) { return false; }
+
+    //the loop of cpu_clock() ends, the cycles are for later
+    stop();
+    monitor.parked += cpu().clockCycles;
+    cpu().clockCycles = 0;
+
+    return true;
+}
+
+//An opcode fetch is the read at cpu().pc - 1 while cpu().ticks is still 0
+uint8_t r_trap(uint32_t address) {
+    bool fetch = cpu().ticks == 0 && address == (uint16_t) (cpu().pc - 1);
+
+    if(fetch && marked(OP_EXEC, address) && checkpoint(address, OP_EXEC, OP_TRAP)) {
+        cpu().pc--;
+        return OP_TRAP;
+    }
+
+    uint8_t value = (*monitor.bankRead)[address >> 8](address);
+
+    if(!fetch && marked(OP_LOAD, address)) { checkpoint(address, OP_LOAD, value); }
+
+    return value;
+}
+
+void w_trap(uint32_t address, uint8_t value) {
+    (*monitor.bankWrite)[address >> 8](address, value);
+
+    if(marked(OP_STORE, address)) { checkpoint(address, OP_STORE, value); }
+}
+
+tcheckpoint *findCheckpoint(uint32_t id) {
+    for(unsigned i = 0; i < monitor.numCheckpoints; i++) {
+        if(monitor.checkpoints[i].id == id) { return &monitor.checkpoints[i]; }
+    }
+
+    return nullptr;
+}
+
+//Puts text into the keyboard buffer of the KERNAL, as far as it fits
+void feed(const uint8_t *text, unsigned len) {
+    for(unsigned i = 0; i < len && cpu().RAM[0xC6] < 10; i++) {
+        uint8_t c = text[i];
+
+        if(c == '\n') { c = 13; }
+        else if(c >= 'a' && c <= 'z') { c -= 'a' - 'A'; }
+
+        cpu().RAM[0x277 + cpu().RAM[0xC6]++] = c;
+    }
+}
+
+/*****************************************************************************************************/
+/* Commands ******************************************************************************************/
+/*****************************************************************************************************/
+
+void memoryGet(uint32_t id, const uint8_t *body, uint32_t len) {
+    if(len < 8) { return respond(CMD_MEMORY_GET, id, ERR_LENGTH); }
+
+    uint16_t start = get16(&body[1]);
+    uint16_t end = get16(&body[3]);
+    uint16_t bank = get16(&body[6]);
+
+    if(body[5] != 0) { return respond(CMD_MEMORY_GET, id, ERR_MEMSPACE); }
+    if(end < start || bank >= BANKS) { return respond(CMD_MEMORY_GET, id, ERR_PARAMETER); }
+
+    uint32_t length = end - start + 1;
+    uint8_t chunk[256];
+
+    sendHeader(CMD_MEMORY_GET, ERR_OK, id, 2 + length);
+    put16(chunk, length);
+    portWrite(chunk, 2);
+
+    for(uint32_t address = start; address <= end; address += sizeof(chunk)) {
+        unsigned n = end + 1 - address;
+
+        if(n > sizeof(chunk)) { n = sizeof(chunk); }
+
+
+        for(unsigned i = 0; i < n; i++) { chunk[i] = peek(address + i, bank, body[0]); }
+        portWrite(chunk, n);
+    }
+}
+
+void checkpointSet(uint32_t id, const uint8_t *body, uint32_t len) {
+    if(len < 8) { return respond(CMD_CHECKPOINT_SET, id, ERR_LENGTH); }
+    if(len > 8 && body[8] != 0) { return respond(CMD_CHECKPOINT_SET, id, ERR_MEMSPACE); }
+
+    tcheckpoint cp{};
+
+    cp.start = get16(&body[0]);
+    cp.end = get16(&body[2]);
+    cp.stop = body[4];
+    cp.enabled = body[5];
+    cp.op = body[6];
+    cp.temporary = body[7];
+
+    if(cp.end < cp.start || cp.op == 0 || cp.op > (OP_LOAD | OP_STORE | OP_EXEC)) {
+        return respond(CMD_CHECKPOINT_SET, id, ERR_PARAMETER);
+    }
+    if(monitor.numCheckpoints == MONITOR_CHECKPOINTS) { return respond(CMD_CHECKPOINT_SET, id, ERR_FAILED); }
+
+    cp.id = ++monitor.nextId;
+    monitor.checkpoints[monitor.numCheckpoints++] = cp;
+    updateMarks();
+
+    respondCheckpoint(cp, id);
+}
+
+void registersSet(uint32_t id, const uint8_t *body, uint32_t len) {
+    if(len < 3) { return respond(CMD_REGISTERS_SET, id, ERR_LENGTH); }
+    if(body[0] != 0) { return respond(CMD_REGISTERS_SET, id, ERR_MEMSPACE); }
+
+    const uint8_t *p = &body[3];
+    const uint8_t *pe = body + len;
+
+    for(unsigned n = get16(&body[1]); n > 0; n--, p += p[0] + 1) {
+        if(p + 4 > pe || p[0] < 3) { return respond(CMD_REGISTERS_SET, id, ERR_LENGTH); }
+
+        uint16_t value = get16(&p[2]);
+
+        switch(p[1]) {
+            case 0x00: cpu().a = value; break;
+            case 0x01: cpu().x = value; break;
+            case 0x02: cpu().y = value; break;
+            case 0x03: cpu().pc = value; break;
+            case 0x04: cpu().sp = value; break;
+            case 0x05: cpu().cpustatus = value; break;
+            case 0x37: poke(0, BANK_CPU, value); break;
+            case 0x38: poke(1, BANK_CPU, value); break;
+            default: return respond(CMD_REGISTERS_SET, id, ERR_PARAMETER);
+        }
+    }
+
+    respondRegisters(id);
+}
+
+void banksAvailable(uint32_t id) {
+    uint8_t body[2 + BANKS * 12];
+    uint8_t *p = &body[2];
+
+    put16(body, BANKS);
+
+    for(uint16_t bank = 0; bank < BANKS; bank++) {
+        uint8_t n = strlen(bankNames[bank]);
+
+        p[0] = 3 + n;
+        put16(&p[1], bank);
+        p[3] = n;
+        memcpy(&p[4], bankNames[bank], n);
+        p += 4 + n;
+    }
+
+    respond(CMD_BANKS_AVAILABLE, id, ERR_OK, body, p - body);
+}
+
+void registersAvailable(uint32_t id) {
+    uint8_t body[2 + NUM_REGISTERS * 8];
+    uint8_t *p = &body[2];
+
+    put16(body, NUM_REGISTERS);
+
+    for(const tregister &r : registers) {
+        uint8_t n = strlen(r.name);
+
+        p[0] = 3 + n;
+        p[1] = r.id;
+        p[2] = r.bits;
+        p[3] = n;
+        memcpy(&p[4], r.name, n);
+        p += 4 + n;
+    }
+
+    respond(CMD_REGISTERS_AVAILABLE, id, ERR_OK, body, p - body);
+}
+
+void command(uint8_t type, uint32_t id, const uint8_t *body, uint32_t len) {
+    //like VICE, any command stops the machine until exit
+    if(!monitor.stopped) {
+        stop();
+        sendStopped();
+    }
+
+    switch(type) {
+        case CMD_MEMORY_GET:
+            memoryGet(id, body, len);
+            break;
+
+        case CMD_MEMORY_SET: //the data is already in memory, see receive()
+            respond(type, id, len < 8 ? ERR_LENGTH : body[5] != 0 ? ERR_MEMSPACE
+                                                   : get16(&body[6]) >= BANKS ? ERR_PARAMETER : ERR_OK);
+            break;
+
+        case CMD_CHECKPOINT_GET:
+        case CMD_CHECKPOINT_DELETE:
+        case CMD_CHECKPOINT_TOGGLE: {
+            tcheckpoint *cp = (len >= 4) ? findCheckpoint(get32(body)) : nullptr;
+
+            if(cp == nullptr) {
+                respond(type, id, len < 4 ? ERR_LENGTH : ERR_NOT_FOUND);
+            } else if(type == CMD_CHECKPOINT_GET) {
+                respondCheckpoint(*cp, id);
+            } else if(type == CMD_CHECKPOINT_DELETE) {
+                removeCheckpoint(cp - monitor.checkpoints);
+                respond(type, id);
+            } else if(len < 5) {
+                respond(type, id, ERR_LENGTH);
+            } else {
+                cp->enabled = body[4];
+                updateMarks();
+                respond(type, id);
+            }
+            break;
+        }
+
+        case CMD_CHECKPOINT_SET:
+            checkpointSet(id, body, len);
+            break;
+
+        case CMD_CHECKPOINT_LIST: {
+            uint8_t count[4];
+
+            for(unsigned i = 0; i < monitor.numCheckpoints; i++) { respondCheckpoint(monitor.checkpoints[i], id); }
+
+            put32(count, monitor.numCheckpoints);
+            respond(type, id, ERR_OK, count, sizeof(count));
+            break;
+        }
+
+        case CMD_REGISTERS_GET:
+            if(len >= 1 && body[0] != 0) {
+                respond(type, id, ERR_MEMSPACE);
+            } else {
+                respondRegisters(id);
+            }
+            break;
+
+        case CMD_REGISTERS_SET:
+            registersSet(id, body, len);
+            break;
+
+        case CMD_ADVANCE_INSTRUCTIONS:
+            if(len < 3) { return respond(type, id, ERR_LENGTH); }
+            respond(type, id);
+            resume();
+            monitor.stepping = true;
+            monitor.stepOver = body[0];
+            monitor.steps = get16(&body[1]) ? get16(&body[1]) : 1;
+            break;
+
+        case CMD_EXECUTE_UNTIL_RETURN:
+            respond(type, id);
+            resume();
+            monitor.untilReturn = true;
+            monitor.returnSp = cpu().sp;
+            break;
+
+        case CMD_KEYBOARD_FEED:
+            if(len < 1 || len < 1u + body[0]) { return respond(type, id, ERR_LENGTH); }
+            feed(&body[1], body[0]);
+            respond(type, id);
+            break;
+
+        case CMD_PING:
+            respond(type, id);
+            break;
+
+        case CMD_BANKS_AVAILABLE:
+            banksAvailable(id);
+            break;
+
+        case CMD_REGISTERS_AVAILABLE:
+            registersAvailable(id);
+            break;
+
+        case CMD_VICE_INFO: {
+            const uint8_t body[] = {4, 3, 7, 0, 0, 4, 0, 0, 0, 0};
+            respond(type, id, ERR_OK, body, sizeof(body));
+            break;
+        }
+
+        case CMD_EXIT:
+            respond(type, id);
+            resume();
+            break;
+
+        case CMD_QUIT: //the emulator keeps running, without the client
+            respond(type, id);
+            resume();
+            portClose();
+            break;
+
+        case CMD_RESET:
+            respond(type, id);
+#if MACHINES > 1
+            machineReset();
+            machineBoot();
+#else
+            resetMachine();
+#endif
+            break;
+
+        default:
+            respond(type, id, ERR_COMMAND);
+            break;
+    }
+}
+
+void receive(uint8_t c) {
+    uint8_t *r = monitor.request;
+
+    if(monitor.received == 0 && c != STX) { return; } //out of sync
+
+    if(monitor.received < sizeof(monitor.request)) { r[monitor.received] = c; }
+    monitor.received++;
+
+    if(monitor.received < HEADER) { return; }
+
+    uint32_t len = get32(&r[2]);
+    uint8_t type = r[10];
+
+    //MEMORY_SET: the data goes to memory byte by byte, the parameters are the first 8 bytes
+    if(type == CMD_MEMORY_SET && monitor.received > HEADER + 8) {
+        if(monitor.address <= get16(&r[HEADER + 3])) { poke(monitor.address++, monitor.bank, c); }
+    } else if(type == CMD_MEMORY_SET && monitor.received == HEADER + 8) {
+        bool valid = r[HEADER + 5] == 0 && get16(&r[HEADER + 6]) < BANKS;
+
+        monitor.address = valid ? get16(&r[HEADER + 1]) : 0x10000;
+        monitor.bank = get16(&r[HEADER + 6]);
+        if(!monitor.stopped) { stop(); sendStopped(); }
+    }
+
+    if(monitor.received < HEADER + len) { return; }
+
+    monitor.received = 0;
+
+    if(r[1] == 0 || r[1] > API_VERSION) { return respond(type, get32(&r[6]), ERR_API_VERSION); }
+    if(type != CMD_MEMORY_SET && len > MAX_BODY) { return respond(type, get32(&r[6]), ERR_LENGTH); }
+
+    command(type, get32(&r[6]), &r[HEADER], len);
+}
+
+}
+
+void monitorStart() {
+    monitor.hit = false;
+    portOpen();
+}
+
+bool monitorPoll() {
+    bool connected = portConnected();
+
+    if(connected != monitor.connected) {
+        monitor.connected = connected;
+        monitor.received = 0;
+
+        //the client is gone, the machine runs on, the checkpoints stay for the next one
+        if(!connected) {
+            monitor.stopped = false;
+            monitor.stepping = false;
+            monitor.untilReturn = false;
+            cpu().clockCycles += monitor.parked;
+            monitor.parked = 0;
+        }
+    }
+
+    if(connected) {
+        if(monitor.stopEvent) { sendStopped(); }
+
+        for(int c; (c = portRead()) >= 0;) { receive(c); }
+    }
+
+    update();
+
+    return monitor.stopped;
+}
+
+void monitorBank() {
+    monitor.bankRead = cpu().plamap_r;
+    monitor.bankWrite = cpu().plamap_w;
+
+    for(unsigned page = 0; page < 256; page++) {
+        monitor.trapRead[page] = (monitor.pageOps[page] & (OP_LOAD | OP_EXEC)) ? r_trap : (*cpu().plamap_r)[page];
+        monitor.trapWrite[page] = (monitor.pageOps[page] & OP_STORE) ? w_trap : (*cpu().plamap_w)[page];
+    }
+
+    cpu().plamap_r = &monitor.trapRead;
+    cpu().plamap_w = &monitor.trapWrite;
+}
+
+bool monitorStopped() {
+    return monitor.stopped;
+}
+
+bool monitorInstruction() {
+    if(monitor.stopped) { return true; }
+
+    uint16_t pc = cpu().pc;
+    uint8_t last = monitor.opcode;
+
+    monitor.opcode = peek(pc, BANK_CPU, false);
+
+    //the instruction the machine stopped at is fetched after the first call
+    if(monitor.skip) {
+        if(monitor.skipArmed) {
+            monitor.skip = false;
+            update();
+        }
+        monitor.skipArmed = true;
+    }
+
+    //RTS or RTI out of the subroutine
+    if(monitor.untilReturn && (last == 0x60 || last == 0x40) && (int8_t) (cpu().sp - monitor.returnSp) > 0) {
+        return stop();
+    }
+
+    if(monitor.stepping) {
+        if(monitor.over) {
+            if(pc != monitor.overPc || cpu().sp != monitor.overSp) { return false; }
+            monitor.over = false;
+        }
+
+        if(monitor.steps == 0) { return stop(); }
+
+        monitor.steps--;
+
+        if(monitor.stepOver && monitor.opcode == 0x20) { //JSR
+            monitor.over = true;
+            monitor.overPc = pc + 3;
+            monitor.overSp = cpu().sp;
+        }
+    }
+
+    return false;
+}
+
+#endif
@@ -0,0 +1,99 @@
+/*
+	Copyright Frank Bösing, Karsten Fleischer, 2026
+
+	This file is part of Teensy64.
+
+    Teensy64 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Teensy64 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Teensy64.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von Teensy64.
+
+    Teensy64 ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Teensy64 wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+*/
+
+#pragma once
+
+#ifndef TEENSY64_MONITOR_H
+#define TEENSY64_MONITOR_H
+
+#include "cpu.h"
+
+/*
+  Remote monitor with the binary protocol of VICE (API version 2), so debuggers written
+  for VICE can attach. Enabled with MONITOR 1. It listens on MONITOR_PORT, a USB serial
+  port of its own (build with -DUSB_DUAL_SERIAL, Serial keeps the log), in host builds
+  (MACHINES > 1) on the TCP port MONITOR_TCP of the loopback interface.
+
+  Supported: memory get/set (banks cpu, ram, rom and io), registers get/set, checkpoints
+  (set, get, list, delete, toggle) on execution, load and store, advance instructions (with
+  step over), execute until return, keyboard feed, reset, ping, exit and quit. Other
+  commands are answered with error 0x83. Conditions are not supported.
+
+  Like VICE, the machine stops when a command comes in and runs again with exit. While it
+  is stopped, the line clock does not emulate any lines, the VIC finishes the line of the
+  instruction it stopped at. The native replacements of ROM routines, the loop idioms and
+  the decrunchers are skipped while the monitor watches the CPU, so checkpoints in them hit.
+
+  Checkpoints are bitmaps over the 64 KB, one per operation. Only the pages with checkpoints
+  get a trap in a copy of the read and write tables of the PLA. The trap tests the bitmap and
+  forwards the access to the handler of the PLA (r_ram, w_vic, ...). An opcode fetch at an
+  execution checkpoint stops the CPU before the instruction, a load or store watchpoint at
+  the end of the instruction. Checkpoints without stop write the access with PC, raster line
+  and cycle to Serial. Accesses to other pages run at full speed, no matter how many
+  checkpoints there are, and the CPU loop has no test per instruction for them. Zeropage
+  and stack accesses, which usually bypass the PLA, go through the tables while there
+  are checkpoints (one test per access).
+  cpu_clock() tests each instruction only while the monitor steps or has stopped the
+  machine, else it costs one test per call.
+
+  The monitor works on one machine, the one that calls monitorPoll().
+*/
+
+#if MONITOR
+inline bool monitorActive() { return cpu().monitor.active; } //a client watches the CPU, the fast paths are off
+inline bool monitorStep() { return cpu().monitor.step; }     //cpu_clock() calls monitorInstruction() before each instruction
+inline bool monitorTraps() { return cpu().monitor.traps; }   //cpu().plamap_r/w are the copies with the traps
+#else
+constexpr bool monitorActive() { return false; }
+constexpr bool monitorStep() { return false; }
+constexpr bool monitorTraps() { return false; }
+#endif
+
+// Opens the port.
+void monitorStart();
+
+// Called between raster lines. Handles the commands, true while the machine is stopped.
+bool monitorPoll();
+
+// The machine stopped during the last line, no more lines until monitorPoll() returns false.
+bool monitorStopped();
+
+// Called by cpu_clock() with monitorStep() before the instruction at cpu().pc, true: stop.
+bool monitorInstruction();
+
+// Called by the PLA with monitorTraps() after it has set new tables, puts the traps into them.
+void monitorBank();
+
+#endif // TEENSY64_MONITOR_H
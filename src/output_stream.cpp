@@ -0,0 +1,86 @@
+/*
+	Copyright Frank Bösing, Karsten Fleischer, 2026
+
+	This file is part of Teensy64.
+
+    Teensy64 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Teensy64 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Teensy64.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von Teensy64.
+
+    Teensy64 ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Teensy64 wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+*/
+
+#include <cstring>
+#include "teensy64.h"
+
+#if MACHINES > 1
+
+#include "output_stream.h"
+
+void AudioOutputStream::update() {
+    audio_block_t *in = receiveReadOnly(0); // input 0
+    taudioBlock &out = blocks.slot();
+
+    if(in) {
+        memcpy(out.data, in->data, sizeof(out.data));
+        release(in);
+    } else {
+        memset(out.data, 0, sizeof(out.data)); //silence
+    }
+
+    blocks.publish();
+}
+
+unsigned AudioOutputStream::read(int16_t *samples, unsigned n) {
+    unsigned count = 0;
+
+    while(count < n) {
+        if(block == nullptr || offset == AUDIO_BLOCK_SAMPLES) {
+            const taudioBlock *next = blocks.acquire();
+
+            //nullptr or the last block again: nothing new
+            if(next == nullptr || next == block) { break; }
+
+            block = next;
+            offset = 0;
+        }
+
+        unsigned len = min(n - count, AUDIO_BLOCK_SAMPLES - offset);
+
+        memcpy(&samples[count], &block->data[offset], len * sizeof(int16_t));
+        count += len;
+        offset += len;
+        last = samples[count - 1];
+    }
+
+    int16_t fill = (policy == STREAM_STRETCH) ? last : 0;
+
+    for(unsigned i = count; i < n; i++) { samples[i] = fill; }
+
+    return count;
+}
+
+#endif
@@ -0,0 +1,87 @@
+/*
+	Copyright Frank Bösing, Karsten Fleischer, 2026
+
+	This file is part of Teensy64.
+
+    Teensy64 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Teensy64 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Teensy64.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von Teensy64.
+
+    Teensy64 ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Teensy64 wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+*/
+
+#pragma once
+
+#ifndef TEENSY64_OUTPUT_STREAM_H
+#define TEENSY64_OUTPUT_STREAM_H
+
+#include "Arduino.h"
+#include "AudioStream.h"
+#include "stream.h"
+
+/*
+  Audio output of host builds (MACHINES > 1): instead of the DAC, the blocks of the SID
+  go to a consumer thread, e.g. the sound card or a WAV writer, through a lock-free ring.
+
+    AudioPlaySID sid;
+    AudioOutputStream out(STREAM_STRETCH);
+    AudioConnection patchCord(sid, 0, out, 0);
+
+  The consumer calls read() with the number of samples it needs. If the emulation is too
+  slow, STREAM_STRETCH holds the last sample instead of clicking to silence.
+*/
+
+struct taudioBlock {
+    int16_t data[AUDIO_BLOCK_SAMPLES];
+};
+
+class AudioOutputStream : public AudioStream {
+  public:
+    explicit AudioOutputStream(tstreamPolicy policy) : AudioStream(1, inputQueueArray), policy(policy), blocks(policy) {}
+
+    void update(void) final;
+
+    // Consumer: fills samples with n samples, returns how many came from the SID.
+    unsigned read(int16_t *samples, unsigned n);
+
+    // Consumer: see videoStreamClose().
+    void close() { blocks.close(); }
+
+    uint32_t dropped() const { return blocks.dropped; }
+
+  private:
+    static const unsigned STREAM_BLOCKS = 16; //46 ms at 44.1 kHz
+
+    const tstreamPolicy policy;
+    tstream<taudioBlock, STREAM_BLOCKS> blocks;
+    const taudioBlock *block{}; //the consumer reads this one
+    unsigned offset{};          //in block
+    int16_t last{};             //sample
+
+    audio_block_t *inputQueueArray[1];
+};
+
+#endif // TEENSY64_OUTPUT_STREAM_H
@@ -34,37 +34,37 @@
 */
 
 #include "patches.h"
+#include "warp.h"
 
 #include <cmath>
 
 #define DIRECTORY "/C64/\0"
 
-static FsFile file;
-static FsFile entry;
-static char filename[64];
-static char buffer[2];
-
 void patchLOAD() {
+    FsFile file;
+    FsFile entry;
+    char filename[64];
+    char buffer[2];
     int device;
     int secondaryAddress;
     uint16_t addr;
     uint16_t size;
 
     Serial.println("Patched LOAD");
-    device = cpu.RAM[0xBA];
+    device = cpu().RAM[0xBA];
     if(device != 1) {
         //Jump to unpatched original address:
-        cpu.pc = rom_kernal[cpu.pc - 0xe000 + 1] * 256 + rom_kernal[cpu.pc - 0xe000];
+        cpu().pc = rom_kernal[cpu().pc - 0xe000 + 1] * 256 + rom_kernal[cpu().pc - 0xe000];
         return;
     }
 
     if(!SDinitialized) {
-        cpu.pc = 0xF707; //Device not present error
+        cpu().pc = 0xF707; //Device not present error
         Serial.println("SD Card not initialized");
         return;
     }
 
-    if(cpu.RAM[cpu.RAM[0xBC] * 256 + cpu.RAM[0xBB]] == '$' && cpu.RAM[0xB7] == 1) {
+    if(cpu().RAM[cpu().RAM[0xBC] * 256 + cpu().RAM[0xBB]] == '$' && cpu().RAM[0xB7] == 1) {
         //Directoy listing with LOAD "$"
         Serial.print("Listing of ");
         Serial.println(DIRECTORY);
@@ -73,18 +73,18 @@ void patchLOAD() {
         int blocks;
         uint16_t start;
         int len;
-        addr = cpu.RAM[0x2C] * 256 + cpu.RAM[0x2B];
+        addr = cpu().RAM[0x2C] * 256 + cpu().RAM[0x2B];
 
         /*first line of BASIC listing */
         start = addr;
-        cpu.RAM[addr++] = (start + 30) & 0xff;
-        cpu.RAM[addr++] = (start + 30) >> 8;
+        cpu().RAM[addr++] = (start + 30) & 0xff;
+        cpu().RAM[addr++] = (start + 30) >> 8;
         blocks = 0;
-        cpu.RAM[addr++] = blocks & 0xff;
-        cpu.RAM[addr++] = blocks >> 8;
+        cpu().RAM[addr++] = blocks & 0xff;
+        cpu().RAM[addr++] = blocks >> 8;
 
         const char title[] = "\x12\"TEENSY64        \" FB " VERSION;
-        strcpy((char *) &cpu.RAM[addr], title);
+        strcpy((char *) &cpu().RAM[addr], title);
         addr = start + 30;
 
         while(true) {
@@ -101,51 +101,51 @@ void patchLOAD() {
                 offset = 0;
 
                 //pointer to next line:
-                cpu.RAM[addr++] = (start + 32) & 0xff;
-                cpu.RAM[addr++] = (start + 32) >> 8;
+                cpu().RAM[addr++] = (start + 32) & 0xff;
+                cpu().RAM[addr++] = (start + 32) >> 8;
 
                 //# of blocks
                 blocks = std::ceil((float) entry.size() / 256.0f);
-                cpu.RAM[addr++] = blocks & 0xff;
-                cpu.RAM[addr++] = blocks >> 8;
+                cpu().RAM[addr++] = blocks & 0xff;
+                cpu().RAM[addr++] = blocks >> 8;
 
                 if(blocks < 100) {
-                    cpu.RAM[addr++] = ' ';
+                    cpu().RAM[addr++] = ' ';
                     offset++;
                 }
                 if(blocks < 10) {
-                    cpu.RAM[addr++] = ' ';
+                    cpu().RAM[addr++] = ' ';
                     offset++;
                 }
-                cpu.RAM[addr++] = ' ';
+                cpu().RAM[addr++] = ' ';
 
                 //filename:
-                cpu.RAM[addr++] = '"';
-                char *s = (char *) &cpu.RAM[addr];
+                cpu().RAM[addr++] = '"';
+                char *s = (char *) &cpu().RAM[addr];
                 entry.getName(s, 17);
                 while(*s) {
                     *s = toupper(*s);
                     s++;
                 }
-                //strcpy((char * )&cpu.RAM[addr], entry.name());
-                len = strlen((char *) &cpu.RAM[addr]);
+                //strcpy((char * )&cpu().RAM[addr], entry.name());
+                len = strlen((char *) &cpu().RAM[addr]);
 
                 if(len > 16) { len = 16; }
                 addr += len;
-                cpu.RAM[addr++] = '"';
+                cpu().RAM[addr++] = '"';
 
                 //fill with space
-                while((addr - start) < (32)) { cpu.RAM[addr++] = ' '; }
+                while((addr - start) < (32)) { cpu().RAM[addr++] = ' '; }
 
                 //display "PRG"
                 addr = start + 23 + offset;
-                cpu.RAM[addr++] = ' ';
-                cpu.RAM[addr++] = 'P';
-                cpu.RAM[addr++] = 'R';
-                cpu.RAM[addr++] = 'G';
+                cpu().RAM[addr++] = ' ';
+                cpu().RAM[addr++] = 'P';
+                cpu().RAM[addr++] = 'R';
+                cpu().RAM[addr++] = 'G';
 
                 //line-ending
-                cpu.RAM[start + 31] = 0;
+                cpu().RAM[start + 31] = 0;
                 addr = start + 32;
 
                 /* Listing to serial console */
@@ -175,26 +175,26 @@ void patchLOAD() {
 
         /*add last line to BASIC listing*/
         start = addr;
-        cpu.RAM[addr++] = (start + 32) & 0xff;
-        cpu.RAM[addr++] = (start + 32) >> 8;
+        cpu().RAM[addr++] = (start + 32) & 0xff;
+        cpu().RAM[addr++] = (start + 32) >> 8;
         //# of blocks. todo : determine free space on sd card
         blocks = 65535; // This makes the following if conditions always false
-        cpu.RAM[addr++] = blocks & 0xff;
-        cpu.RAM[addr++] = blocks >> 8;
-        if(blocks < 100) { cpu.RAM[addr++] = ' '; }
-        if(blocks < 10) { cpu.RAM[addr++] = ' '; }
+        cpu().RAM[addr++] = blocks & 0xff;
+        cpu().RAM[addr++] = blocks >> 8;
+        if(blocks < 100) { cpu().RAM[addr++] = ' '; }
+        if(blocks < 10) { cpu().RAM[addr++] = ' '; }
         const char blockfree[] = "BLOCKS FREE.";
 
-        strcpy((char *) &cpu.RAM[addr], blockfree);
+        strcpy((char *) &cpu().RAM[addr], blockfree);
         len = strlen(blockfree);
         addr += len;
-        while((addr - start) < (32)) { cpu.RAM[addr++] = ' '; }
-        cpu.RAM[start + 31] = 0;
-        cpu.RAM[start + 32] = 0;
-        cpu.RAM[start + 33] = 0;
+        while((addr - start) < (32)) { cpu().RAM[addr++] = ' '; }
+        cpu().RAM[start + 31] = 0;
+        cpu().RAM[start + 32] = 0;
+        cpu().RAM[start + 33] = 0;
 
-        cpu.y = 0x49; //Offset for "LOADING"
-        cpu.pc = 0xF12B; //Print and return
+        cpu().y = 0x49; //Offset for "LOADING"
+        cpu().pc = 0xF12B; //Print and return
         return;
     } // end directory listing
 
@@ -203,8 +203,8 @@ void patchLOAD() {
     //$BB-$BC: Pointer to current file name or disk command
     memset(filename, 0, sizeof(filename));
     strcpy(filename, DIRECTORY);
-    strncat(filename, (char *) &cpu.RAM[cpu.RAM[0xBC] * 256 + cpu.RAM[0xBB]], cpu.RAM[0xB7]);
-    secondaryAddress = cpu.RAM[0xB9];
+    strncat(filename, (char *) &cpu().RAM[cpu().RAM[0xBC] * 256 + cpu().RAM[0xBB]], cpu().RAM[0xB7]);
+    secondaryAddress = cpu().RAM[0xB9];
 
     Serial.print(filename);
     Serial.print(",");
@@ -216,46 +216,54 @@ void patchLOAD() {
     file = SD.open(filename, FILE_READ);
     if(!file) {
         Serial.println("not found.");
-        cpu.pc = 0xf530; //Jump to $F530
+        cpu().pc = 0xf530; //Jump to $F530
         return;
     }
 
     size = file.size();
     file.read(buffer, 2);
     addr = buffer[1] * 256 + buffer[0];
-    file.read(&cpu.RAM[addr], size - 2);
+    file.read(&cpu().RAM[addr], size - 2);
     file.close();
 
-    cpu.RAM[0xAF] = (addr + size - 2) & 0xff;
-    cpu.RAM[0xAE] = (addr + size - 2) / 256;
+    cpu().RAM[0xAF] = (addr + size - 2) & 0xff;
+    cpu().RAM[0xAE] = (addr + size - 2) / 256;
 
-    cpu.y = 0x49; //Offset for "LOADING"
-    cpu.pc = 0xF12B; //Print and return
+    cpu().y = 0x49; //Offset for "LOADING"
+    cpu().pc = 0xF12B; //Print and return
     Serial.println("loaded.");
+
+#if WARP_AUTO
+    //LOAD in direct mode (KERNAL messages on), not by a running program
+    if(cpu().RAM[0x9D] & 0x80) { warpOn(true); }
+#endif
 }
 
 void patchSAVE() {
+    FsFile file;
+    char filename[64];
+    char buffer[2];
     int device;
     int secondaryAddress;
     uint16_t addr;
     uint16_t size;
 
     Serial.println("Patched SAVE");
-    device = cpu.RAM[0xBA];
+    device = cpu().RAM[0xBA];
     if(device != 1) {
         //Jump to unpatched original address:
-        cpu.pc = rom_kernal[cpu.pc - 0xe000 + 1] * 256 + rom_kernal[cpu.pc - 0xe000];
+        cpu().pc = rom_kernal[cpu().pc - 0xe000 + 1] * 256 + rom_kernal[cpu().pc - 0xe000];
         return;
     }
 
     if(!SDinitialized) {
-        cpu.pc = 0xF707; //Device not present error
+        cpu().pc = 0xF707; //Device not present error
         Serial.println("SD Card not initialized");
         return;
     }
 
     if(!SD.exists(DIRECTORY) && SD.mkdir(DIRECTORY)) {
-        cpu.pc = 0xF707; //Device not present error
+        cpu().pc = 0xF707; //Device not present error
         Serial.println("SD: Could not create " DIRECTORY);
     }
 
@@ -263,9 +271,9 @@ void patchSAVE() {
     //$BB-$BC: Pointer to current file name or disk command
     memset(filename, 0, sizeof(filename));
     strcpy(filename, DIRECTORY);
-    strncat(filename, (char *) &cpu.RAM[cpu.RAM[0xBC] * 256 + cpu.RAM[0xBB]], cpu.RAM[0xB7]);
+    strncat(filename, (char *) &cpu().RAM[cpu().RAM[0xBC] * 256 + cpu().RAM[0xBB]], cpu().RAM[0xB7]);
 
-    secondaryAddress = cpu.RAM[0xB9];
+    secondaryAddress = cpu().RAM[0xB9];
 
     Serial.print(filename);
     Serial.print(",");
@@ -274,8 +282,8 @@ void patchSAVE() {
     Serial.print(secondaryAddress);
     Serial.print(":");
 
-    addr = cpu.RAM[cpu.a + 1] * 256 + cpu.RAM[cpu.a];
-    size = (cpu.y * 256 + cpu.x) - addr;
+    addr = cpu().RAM[cpu().a + 1] * 256 + cpu().RAM[cpu().a];
+    size = (cpu().y * 256 + cpu().x) - addr;
 
     buffer[0] = addr & 0xff;
     buffer[1] = addr >> 8;
@@ -284,23 +292,23 @@ void patchSAVE() {
     file = SD.open(filename, FILE_WRITE);
     if(!file) {
         Serial.println("not possible.");
-        cpu.pc = 0xf530; //Jump to $F530
+        cpu().pc = 0xf530; //Jump to $F530
         return;
     }
     file.write(buffer, 2);
-    file.write(&cpu.RAM[addr], size);
+    file.write(&cpu().RAM[addr], size);
     file.close();
 
-    if(cpu.RAM[0x9D] & 128) {
+    if(cpu().RAM[0x9D] & 128) {
         uint16_t pushval = 0xF68D;
-        cpu.RAM[BASE_STACK + cpu.sp] = (pushval >> 8) & 0xFF;
-        cpu.RAM[BASE_STACK + ((cpu.sp - 1) & 0xFF)] = pushval & 0xFF;
-        cpu.sp -= 2;
+        cpu().RAM[BASE_STACK + cpu().sp] = (pushval >> 8) & 0xFF;
+        cpu().RAM[BASE_STACK + ((cpu().sp - 1) & 0xFF)] = pushval & 0xFF;
+        cpu().sp -= 2;
 
-        cpu.y = 0x51;
-        cpu.pc = 0xF12F;
+        cpu().y = 0x51;
+        cpu().pc = 0xF12F;
     } else {
-        cpu.pc = 0xF68D;
+        cpu().pc = 0xF68D;
     }
 
     Serial.println("saved.");
@@ -39,13 +39,24 @@
 #include "pla.h"
 #include "cia1.h"
 #include "cia2.h"
+#include "monitor.h"
+#include "counters.h"
 
 
 extern const rarray_t PLA_READ[8];
 extern const warray_t PLA_WRITE[8];
 
+//All changes of the memory configuration go here
+static inline void setBank(const rarray_t *r, const warray_t *w) {
+    cpu().plamap_r = (rarray_t *) r;
+    cpu().plamap_w = (warray_t *) w;
+#if MONITOR
+    if(monitorTraps()) { monitorBank(); } //the monitor puts its traps into the new tables
+#endif
+}
+
 uint8_t r_ram(uint32_t address) {
-    return cpu.RAM[address];
+    return cpu().RAM[address];
 }
 
 uint8_t r_bas(uint32_t address) {
@@ -58,30 +69,35 @@ uint8_t r_chr(uint32_t address) {
     return rom_characters[address & (sizeof(rom_characters) - 1)];
 } //CHARACTER ROM
 uint8_t r_vic(uint32_t address) {
-    return cpu.vic.read(address);
+    COUNT(reads[DEVICE_VIC]);
+    return cpu().vic.read(address);
 }
 
 uint8_t r_sid(uint32_t address) {
-    return playSID.getreg(address & 0x1F);
+    COUNT(reads[DEVICE_SID]);
+    return cpu().sidChip ? cpu().sidChip->getreg(address & 0x1F) : 0;
 }
 
 uint8_t r_col(uint32_t address) {
-    return cpu.vic.colorRAM[address & 0x3FF];
+    COUNT(reads[DEVICE_COL]);
+    return cpu().vic.colorRAM[address & 0x3FF];
 }
 
 uint8_t r_cia1(uint32_t address) {
+    COUNT(reads[DEVICE_CIA1]);
     return cia1_read(address);
 }
 
 uint8_t r_cia2(uint32_t address) {
+    COUNT(reads[DEVICE_CIA2]);
     return cia2_read(address);
 }
 
 uint8_t r_crtL(uint32_t address) {
-    return cpu.cartrigeLO[address & 0x1fff];
+    return cpu().cartrigeLO[address & 0x1fff];
 } //Cartrige Low ($8000)
 uint8_t r_crtH(uint32_t address) {
-    return cpu.cartrigeHI[address & 0x1fff];
+    return cpu().cartrigeHI[address & 0x1fff];
 }
 
 uint8_t r_nul(uint32_t address) {
@@ -92,35 +108,40 @@ uint8_t r_rnd(uint32_t address) {
 } //Random for $DE00-$DFFF
 
 void w_ram(uint32_t address, uint8_t value) {
-    cpu.RAM[address] = value;
+    cpu().RAM[address] = value;
 }
 
 void w_ramz(uint32_t address, uint8_t value) {
-    cpu.RAM[address] = value;  //zeropage
+    cpu().RAM[address] = value;  //zeropage
     if(address == 1) {    //6510 Port
         value &= 0x07;
-        cpu.plamap_r = (rarray_t *) &PLA_READ[value];
-        cpu.plamap_w = (warray_t *) &PLA_WRITE[value];
+        setBank(&PLA_READ[value], &PLA_WRITE[value]);
     }
 }
 
 void w_vic(uint32_t address, uint8_t value) {
-    cpu.vic.write(address, value);
+    COUNT(writes[DEVICE_VIC]);
+    cpu().vic.write(address, value);
 }
 
 void w_col(uint32_t address, uint8_t value) {
-    cpu.vic.colorRAM[address & 0x3FF] = value & 0x0F;
+    COUNT(writes[DEVICE_COL]);
+    cpu().vic.colorRAM[address & 0x3FF] = value & 0x0F;
 }
 
 void w_sid(uint32_t address, uint8_t value) {
-    playSID.setreg(address & 0x1F, value);
+    COUNT(writes[DEVICE_SID]);
+    cpu().sid[address & 0x1F] = value;
+    if(cpu().sidChip) { cpu().sidChip->setreg(address & 0x1F, value); }
 }
 
 void w_cia1(uint32_t address, uint8_t value) {
+    COUNT(writes[DEVICE_CIA1]);
     cia1_write(address, value);
 }
 
 void w_cia2(uint32_t address, uint8_t value) {
+    COUNT(writes[DEVICE_CIA2]);
     cia2_write(address, value);
 }
 
@@ -1141,15 +1162,15 @@ void resetPLA() {
     const char pattern2 = 0xff;
     const char patternLength = 0x40;
 
-    while(i <= (sizeof(cpu.RAM) - patternLength * 2)) {
-        memset(&cpu.RAM[i], pattern1, patternLength);
+    while(i <= (sizeof(cpu().RAM) - patternLength * 2)) {
+        memset(&cpu().RAM[i], pattern1, patternLength);
         i += patternLength;
-        memset(&cpu.RAM[i], pattern2, patternLength);
+        memset(&cpu().RAM[i], pattern2, patternLength);
         i += patternLength;
     }
 
-    cpu.RAM[0] = 0x2F;
-    cpu.RAM[1] = 0x1F;
+    cpu().RAM[0] = 0x2F;
+    cpu().RAM[1] = 0x1F;
 
 /* Cartriges :
 Normal   8kB cartridge at $8000       (ROML):      GAME = 1, EXROM = 0
@@ -1157,24 +1178,20 @@ Normal  16kB cartridge at $8000/$a000 (ROML,ROMH): GAME = 0, EXROM = 0
 Ultimax 16kB cartridge at $8000/$e000 (ROML,ROMH): GAME = 0, EXROM = 1
 */
 #if 1 //No Cartrige
-    cpu._game = 1;
-    cpu._exrom = 1;
+    cpu()._game = 1;
+    cpu()._exrom = 1;
 #else //TODO...
-                                                                                                                            cpu._game = 0;
-	cpu._exrom = 0;
+                                                                                                                            cpu()._game = 0;
+	cpu()._exrom = 0;
 #endif
 
-    if(cpu._game == 1 && cpu._exrom == 0) {
-        cpu.plamap_r = (rarray_t *) &PLA_READ_CARTRIGE_10[0x07];
-        cpu.plamap_w = (warray_t *) &PLA_WRITE[0x07];
-    } else if(cpu._game == 0 && cpu._exrom == 0) {
-        cpu.plamap_r = (rarray_t *) &PLA_READ_CARTRIGE_00[0x07];
-        cpu.plamap_w = (warray_t *) &PLA_WRITE[0x07];
-    } else if(cpu._game == 0 && cpu._exrom == 1) {
-        cpu.plamap_r = (rarray_t *) &PLA_READ_CARTRIGE_00[0x07];
-        cpu.plamap_w = (warray_t *) &PLA_WRITE[0x07];
+    if(cpu()._game == 1 && cpu()._exrom == 0) {
+        setBank(&PLA_READ_CARTRIGE_10[0x07], &PLA_WRITE[0x07]);
+    } else if(cpu()._game == 0 && cpu()._exrom == 0) {
+        setBank(&PLA_READ_CARTRIGE_00[0x07], &PLA_WRITE[0x07]);
+    } else if(cpu()._game == 0 && cpu()._exrom == 1) {
+        setBank(&PLA_READ_CARTRIGE_00[0x07], &PLA_WRITE[0x07]);
     } else { //C64 without Cartridge
-        cpu.plamap_r = (rarray_t *) &PLA_READ[0x07];
-        cpu.plamap_w = (warray_t *) &PLA_WRITE[0x07];
+        setBank(&PLA_READ[0x07], &PLA_WRITE[0x07]);
     }
 }
\ No newline at end of file
@@ -52,4 +52,20 @@ typedef warray_t *w_rarr_ptr_t;
 
 void resetPLA();
 
+uint8_t r_ram(uint32_t address);
+uint8_t r_bas(uint32_t address); //BASIC ROM
+uint8_t r_ker(uint32_t address); //KERNAL ROM
+uint8_t r_chr(uint32_t address); //CHARACTER ROM
+uint8_t r_vic(uint32_t address);
+uint8_t r_sid(uint32_t address);
+uint8_t r_col(uint32_t address); //colour RAM
+uint8_t r_cia1(uint32_t address);
+uint8_t r_cia2(uint32_t address);
+void w_ram(uint32_t address, uint8_t value);
+void w_vic(uint32_t address, uint8_t value);
+void w_sid(uint32_t address, uint8_t value);
+void w_col(uint32_t address, uint8_t value);
+void w_cia1(uint32_t address, uint8_t value);
+void w_cia2(uint32_t address, uint8_t value);
+
 #endif // TEENSY64_PLA_H
\ No newline at end of file
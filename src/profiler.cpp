@@ -0,0 +1,429 @@
+/*
+	Copyright Frank Bösing, Karsten Fleischer, 2026
+
+	This file is part of Teensy64.
+
+    Teensy64 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Teensy64 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Teensy64.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von Teensy64.
+
+    Teensy64 ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Teensy64 wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+*/
+
+#include <cstring>
+#include "settings.h"
+
+#if PROFILER
+
+#include "teensy64.h"
+#include "pla.h"
+#include "profiler.h"
+
+namespace {
+
+struct tsymbol {
+    uint16_t address;
+    const char *name;
+};
+
+//Entry points of BASIC and KERNAL, sorted by address
+const tsymbol romSymbols[] = {
+        {0xA000, "BASIC vectors"},
+        {0xA408, "REASON check memory"},
+        {0xA437, "ERROR"},
+        {0xA474, "READY"},
+        {0xA480, "MAIN input loop"},
+        {0xA49C, "MAIN1 store line"},
+        {0xA533, "LNKPRG relink lines"},
+        {0xA560, "INLIN input line"},
+        {0xA579, "CRUNCH tokenize"},
+        {0xA613, "FNDLIN find line"},
+        {0xA642, "NEW"},
+        {0xA65E, "CLR"},
+        {0xA68E, "STXPT"},
+        {0xA69C, "LIST"},
+        {0xA742, "FOR"},
+        {0xA7AE, "NEWSTT next statement"},
+        {0xA7E4, "GONE execute statement"},
+        {0xA81D, "RESTORE"},
+        {0xA82C, "ISCNTC test STOP"},
+        {0xA831, "END"},
+        {0xA857, "CONT"},
+        {0xA871, "RUN"},
+        {0xA883, "GOSUB"},
+        {0xA8A0, "GOTO"},
+        {0xA8D2, "RETURN"},
+        {0xA8F8, "DATA"},
+        {0xA906, "DATAN end of statement"},
+        {0xA928, "IF"},
+        {0xA93B, "REM"},
+        {0xA94B, "ON"},
+        {0xA96B, "LINGET line number"},
+        {0xA9A5, "LET"},
+        {0xAA80, "PRINT#"},
+        {0xAA86, "CMD"},
+        {0xAAA0, "PRINT"},
+        {0xAB1E, "STROUT"},
+        {0xAB47, "OUTDO"},
+        {0xAB7B, "GET"},
+        {0xABA5, "INPUT#"},
+        {0xABBF, "INPUT"},
+        {0xAC06, "READ"},
+        {0xAD1E, "NEXT"},
+        {0xAD8A, "FRMNUM"},
+        {0xAD9E, "FRMEVL evaluate expression"},
+        {0xAE83, "EVAL evaluate term"},
+        {0xAEF1, "PARCHK"},
+        {0xB08B, "PTRGET find variable"},
+        {0xB1BF, "AYINT"},
+        {0xB391, "GIVAYF"},
+        {0xB3A6, "ERRDIR"},
+        {0xB3B3, "DEF"},
+        {0xB465, "STR$"},
+        {0xB487, "STRLIT"},
+        {0xB4F4, "GETSPA string space"},
+        {0xB526, "GARBAG garbage collection"},
+        {0xB63D, "CAT concatenate"},
+        {0xB6A3, "FRESTR"},
+        {0xB6EC, "CHR$"},
+        {0xB700, "LEFT$"},
+        {0xB72C, "RIGHT$"},
+        {0xB737, "MID$"},
+        {0xB77C, "LEN"},
+        {0xB78B, "ASC"},
+        {0xB7AD, "VAL"},
+        {0xB7EB, "GETNUM"},
+        {0xB7F7, "GETADR"},
+        {0xB80D, "PEEK"},
+        {0xB824, "POKE"},
+        {0xB82D, "WAIT"},
+        {0xB849, "FADDH"},
+        {0xB850, "FSUB"},
+        {0xB867, "FADD"},
+        {0xB9EA, "LOG"},
+        {0xBA28, "FMULT"},
+        {0xBAE2, "MUL10"},
+        {0xBB12, "FDIV"},
+        {0xBBA2, "MOVFM"},
+        {0xBBD4, "MOVMF"},
+        {0xBC0C, "MOVAF"},
+        {0xBC1B, "ROUND"},
+        {0xBC39, "SGN"},
+        {0xBC58, "ABS"},
+        {0xBC5B, "FCOMP"},
+        {0xBC9B, "QINT"},
+        {0xBCCC, "INT"},
+        {0xBCF3, "FIN string to float"},
+        {0xBDCD, "LINPRT"},
+        {0xBDDD, "FOUT float to string"},
+        {0xBF71, "SQR"},
+        {0xBF7B, "FPWRT power"},
+        {0xBFB4, "NEGOP"},
+        {0xBFED, "EXP"},
+        {0xE043, "POLY1"},
+        {0xE097, "RND"},
+        {0xE12A, "SYS"},
+        {0xE156, "SAVE (BASIC)"},
+        {0xE165, "VERIFY (BASIC)"},
+        {0xE168, "LOAD (BASIC)"},
+        {0xE1BE, "OPEN (BASIC)"},
+        {0xE1C7, "CLOSE (BASIC)"},
+        {0xE264, "COS"},
+        {0xE26B, "SIN"},
+        {0xE2B4, "TAN"},
+        {0xE30E, "ATN"},
+        {0xE37B, "BASIC warm start"},
+        {0xE394, "BASIC cold start"},
+        {0xE518, "screen init"},
+        {0xE544, "clear screen"},
+        {0xE566, "home cursor"},
+        {0xE56C, "set screen pointers"},
+        {0xE5A0, "init VIC"},
+        {0xE5B4, "get key from buffer"},
+        {0xE5CA, "wait for key"},
+        {0xE632, "input from screen"},
+        {0xE684, "quote test"},
+        {0xE716, "print to screen"},
+        {0xE87C, "next line"},
+        {0xE891, "return"},
+        {0xE8EA, "scroll screen"},
+        {0xE965, "insert line"},
+        {0xE9FF, "clear screen line"},
+        {0xEA13, "set char and colour"},
+        {0xEA24, "colour pointer"},
+        {0xEA31, "IRQ handler"},
+        {0xEA87, "SCNKEY"},
+        {0xED09, "TALK"},
+        {0xED0C, "LISTEN"},
+        {0xED40, "serial send byte"},
+        {0xEDB9, "SECOND"},
+        {0xEDC7, "TKSA"},
+        {0xEDDD, "CIOUT"},
+        {0xEDEF, "UNTLK"},
+        {0xEDFE, "UNLSN"},
+        {0xEE13, "ACPTR"},
+        {0xF13E, "GETIN"},
+        {0xF157, "CHRIN"},
+        {0xF1CA, "CHROUT"},
+        {0xF20E, "CHKIN"},
+        {0xF250, "CHKOUT"},
+        {0xF291, "CLOSE"},
+        {0xF32F, "CLALL"},
+        {0xF333, "CLRCHN"},
+        {0xF34A, "OPEN"},
+        {0xF49E, "LOAD"},
+        {0xF5DD, "SAVE"},
+        {0xF69B, "UDTIM"},
+        {0xF6DD, "RDTIM"},
+        {0xF6E4, "SETTIM"},
+        {0xF6ED, "STOP"},
+        {0xFCE2, "reset"},
+        {0xFD15, "RESTOR"},
+        {0xFD50, "RAMTAS"},
+        {0xFDA3, "IOINIT"},
+        {0xFE43, "NMI handler"},
+        {0xFE66, "BRK handler"},
+        {0xFEBC, "IRQ exit"},
+        {0xFF48, "IRQ entry"},
+        {0xFF81, "jump table"},
+};
+
+const unsigned NUM_ROM_SYMBOLS = sizeof(romSymbols) / sizeof(romSymbols[0]);
+const unsigned MAX_SYMBOLS = 256;  //of the label file
+const unsigned MAX_NAME = 24;
+const unsigned BUCKET_SIZE = 1 << PROFILER_SHIFT;
+//The label file, as of the last report
+struct {
+    tsymbol table[MAX_SYMBOLS]; //sorted by address
+    char names[MAX_SYMBOLS][MAX_NAME];
+    unsigned count;
+} symbols;
+
+volatile bool request = false;
+
+inline unsigned romBucket(uint16_t address) {
+    return ((address & 0x1FFF) | ((address & 0x4000) >> 1)) >> PROFILER_SHIFT;
+}
+
+inline uint16_t romAddress(unsigned bucket) {
+    unsigned offset = bucket << PROFILER_SHIFT;
+
+    return (offset < 0x2000) ? 0xA000 + offset : 0xE000 + offset - 0x2000;
+}
+
+int hexDigit(char c) {
+    if(c >= '0' && c <= '9') { return c - '0'; }
+    if(c >= 'a' && c <= 'f') { return c - 'a' + 10; }
+    if(c >= 'A' && c <= 'F') { return c - 'A' + 10; }
+    return -1;
+}
+
+//One line of a label file: "al C:0810 .main", the "C:" is optional
+void addSymbol(const char *line) {
+    unsigned address = 0;
+    int digits = 0;
+
+    if(strncmp(line, "al ", 3) != 0 || symbols.count == MAX_SYMBOLS) { return; }
+    line += 3;
+    if(line[0] == 'C' && line[1] == ':') { line += 2; }
+
+    for(int d; (d = hexDigit(*line)) >= 0; line++, digits++) { address = (address << 4) | d; }
+    if(digits == 0 || digits > 4) { return; }
+
+    while(*line == ' ' || *line == '\t') { line++; }
+    if(*line == '.') { line++; }
+    if(*line == 0) { return; }
+
+    char *name = symbols.names[symbols.count];
+
+    strncpy(name, line, MAX_NAME - 1);
+    name[MAX_NAME - 1] = 0;
+    name[strcspn(name, " \t\r\n")] = 0;
+
+    //insertion sort, the files are small
+    unsigned i = symbols.count++;
+
+    for(; i > 0 && symbols.table[i - 1].address > address; i--) { symbols.table[i] = symbols.table[i - 1]; }
+    symbols.table[i] = {(uint16_t) address, name};
+}
+
+void loadSymbols(const char *filename) {
+    symbols.count = 0;
+
+    if(!SDinitialized) { return; }
+
+    FsFile file = SD.open(filename, FILE_READ);
+
+    if(!file) { return; }
+
+    char line[80];
+    unsigned len = 0;
+    char c;
+
+    while(file.read(&c, 1) == 1) {
+        if(c == '\n') {
+            line[len] = 0;
+            addSymbol(line);
+            len = 0;
+        } else if(len < sizeof(line) - 1) {
+            line[len++] = c;
+        }
+    }
+
+    line[len] = 0;
+    addSymbol(line);
+    file.close();
+}
+
+//The last symbol at or below address, nullptr if there is none
+const tsymbol *findSymbol(const tsymbol *table, unsigned count, uint16_t address) {
+    const tsymbol *found = nullptr;
+    int lo = 0, hi = (int) count - 1;
+
+    while(lo <= hi) {
+        int mid = (lo + hi) / 2;
+
+        if(table[mid].address <= address) {
+            found = &table[mid];
+            lo = mid + 1;
+        } else {
+            hi = mid - 1;
+        }
+    }
+
+    return found;
+}
+
+}
+
+void profilerSample() {
+    tprofile &profile = cpu().profile;
+
+    cpu().profilerCountdown += PROFILER_INTERVAL;
+
+    uint16_t pc = cpu().pc;
+    r_ptr_t r = (*cpu().plamap_r)[pc >> 8]; //the bank at the PC
+
+    if(r == r_bas || r == r_ker) {
+        profile.rom[romBucket(pc)]++;
+    } else if(r == r_ram) {
+        profile.ram[pc >> PROFILER_SHIFT]++;
+    } else {
+        profile.io++;
+    }
+
+    profile.samples++;
+}
+
+void profilerRequest() {
+    request = true;
+}
+
+void profilerPoll() {
+    if(!request) { return; }
+
+    request = false;
+    profilerReport(PROFILER_TOP);
+}
+
+void profilerReport(unsigned top) {
+    static uint32_t romCounts[NUM_ROM_SYMBOLS];
+    static uint32_t symbolCounts[MAX_SYMBOLS];
+    tprofile &profile = cpu().profile;
+
+    loadSymbols(PROFILER_SYMBOLS);
+
+    memset(romCounts, 0, sizeof(romCounts));
+    memset(symbolCounts, 0, sizeof(symbolCounts));
+
+    //buckets with a symbol count for the last symbol that starts in them or before them,
+    //the others stay as they are
+    for(unsigned bucket = 0; bucket < PROFILER_ROM_BUCKETS; bucket++) {
+        const tsymbol *s = findSymbol(romSymbols, NUM_ROM_SYMBOLS, romAddress(bucket) + BUCKET_SIZE - 1);
+
+        if(s) {
+            romCounts[s - romSymbols] += profile.rom[bucket];
+            profile.rom[bucket] = 0;
+        }
+    }
+
+    for(unsigned bucket = 0; bucket < PROFILER_RAM_BUCKETS; bucket++) {
+        const tsymbol *s = findSymbol(symbols.table, symbols.count, (bucket << PROFILER_SHIFT) + BUCKET_SIZE - 1);
+
+        if(s) {
+            symbolCounts[s - symbols.table] += profile.ram[bucket];
+            profile.ram[bucket] = 0;
+        }
+    }
+
+    Serial.printf("Profile: %u samples, one every %u cycles\n", (unsigned) profile.samples, PROFILER_INTERVAL);
+
+    //top times the largest count of all lists
+    for(unsigned n = 0; n < top; n++) {
+        uint32_t *max = &profile.io;
+        uint16_t address = 0xD000;
+        const char *where = "I/O";
+        const char *name = "";
+
+        for(unsigned i = 0; i < NUM_ROM_SYMBOLS; i++) {
+            if(romCounts[i] > *max) {
+                max = &romCounts[i];
+                address = romSymbols[i].address;
+                where = "ROM";
+                name = romSymbols[i].name;
+            }
+        }
+
+        for(unsigned i = 0; i < symbols.count; i++) {
+            if(symbolCounts[i] > *max) {
+                max = &symbolCounts[i];
+                address = symbols.table[i].address;
+                where = "RAM";
+                name = symbols.table[i].name;
+            }
+        }
+
+        for(unsigned bucket = 0; bucket < PROFILER_RAM_BUCKETS; bucket++) {
+            if(profile.ram[bucket] > *max) {
+                max = &profile.ram[bucket];
+                address = bucket << PROFILER_SHIFT;
+                where = "RAM";
+                name = "";
+            }
+        }
+
+        if(*max == 0) { break; }
+
+        unsigned permille = (uint64_t) *max * 1000 / profile.samples;
+
+        Serial.printf("%3u.%u%% %8u  $%04X %s %s\n", permille / 10, permille % 10, (unsigned) *max, address, where, name);
+        *max = 0;
+    }
+
+    memset(&profile, 0, sizeof(profile));
+}
+
+#endif
@@ -0,0 +1,84 @@
+/*
+	Copyright Frank Bösing, Karsten Fleischer, 2026
+
+	This file is part of Teensy64.
+
+    Teensy64 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Teensy64 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Teensy64.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von Teensy64.
+
+    Teensy64 ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Teensy64 wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+*/
+
+#pragma once
+
+#ifndef TEENSY64_PROFILER_H
+#define TEENSY64_PROFILER_H
+
+#include <cstdint>
+#include "settings.h"
+
+/*
+  Sampling profiler of the 6502 code, enabled with PROFILER 1.
+
+  Every PROFILER_INTERVAL CPU cycles, cpu_clock() puts cpu().pc into a histogram with buckets
+  of 1 << PROFILER_SHIFT bytes. The interval is not a multiple of the raster line or frame,
+  so code synchronized to the raster is not sampled at the same point each time. The bank
+  of the PLA at the PC decides whether the sample counts for the BASIC/KERNAL ROM, the RAM
+  or the I/O area. The cost is one subtraction per instruction, and a few stores per sample.
+
+  Ctrl+Alt+O prints the report on Serial and starts a new profile. The report lists the
+  routines with the most samples. ROM addresses are mapped to the known entry points of
+  BASIC and KERNAL, RAM addresses to the symbols in PROFILER_SYMBOLS on the SD card, a
+  label file as VICE writes it ("al C:0810 .main"), read again for each report. A bucket
+  counts for the last symbol that starts in it or below it. RAM without symbols is listed by bucket.
+*/
+
+#if PROFILER
+const unsigned PROFILER_RAM_BUCKETS = 0x10000 >> PROFILER_SHIFT;
+const unsigned PROFILER_ROM_BUCKETS = 0x4000 >> PROFILER_SHIFT; //BASIC, then KERNAL
+
+// The profile of a machine, cpu().profile. cpu().profilerCountdown: cycles until the next sample.
+struct tprofile {
+    uint32_t ram[PROFILER_RAM_BUCKETS];
+    uint32_t rom[PROFILER_ROM_BUCKETS];
+    uint32_t io; //code in I/O or a cartridge
+    uint32_t samples;
+};
+
+// Called by cpu_clock() when cpu().profilerCountdown is used up.
+void profilerSample();
+
+void profilerRequest();
+
+// Called by the line clock interrupt between two raster lines.
+void profilerPoll();
+
+// Prints the top routines of the profile on Serial, then starts a new one.
+void profilerReport(unsigned top);
+#endif
+
+#endif // TEENSY64_PROFILER_H
@@ -0,0 +1,463 @@
+/*
+	Copyright Frank Bösing, Karsten Fleischer, 2026
+
+	This file is part of Teensy64.
+
+    Teensy64 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Teensy64 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Teensy64.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von Teensy64.
+
+    Teensy64 ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Teensy64 wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+*/
+
+#include <cstring>
+#include <cstdlib>
+#include "teensy64.h"
+#include "util.h"
+#include "machine_state.h"
+#include "rewind.h"
+
+namespace {
+
+const unsigned RAM_PAGES = sizeof(cpu().RAM) >> 8;
+const unsigned PAGES = RAM_PAGES + (sizeof(cpu().vic.colorRAM) >> 8);
+const unsigned ENTRY_HEADER = 3; //page number (2 bytes), number of runs or 0 for a raw page
+const unsigned MAX_RUNS = 127;   //pages with more runs are stored raw
+const unsigned STEP_PAGES = 16;  //pages a capture compares or writes per raster line
+
+struct trecord {
+    uint32_t size; //with header and padding, 0 marks the end of the used part of the ring
+    uint32_t frame;
+    uint16_t pages;
+    uint8_t keyframe;
+    uint8_t reserved;
+    tmachineState state;
+    //followed by the pages
+};
+
+uint8_t *buffer = nullptr;
+uint32_t bufferSize = 0;
+uint32_t head = 0; //oldest record
+uint32_t tail = 0; //end of the newest record
+unsigned count = 0;
+
+uint32_t frame = 0;
+unsigned framesToCapture = REWIND_FRAMES;
+
+//Latest keyframe, the snapshots are compared with it
+bool haveKey = false;
+uint32_t keyRecord;
+uint32_t keySize;
+uint32_t keyEntry[PAGES];
+
+bool changed[PAGES];
+uint8_t runs[PAGES];
+
+//A capture runs in steps, one per line clock tick, while the machine waits
+enum tcapturePhase : uint8_t {
+    CAPTURE_NONE,
+    CAPTURE_DELTA, //compares the pages with the keyframe
+    CAPTURE_KEY,   //counts the runs of the pages for a keyframe
+    CAPTURE_WRITE  //writes the changed pages into the record
+};
+
+struct {
+    tcapturePhase phase;
+    unsigned page;  //next page of the phase
+    uint32_t size;  //of the entries
+    unsigned pages; //changed pages
+    bool keyframe;
+    uint8_t *record;
+    uint8_t *entry; //next entry of the record
+} capture{};
+
+volatile bool request = false;
+
+inline uint8_t *page(unsigned n) {
+    return (n < RAM_PAGES) ? &cpu().RAM[n << 8] : &cpu().vic.colorRAM[(n - RAM_PAGES) << 8];
+}
+
+inline trecord *record(uint32_t offset) {
+    return (trecord *) &buffer[offset];
+}
+
+//Number of runs of equal bytes in the page, 0 if there are more than MAX_RUNS
+unsigned countRuns(const uint8_t *p) {
+    unsigned n = 1;
+
+    for(unsigned i = 1; i < 256; i++) {
+        if(p[i] != p[i - 1] && ++n > MAX_RUNS) { return 0; }
+    }
+
+    return n;
+}
+
+inline uint32_t entrySize(unsigned r) {
+    return ENTRY_HEADER + (r ? 2 * r : 256);
+}
+
+uint8_t *writeEntry(uint8_t *e, unsigned n, unsigned r) {
+    const uint8_t *p = page(n);
+
+    *e++ = n & 0xFF;
+    *e++ = n >> 8;
+    *e++ = r;
+
+    if(r == 0) {
+        memcpy(e, p, 256);
+        return e + 256;
+    }
+
+    for(unsigned i = 0; i < 256;) {
+        unsigned j = i + 1;
+
+        while(j < 256 && p[j] == p[i]) { j++; }
+
+        *e++ = j - i - 1;
+        *e++ = p[i];
+        i = j;
+    }
+
+    return e;
+}
+
+//Copies the entry back to its page, returns the next entry
+const uint8_t *readEntry(const uint8_t *e) {
+    uint8_t *p = page(e[0] | (e[1] << 8));
+    unsigned r = e[2];
+
+    e += ENTRY_HEADER;
+
+    if(r == 0) {
+        memcpy(p, e, 256);
+        return e + 256;
+    }
+
+    for(; r > 0; r--, e += 2) {
+        memset(p, e[1], e[0] + 1);
+        p += e[0] + 1;
+    }
+
+    return e;
+}
+
+bool entryEquals(const uint8_t *e, const uint8_t *p) {
+    unsigned r = e[2];
+
+    e += ENTRY_HEADER;
+
+    if(r == 0) { return memcmp(e, p, 256) == 0; }
+
+    for(; r > 0; r--, e += 2) {
+        for(unsigned i = 0; i <= e[0]; i++) {
+            if(*p++ != e[1]) { return false; }
+        }
+    }
+
+    return true;
+}
+
+//Offset of the record after the one at offset, there must be one
+uint32_t next(uint32_t offset) {
+    offset += record(offset)->size;
+
+    if(offset + sizeof(uint32_t) > bufferSize || record(offset)->size == 0) { return 0; }
+
+    return offset;
+}
+
+//Drops the oldest keyframe together with its snapshots
+void dropOldest() {
+    do {
+        if(haveKey && head == keyRecord) { haveKey = false; }
+
+        if(--count == 0) {
+            head = tail = 0;
+            return;
+        }
+
+        head = next(head);
+    } while(!record(head)->keyframe);
+}
+
+//Space for a record at the end of the ring, nullptr if a snapshot would need to drop its own keyframe
+uint8_t *reserve(uint32_t size, bool keyframe) {
+    while(true) {
+        if(count == 0) {
+            head = tail = 0;
+            return (size <= bufferSize) ? buffer : nullptr;
+        }
+
+        if(tail > head) {
+            if(tail + size <= bufferSize) { return &buffer[tail]; }
+
+            if(size <= head) {
+                if(tail + sizeof(uint32_t) <= bufferSize) { record(tail)->size = 0; }
+                tail = 0;
+                return buffer;
+            }
+        } else if(tail < head && tail + size <= head) {
+            return &buffer[tail];
+        }
+
+        if(!keyframe && haveKey && head == keyRecord) { return nullptr; }
+
+        dropOldest();
+    }
+}
+
+inline uint32_t align(uint32_t size) {
+    return (size + 3) & ~3;
+}
+
+//Starts writing the record of the capture at p
+void startWrite(uint8_t *p, bool keyframe) {
+    trecord *r = (trecord *) p;
+
+    r->size = align(sizeof(trecord) + capture.size);
+    r->frame = frame;
+    r->pages = capture.pages;
+    r->keyframe = keyframe;
+    r->reserved = 0;
+    machineStateSave(r->state);
+
+    capture.phase = CAPTURE_WRITE;
+    capture.page = 0;
+    capture.keyframe = keyframe;
+    capture.record = p;
+    capture.entry = p + sizeof(trecord);
+}
+
+void finishWrite() {
+    uint8_t *p = capture.record;
+
+    tail = (p - buffer) + record(p - buffer)->size;
+    count++;
+
+    if(capture.keyframe) {
+        haveKey = true;
+        keyRecord = p - buffer;
+        keySize = record(keyRecord)->size - sizeof(trecord);
+    }
+
+    capture.phase = CAPTURE_NONE;
+}
+
+//The pages are compared, a delta record if it is small enough, else a keyframe
+void finishDelta() {
+    uint8_t *p;
+
+    if(capture.size <= keySize / 2 && (p = reserve(align(sizeof(trecord) + capture.size), false)) != nullptr) {
+        startWrite(p, false);
+        return;
+    }
+
+    capture.phase = CAPTURE_KEY;
+    capture.page = 0;
+    capture.size = 0;
+    capture.pages = PAGES;
+}
+
+void finishKey() {
+    uint32_t size = align(sizeof(trecord) + capture.size);
+    uint8_t *p = reserve(size, true);
+
+    if(p == nullptr) {
+        Serial.printf("Rewind: keyframe of %u bytes does not fit into %u bytes, rewind off\n",
+                      (unsigned) size, (unsigned) bufferSize);
+        free(buffer);
+        buffer = nullptr;
+        capture.phase = CAPTURE_NONE;
+        return;
+    }
+
+    startWrite(p, true);
+}
+
+void startCapture() {
+    capture.page = 0;
+    capture.size = 0;
+    capture.pages = 0;
+
+    if(haveKey) {
+        capture.phase = CAPTURE_DELTA;
+    } else {
+        memset(changed, 0, sizeof(changed));
+        capture.phase = CAPTURE_KEY;
+        capture.pages = PAGES;
+    }
+}
+
+//One step of the capture, at most STEP_PAGES pages
+void captureStep() {
+    unsigned end = min(capture.page + STEP_PAGES, PAGES);
+
+    switch(capture.phase) {
+        case CAPTURE_DELTA:
+            for(unsigned n = capture.page; n < end; n++) {
+                changed[n] = !entryEquals(&buffer[keyEntry[n]], page(n));
+                if(!changed[n]) { continue; }
+                runs[n] = countRuns(page(n));
+                capture.size += entrySize(runs[n]);
+                capture.pages++;
+            }
+            capture.page = end;
+            if(end == PAGES) { finishDelta(); }
+            break;
+
+        case CAPTURE_KEY:
+            //the runs of the changed pages are known from CAPTURE_DELTA
+            for(unsigned n = capture.page; n < end; n++) {
+                if(!changed[n]) {
+                    changed[n] = true;
+                    runs[n] = countRuns(page(n));
+                }
+                capture.size += entrySize(runs[n]);
+            }
+            capture.page = end;
+            if(end == PAGES) { finishKey(); }
+            break;
+
+        case CAPTURE_WRITE:
+            for(unsigned n = capture.page; n < end; n++) {
+                if(!changed[n]) { continue; }
+                if(capture.keyframe) { keyEntry[n] = capture.entry - buffer; }
+                capture.entry = writeEntry(capture.entry, n, runs[n]);
+            }
+            capture.page = end;
+            if(end == PAGES) { finishWrite(); }
+            break;
+
+        case CAPTURE_NONE:
+            break;
+    }
+}
+
+void rewind() {
+    if(count == 0) {
+        Serial.println("Rewind: no snapshot yet");
+        return;
+    }
+
+    static const uint32_t back = REWIND_SECONDS * REFRESHRATE;
+    uint32_t target = (frame > back) ? frame - back : 0;
+    uint32_t offset = head;
+    uint32_t key = head;
+    uint32_t found = head;
+    unsigned n = 1;
+
+    //The oldest record is always a keyframe, take it if there is nothing older than target
+    for(unsigned i = 1; i < count; i++) {
+        offset = next(offset);
+        if(record(offset)->frame > target) { break; }
+        if(record(offset)->keyframe) { key = offset; }
+        found = offset;
+        n = i + 1;
+    }
+
+    const uint8_t *e = &buffer[key + sizeof(trecord)];
+
+    for(unsigned i = 0; i < PAGES; i++) {
+        keyEntry[i] = e - buffer;
+        e = readEntry(e);
+    }
+
+    if(found != key) {
+        e = &buffer[found + sizeof(trecord)];
+        for(unsigned i = 0; i < record(found)->pages; i++) { e = readEntry(e); }
+    }
+
+    machineStateLoad(record(found)->state);
+
+    Serial.printf("Rewind %.1f s\n", (frame - record(found)->frame) / REFRESHRATE);
+
+    haveKey = true;
+    keyRecord = key;
+    keySize = record(key)->size - sizeof(trecord);
+    frame = record(found)->frame;
+    framesToCapture = REWIND_FRAMES;
+    tail = found + record(found)->size;
+    count = n;
+}
+
+}
+
+void rewindInit() {
+    if(REWIND_FRAMES == 0) { return; }
+
+    size_t size = REWIND_BUFFER;
+
+    if(size == 0) {
+        size_t available = freeRAM();
+        size = (available > REWIND_RESERVE) ? available - REWIND_RESERVE : 0;
+    }
+
+    size &= ~3;
+    if(size > sizeof(trecord)) { buffer = (uint8_t *) malloc(size); }
+
+    if(buffer == nullptr) {
+        Serial.println("Rewind: not enough RAM, rewind off");
+        return;
+    }
+
+    bufferSize = size;
+    Serial.printf("Rewind: %u bytes for snapshots\n", (unsigned) bufferSize);
+}
+
+void rewindRequest() {
+    request = true;
+}
+
+bool rewindPoll() {
+    if(capture.phase != CAPTURE_NONE) {
+        captureStep();
+        return true;
+    }
+
+    if(!request) { return false; }
+
+    request = false;
+
+    if(buffer == nullptr) {
+        Serial.println("Rewind is off");
+        return false;
+    }
+
+    rewind();
+    return false;
+}
+
+bool rewindFrame() {
+    if(buffer == nullptr) { return false; }
+
+    frame++;
+
+    if(--framesToCapture > 0) { return false; }
+
+    framesToCapture = REWIND_FRAMES;
+    startCapture();
+    return true;
+}
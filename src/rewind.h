@@ -0,0 +1,74 @@
+/*
+	Copyright Frank Bösing, Karsten Fleischer, 2026
+
+	This file is part of Teensy64.
+
+    Teensy64 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Teensy64 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Teensy64.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von Teensy64.
+
+    Teensy64 ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Teensy64 wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+*/
+
+#pragma once
+
+#ifndef TEENSY64_REWIND_H
+#define TEENSY64_REWIND_H
+
+/*
+  Rewind: every REWIND_FRAMES frames a snapshot of the machine goes into a ring buffer in RAM.
+
+  A keyframe holds all pages of RAM and colour RAM, each run-length encoded when that is
+  shorter. The snapshots in between only hold the pages that differ from the latest keyframe,
+  a new keyframe is taken when that gets more than half the size of a keyframe. When the ring
+  is full, the oldest keyframe and its snapshots are dropped. All snapshots carry the complete
+  machine state (see machine_state.h), the internal state of the SID is not saved.
+
+  The size of the ring is REWIND_BUFFER, or all free RAM but REWIND_RESERVE. Rewind is off if
+  a keyframe does not fit into it. It is off by default (REWIND_FRAMES 0), since it takes
+  most of the free RAM.
+
+  A snapshot is taken in steps of 16 pages, one step per line clock tick, while the machine
+  waits: up to 17 ticks to compare the pages with the keyframe (17 more to count the runs
+  if a new keyframe is needed), and up to 17 to write the record. The machine loses these
+  ticks, about 2-3 ms every REWIND_FRAMES frames.
+
+  Ctrl+Alt+R goes back REWIND_SECONDS (emulated) seconds, or to the oldest snapshot.
+  The snapshots after it are discarded.
+*/
+
+void rewindInit();
+void rewindRequest();
+
+// Called by the line clock interrupt between two raster lines. True while a snapshot is
+// being taken, then the machine has to wait.
+bool rewindPoll();
+
+// Called by the line clock interrupt at the start of each frame. True if a snapshot starts,
+// then no more lines until rewindPoll() returns false.
+bool rewindFrame();
+
+#endif // TEENSY64_REWIND_H
@@ -580,7 +580,13 @@ const unsigned char rom_basic[8192] =
         0xF8, 0x60, 0xA9, 0x11, 0xA0, 0xBF, 0x4C, 0x67, 0xB8, 0x20, 0x8C,
         0xBA, 0xA5, 0x66, 0x49, 0xFF, 0x85, 0x66, 0x45, 0x6E, 0x85, 0x6F,
         0xA5, 0x61, 0x4C, 0x6A, 0xB8, 0x20, 0x99, 0xB9, 0x90, 0x3C, 0x20,
-        0x8C, 0xBA, 0xD0, 0x03, 0x4C, 0xFC, 0xBB, 0xA6, 0x70, 0x86, 0x56,
+        0x8C, 0xBA,
+#if APPLY_PATCHES && PATCH_BASIC_FP
+        0x32, /* PATCH FADDT */
+#else
+        0xD0, /* FADDT */
+#endif
+        0x03, 0x4C, 0xFC, 0xBB, 0xA6, 0x70, 0x86, 0x56,
         0xA2, 0x69, 0xA5, 0x69, 0xA8, 0xF0, 0xCE, 0x38, 0xE5, 0x61, 0xF0,
         0x24, 0x90, 0x12, 0x84, 0x61, 0xA4, 0x6E, 0x84, 0x66, 0x49, 0xFF,
         0x69, 0x00, 0xA0, 0x00, 0x84, 0x56, 0xA2, 0x61, 0xD0, 0x04, 0xA0,
@@ -621,7 +627,12 @@ const unsigned char rom_basic[8192] =
         0xBB, 0xA9, 0xBC, 0xA0, 0xB9, 0x20, 0x50, 0xB8, 0xA9, 0xC1, 0xA0,
         0xB9, 0x20, 0x43, 0xE0, 0xA9, 0xE0, 0xA0, 0xB9, 0x20, 0x67, 0xB8,
         0x68, 0x20, 0x7E, 0xBD, 0xA9, 0xE5, 0xA0, 0xB9, 0x20, 0x8C, 0xBA,
-        0xD0, 0x03, 0x4C, 0x8B, 0xBA, 0x20, 0xB7, 0xBA, 0xA9, 0x00, 0x85,
+#if APPLY_PATCHES && PATCH_BASIC_FP
+        0x32, /* PATCH FMULTT */
+#else
+        0xD0, /* FMULTT */
+#endif
+        0x03, 0x4C, 0x8B, 0xBA, 0x20, 0xB7, 0xBA, 0xA9, 0x00, 0x85,
         0x26, 0x85, 0x27, 0x85, 0x28, 0x85, 0x29, 0xA5, 0x70, 0x20, 0x59,
         0xBA, 0xA5, 0x65, 0x20, 0x59, 0xBA, 0xA5, 0x64, 0x20, 0x59, 0xBA,
         0xA5, 0x63, 0x20, 0x59, 0xBA, 0xA5, 0x62, 0x20, 0x5E, 0xBA, 0x4C,
@@ -642,7 +653,12 @@ const unsigned char rom_basic[8192] =
         0x20, 0x77, 0xB8, 0xE6, 0x61, 0xF0, 0xE7, 0x60, 0x84, 0x20, 0x00,
         0x00, 0x00, 0x20, 0x0C, 0xBC, 0xA9, 0xF9, 0xA0, 0xBA, 0xA2, 0x00,
         0x86, 0x6F, 0x20, 0xA2, 0xBB, 0x4C, 0x12, 0xBB, 0x20, 0x8C, 0xBA,
-        0xF0, 0x76, 0x20, 0x1B, 0xBC, 0xA9, 0x00, 0x38, 0xE5, 0x61, 0x85,
+#if APPLY_PATCHES && PATCH_BASIC_FP
+        0x32, /* PATCH FDIVT */
+#else
+        0xF0, /* FDIVT */
+#endif
+        0x76, 0x20, 0x1B, 0xBC, 0xA9, 0x00, 0x38, 0xE5, 0x61, 0x85,
         0x61, 0x20, 0xB7, 0xBA, 0xE6, 0x61, 0xF0, 0xBA, 0xA2, 0xFC, 0xA9,
         0x01, 0xA4, 0x6A, 0xC4, 0x62, 0xD0, 0x10, 0xA4, 0x6B, 0xC4, 0x63,
         0xD0, 0x0A, 0xA4, 0x6C, 0xC4, 0x64, 0xD0, 0x04, 0xA4, 0x6D, 0xC4,
@@ -791,7 +807,13 @@ const unsigned char rom_kernal[8192] =
         0x20, 0xC6, 0xFF, 0xB0, 0xD6, 0x60, 0x20, 0xE4, 0xFF, 0xB0, 0xD0,
         0x60, 0x20, 0x8A, 0xAD, 0x20, 0xF7, 0xB7, 0xA9, 0xE1, 0x48, 0xA9,
         0x46, 0x48, 0xAD, 0x0F, 0x03, 0x48, 0xAD, 0x0C, 0x03, 0xAE, 0x0D,
-        0x03, 0xAC, 0x0E, 0x03, 0x28, 0x6C, 0x14, 0x00, 0x08, 0x8D, 0x0C,
+        0x03, 0xAC, 0x0E, 0x03, 0x28,
+#if APPLY_PATCHES && PATCH_DECRUNCH
+        0x52, /* PATCH SYS */
+#else
+        0x6C, /* SYS */
+#endif
+        0x14, 0x00, 0x08, 0x8D, 0x0C,
         0x03, 0x8E, 0x0D, 0x03, 0x8C, 0x0E, 0x03, 0x68, 0x8D, 0x0F, 0x03,
         0x60, 0x20, 0xD4, 0xE1, 0xA6, 0x2D, 0xA4, 0x2E, 0xA9, 0x2B, 0x20,
         0xD8, 0xFF, 0xB0, 0x95, 0x60, 0xA9, 0x01, 0x2C, 0xA9, 0x00, 0x85,
@@ -884,7 +906,13 @@ const unsigned char rom_kernal[8192] =
         0x8D, 0x91, 0x02, 0x85, 0xCF, 0xA9, 0x48, 0x8D, 0x8F, 0x02, 0xA9,
         0xEB, 0x8D, 0x90, 0x02, 0xA9, 0x0A, 0x8D, 0x89, 0x02, 0x8D, 0x8C,
         0x02, 0xA9, 0x0E, 0x8D, 0x86, 0x02, 0xA9, 0x04, 0x8D, 0x8B, 0x02,
-        0xA9, 0x0C, 0x85, 0xCD, 0x85, 0xCC, 0xAD, 0x88, 0x02, 0x09, 0x80,
+        0xA9, 0x0C, 0x85, 0xCD, 0x85, 0xCC,
+#if APPLY_PATCHES && PATCH_KERNAL_EDITOR
+        0x42, /* PATCH CLSLINKS */
+#else
+        0xAD, /* CLSLINKS */
+#endif
+        0x88, 0x02, 0x09, 0x80,
         0xA8, 0xA9, 0x00, 0xAA, 0x94, 0xD9, 0x18, 0x69, 0x28, 0x90, 0x01,
         0xC8, 0xE8, 0xE0, 0x1A, 0xD0, 0xF3, 0xA9, 0xFF, 0x95, 0xD9, 0xA2,
         0x18, 0x20, 0xFF, 0xE9, 0xCA, 0x10, 0xFA, 0xA0, 0x00, 0x84, 0xD3,
@@ -973,7 +1001,13 @@ const unsigned char rom_kernal[8192] =
         0xA5, 0xAE, 0x48, 0xA5, 0xAF, 0x48, 0xA2, 0xFF, 0xC6, 0xD6, 0xC6,
         0xC9, 0xCE, 0xA5, 0x02, 0xE8, 0x20, 0xF0, 0xE9, 0xE0, 0x18, 0xB0,
         0x0C, 0xBD, 0xF1, 0xEC, 0x85, 0xAC, 0xB5, 0xDA, 0x20, 0xC8, 0xE9,
-        0x30, 0xEC, 0x20, 0xFF, 0xE9, 0xA2, 0x00, 0xB5, 0xD9, 0x29, 0x7F,
+        0x30, 0xEC, 0x20, 0xFF, 0xE9,
+#if APPLY_PATCHES && PATCH_KERNAL_EDITOR
+        0x42, /* PATCH SCROLLINKS */
+#else
+        0xA2, /* SCROLLINKS */
+#endif
+        0x00, 0xB5, 0xD9, 0x29, 0x7F,
         0xB4, 0xDA, 0x10, 0x02, 0x09, 0x80, 0x95, 0xD9, 0xE8, 0xE0, 0x18,
         0xD0, 0xEF, 0xA5, 0xF1, 0x09, 0x80, 0x85, 0xF1, 0xA5, 0xD9, 0x10,
         0xC3, 0xE6, 0xD6, 0xEE, 0xA5, 0x02, 0xA9, 0x7F, 0x8D, 0x00, 0xDC,
@@ -989,12 +1023,24 @@ const unsigned char rom_kernal[8192] =
         0xD8, 0x20, 0xC8, 0xE9, 0x30, 0xE9, 0x20, 0xFF, 0xE9, 0xA2, 0x17,
         0xEC, 0xA5, 0x02, 0x90, 0x0F, 0xB5, 0xDA, 0x29, 0x7F, 0xB4, 0xD9,
         0x10, 0x02, 0x09, 0x80, 0x95, 0xDA, 0xCA, 0xD0, 0xEC, 0xAE, 0xA5,
-        0x02, 0x20, 0xDA, 0xE6, 0x4C, 0x58, 0xE9, 0x29, 0x03, 0x0D, 0x88,
+        0x02, 0x20, 0xDA, 0xE6, 0x4C, 0x58, 0xE9,
+#if APPLY_PATCHES && PATCH_KERNAL_EDITOR
+        0x42, /* PATCH MOVLIN */
+#else
+        0x29, /* MOVLIN */
+#endif
+        0x03, 0x0D, 0x88,
         0x02, 0x85, 0xAD, 0x20, 0xE0, 0xE9, 0xA0, 0x27, 0xB1, 0xAC, 0x91,
         0xD1, 0xB1, 0xAE, 0x91, 0xF3, 0x88, 0x10, 0xF5, 0x60, 0x20, 0x24,
         0xEA, 0xA5, 0xAC, 0x85, 0xAE, 0xA5, 0xAD, 0x29, 0x03, 0x09, 0xD8,
         0x85, 0xAF, 0x60, 0xBD, 0xF0, 0xEC, 0x85, 0xD1, 0xB5, 0xD9, 0x29,
-        0x03, 0x0D, 0x88, 0x02, 0x85, 0xD2, 0x60, 0xA0, 0x27, 0x20, 0xF0,
+        0x03, 0x0D, 0x88, 0x02, 0x85, 0xD2, 0x60,
+#if APPLY_PATCHES && PATCH_KERNAL_EDITOR
+        0x42, /* PATCH CLRLN */
+#else
+        0xA0, /* CLRLN */
+#endif
+        0x27, 0x20, 0xF0,
         0xE9, 0x20, 0x24, 0xEA, 0x20, 0xDA, 0xE4, 0xA9, 0x20, 0x91, 0xD1,
         0x88, 0x10, 0xF6, 0x60, 0xEA, 0xA8, 0xA9, 0x02, 0x85, 0xCD, 0x20,
         0x24, 0xEA, 0x98, 0xA4, 0xD3, 0x91, 0xD1, 0x8A, 0x91, 0xF3, 0x60,
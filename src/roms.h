@@ -4,6 +4,9 @@
 #define TEENSY64_ROMS_H
 
 #define APPLY_PATCHES 1
+#define PATCH_BASIC_FP 1 //native BASIC floating point arithmetic, see basic_fp.h
+#define PATCH_KERNAL_EDITOR 1 //native KERNAL screen editor loops, see kernal_editor.h
+#define PATCH_DECRUNCH 1 //fast run of known decrunchers started with SYS, see decrunch.h
 
 extern const unsigned char rom_basic[8192];
 extern const unsigned char rom_kernal[8192];
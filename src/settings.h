@@ -45,7 +45,167 @@
 #endif
 
 #ifndef FASTBOOT
-#define FASTBOOT      1 //0 to disable fastboot
+#define FASTBOOT      2 //0 to disable fastboot, 1: run the KERNAL boot at full speed, 2: restore the boot snapshot
+#endif
+
+#ifndef FASTBOOT_SLICE
+#define FASTBOOT_SLICE 50000 //FASTBOOT 1: cycles of the boot per raster line
+#endif
+
+#ifndef BOOTSNAPSHOT_DUMP
+#define BOOTSNAPSHOT_DUMP 0 //1: print the boot snapshot source at the READY prompt, use with FASTBOOT 0
+#endif
+
+#ifndef MACHINES
+#define MACHINES      1 //>1: cpu() is the machine bound to the current thread, for host builds running several machines
+#endif
+
+#ifndef FREEZE_FILE
+#define FREEZE_FILE   "/teensy64.frz" //freeze/resume the machine with Ctrl+Alt+S/Ctrl+Alt+L
+#endif
+
+#ifndef INPUT_FILE
+#define INPUT_FILE    "/teensy64.inp" //record/replay the input with Ctrl+Alt+I/Ctrl+Alt+P
+#endif
+
+#ifndef INPUT_HASH_FRAMES
+#define INPUT_HASH_FRAMES 50 //record: machine hash every n frames, replay: finds the first frame that differs, 0: none
+#endif
+
+#ifndef REWIND_FRAMES
+#define REWIND_FRAMES 0 //rewind: snapshot every n frames (e.g. 25), 0: no rewind and no RAM for it
+#endif
+
+#ifndef REWIND_SECONDS
+#define REWIND_SECONDS 5 //Ctrl+Alt+R goes back n seconds
+#endif
+
+#ifndef REWIND_BUFFER
+#define REWIND_BUFFER 0 //bytes for the rewind snapshots, 0: all free RAM but REWIND_RESERVE
+#endif
+
+#ifndef REWIND_RESERVE
+#define REWIND_RESERVE 16384 //bytes of free RAM left for stack and heap
+#endif
+
+#ifndef BASICFP_CYCLEDIVIDER
+#define BASICFP_CYCLEDIVIDER 1 //1: native BASIC floating point needs as many cycles as the ROM code, >1: faster
+#endif
+
+#ifndef KERNALEDITOR_CYCLEDIVIDER
+#define KERNALEDITOR_CYCLEDIVIDER 1 //1: native KERNAL screen editor needs as many cycles as the ROM code, >1: faster
+#endif
+
+#ifndef LOOPIDIOMS
+#define LOOPIDIOMS    1 //0 to disable the recognition of copy and fill loops
+#endif
+
+#ifndef TURBO
+#define TURBO         1 //CPU cycles per C64 cycle at startup, VIC, CIAs and SID keep their speed
+#endif
+
+#ifndef TURBO_MAX
+#define TURBO_MAX     4 //max. CPU cycles per C64 cycle
+#endif
+
+#ifndef WARP_FRAMESKIP
+#define WARP_FRAMESKIP 10 //warp mode: draw every n-th frame, 0: none
+#endif
+
+#ifndef WARP_LOAD
+#define WARP_LOAD     90 //warp mode: % of the raster line period used for emulation
+#endif
+
+#ifndef WARP_MUTE
+#define WARP_MUTE     1 //0: keep audio on in warp mode
+#endif
+
+#ifndef WARP_AUTO
+#define WARP_AUTO     1 //warp mode after LOAD from SD, until the KERNAL waits for a key
+#endif
+
+#ifndef WARP_AUTOFRAMES
+#define WARP_AUTOFRAMES 500 //max. frames of automatic warp mode
+#endif
+
+#ifndef DECRUNCH_MAXCYCLES
+#define DECRUNCH_MAXCYCLES 20000000ul //max. cycles a known decruncher runs without VIC and CIAs
+#endif
+
+#ifndef DECRUNCH_LOAD
+#define DECRUNCH_LOAD 40 //% of the raster line period used for the fast run of a decruncher
+#endif
+
+#ifndef MONITOR
+#define MONITOR       0 //1: remote monitor with the binary protocol of VICE, see monitor.h
+#endif
+
+#ifndef MONITOR_PORT
+#define MONITOR_PORT  SerialUSB1 //port of the monitor, SerialUSB1 needs USB type Dual Serial
+#endif
+
+#ifndef MONITOR_TCP
+#define MONITOR_TCP   6502 //host builds: TCP port of the monitor
+#endif
+
+#ifndef MONITOR_CHECKPOINTS
+#define MONITOR_CHECKPOINTS 32 //max. checkpoints of the monitor, 20 bytes each, their number costs no time
+#endif
+
+#ifndef PROFILER
+#define PROFILER      0 //1: sampling profiler of the 6502 code, report with Ctrl+Alt+O, see profiler.h
+#endif
+
+#ifndef PROFILER_INTERVAL
+#define PROFILER_INTERVAL 997 //CPU cycles between two samples, a prime: no multiple of the line or frame
+#endif
+
+#ifndef PROFILER_SHIFT
+#define PROFILER_SHIFT 4 //2^n bytes per bucket, 4: 20 KB for the histogram
+#endif
+
+#ifndef PROFILER_TOP
+#define PROFILER_TOP  20 //lines of the report
+#endif
+
+#ifndef PROFILER_SYMBOLS
+#define PROFILER_SYMBOLS "/teensy64.lbl" //VICE label file with the symbols of the program in RAM
+#endif
+
+#ifndef TRACE
+#define TRACE         0 //1: trace of the last instructions, printed on CPU JAM, hang or Ctrl+Alt+T, see trace.h
+#endif
+
+#ifndef TRACE_LENGTH
+#define TRACE_LENGTH  256 //instructions in the trace, a power of 2, 12 bytes each
+#endif
+
+#ifndef TRACE_HANG
+#define TRACE_HANG    250 //frames with the same PC and interrupts disabled that count as a hang
+#endif
+
+#ifndef COUNTERS
+#define COUNTERS      0 //1: counters of opcodes, addressing modes, branches and I/O, see counters.h
+#endif
+
+#ifndef HEATMAP
+#define HEATMAP       0 //1: reads, writes and executes per memory page, printed with Ctrl+Alt+H, see heatmap.h
+#endif
+
+#ifndef HEATMAP_SHIFT
+#define HEATMAP_SHIFT 8 //2^n bytes per entry, 8: pages, 0: bytes (1.5 MB, for the host build)
+#endif
+
+#ifndef HEATMAP_FRAMES
+#define HEATMAP_FRAMES 50 //frames of a window
+#endif
+
+#ifndef VIC_JOURNAL
+#define VIC_JOURNAL   0 //1: journal of the VIC register writes of a frame, printed with Ctrl+Alt+V, see vic_journal.h
+#endif
+
+#ifndef VIC_JOURNAL_LENGTH
+#define VIC_JOURNAL_LENGTH 1024 //writes per frame, 6 bytes each, twice
 #endif
 
 #define EXACTTIMINGDURATION 600ul //ms exact timing after IEC-BUS activity
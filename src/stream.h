@@ -0,0 +1,129 @@
+/*
+	Copyright Frank Bösing, Karsten Fleischer, 2026
+
+	This file is part of Teensy64.
+
+    Teensy64 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Teensy64 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Teensy64.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von Teensy64.
+
+    Teensy64 ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Teensy64 wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+*/
+
+#pragma once
+
+#ifndef TEENSY64_STREAM_H
+#define TEENSY64_STREAM_H
+
+#include <atomic>
+#include <thread>
+#include <cstdint>
+
+/*
+  Lock-free ring of N slots between one producer thread and one consumer thread, for the
+  frames and audio blocks of host builds (MACHINES > 1).
+
+  The producer fills slot() in place and hands it over with publish(). The consumer gets
+  the oldest slot with acquire() and reads it in place, it stays valid until the next
+  acquire(). Neither side copies or locks, each writes only its own index.
+
+  The policy says what happens when one side is faster:
+
+    STREAM_DROP     the producer drops the new slot if the consumer holds all others,
+                    acquire() returns nullptr while there is nothing new
+    STREAM_BLOCK    the producer waits for the consumer, nothing is lost (recording)
+    STREAM_STRETCH  the producer drops like STREAM_DROP, acquire() returns the last slot
+                    again while there is nothing new (display)
+
+  Only STREAM_BLOCK lets the consumer slow the emulation down.
+*/
+
+enum tstreamPolicy {
+    STREAM_DROP, STREAM_BLOCK, STREAM_STRETCH
+};
+
+template<typename T, unsigned N>
+class tstream {
+  public:
+    explicit tstream(tstreamPolicy policy) : policy(policy) {}
+
+    // Producer: the slot to fill next.
+    T &slot() {
+        return ring[head.load(std::memory_order_relaxed) % N];
+    }
+
+    // Producer: hands slot() to the consumer, false if it was dropped and gets filled again.
+    bool publish() {
+        uint32_t h = head.load(std::memory_order_relaxed);
+
+        while(h + 1 - tail.load(std::memory_order_acquire) >= N) {
+            if(policy != STREAM_BLOCK || closed.load(std::memory_order_relaxed)) {
+                dropped++;
+                return false;
+            }
+            std::this_thread::yield();
+        }
+
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer: the oldest slot not seen yet, see the policy if there is none.
+    const T *acquire() {
+        uint32_t t = tail.load(std::memory_order_relaxed);
+        uint32_t h = head.load(std::memory_order_acquire);
+
+        if(held) {
+            if(t + 1 == h) {
+                if(policy == STREAM_STRETCH) { return &ring[t % N]; }
+                held = false;
+            }
+            tail.store(++t, std::memory_order_release);
+        }
+
+        if(t == h) { return nullptr; }
+
+        held = true;
+        return &ring[t % N];
+    }
+
+    // Consumer: the producer no longer waits for acquire(), e.g. when the consumer goes away.
+    void close() {
+        closed.store(true, std::memory_order_relaxed);
+    }
+
+    uint32_t dropped{}; //slots dropped by the producer
+
+  private:
+    const tstreamPolicy policy;
+    T ring[N];
+    std::atomic<uint32_t> head{0}; //written by the producer
+    std::atomic<uint32_t> tail{0}; //written by the consumer, the slot it holds is not free
+    std::atomic<bool> closed{false};
+    bool held{false}; //the consumer holds ring[tail]
+};
+
+#endif // TEENSY64_STREAM_H
@@ -36,6 +36,18 @@
 #include <Arduino.h>
 #include "teensy64.h"
 #include "vic_palette.h"
+#include "warp.h"
+#include "boot_snapshot.h"
+#include "freeze.h"
+#include "rewind.h"
+#include "input.h"
+#include "machine.h"
+#include "monitor.h"
+#include "profiler.h"
+#include "trace.h"
+#include "counters.h"
+#include "heatmap.h"
+#include "vic_journal.h"
 
 ILI9341_t3n tft = ILI9341_t3n(TFT_CS, TFT_DC, TFT_RST, TFT_MOSI, TFT_SCLK, TFT_MISO);
 
@@ -51,43 +63,107 @@ SdFat SD;
 bool SDinitialized = false;
 
 
+static volatile bool resetPending = false;
+
+//The reset pin and keyboard interrupts have a higher priority than the line clock,
+//the reset itself is done by the line clock between two raster lines.
 void resetMachine() {
-    *(volatile uint32_t *) 0xE000ED0C = 0x5FA0004;
-    while(true) {}
+    resetPending = true;
 }
 
-void resetExternal() {
-    //perform a Reset for external devices on IEC-Bus,
-    //   detachInterrupt(digitalPinToInterrupt(PIN_RESET));
+static volatile unsigned resetExternalLines = 0; //raster lines until the reset pin is released
 
+//Starts a reset of the external devices on the IEC bus, the line clock ends it 50 ms later
+void resetExternal() {
+    //the reset pin is an input too, don't trigger another reset
+    detachInterrupt(digitalPinToInterrupt(PIN_RESET));
     digitalWriteFast(PIN_RESET, 0);
-    delay(50);
+    resetExternalLines = (unsigned) (LINEFREQ / 20);
+}
+
+static void resetExternalLine() {
+    if(resetExternalLines == 0 || --resetExternalLines > 0) { return; }
+
     digitalWriteFast(PIN_RESET, 1);
+    attachInterrupt(digitalPinToInterrupt(PIN_RESET), resetMachine, RISING);
 }
 
 
+//Resets the emulated machine in place, USB, SD card, display and audio stay initialized
+static void softReset() {
+    warpOff();
+    playSID.reset();
+
+    resetExternal();
+
+    machineReset();
+    machineBoot();
+
+    Serial.println("Reset.");
+}
+
 void oneRasterLine() {
-    static unsigned short lc = 1;
+    uint32_t sliceStart = ARM_DWT_CYCCNT;
+
+#if MONITOR
+    if(monitorPoll()) { return; } //stopped by the monitor
+#endif
+
+    //both take several ticks, one at a time
+    if(!freezeBusy() && rewindPoll()) { return; } //taking a snapshot
+    if(freezePoll()) { return; } //writing or reading the freeze file
+
+    inputPoll();
+#if PROFILER
+    profilerPoll();
+#endif
+#if TRACE
+    tracePoll();
+#endif
+#if COUNTERS
+    countersPoll();
+#endif
+#if HEATMAP
+    heatmapPoll();
+#endif
+#if VIC_JOURNAL
+    vicJournalPoll();
+#endif
+
+    resetExternalLine();
 
     while(true) {
-        cpu.lineStartTime = ARM_DWT_CYCCNT;
-        cpu.lineCycles = cpu.lineCyclesAbs = 0;
+        inputLine();
 
-        if(!cpu.exactTiming) {
-            tvic::render();
-        } else {
-            tvic::renderSimple();
+        if(resetPending) {
+            resetPending = false;
+            softReset();
         }
 
-        if(--lc == 0) {
-            lc = (unsigned short)LINEFREQ / 10; // 10Hz
-            cia1_checkRTCAlarm();
-            cia2_checkRTCAlarm();
+        machineLine();
+
+        if(cpu().vic.rasterLine == 0 && !machineBooting()) {
+            bool snapshot = rewindFrame();
+#if TRACE
+            traceFrame();
+#endif
+            if(snapshot) { break; } //taken by rewindPoll() in the next ticks
         }
 
+#if MONITOR
+        if(monitorActive() && monitorStopped()) { break; }
+#endif
+
+#if BOOTSNAPSHOT_DUMP
+        bootSnapshotDumpAtReady();
+#endif
+
+        //Warp mode: next line without waiting for the line clock
+        if(!cpu().exactTiming && warpNextLine(sliceStart)) { continue; }
+
         //Switch "ExactTiming" Mode off after a while:
-        if(!cpu.exactTiming) { break; }
-        if(ARM_DWT_CYCCNT - cpu.exactTimingStartTime >= EXACTTIMINGDURATION * (F_CPU / 1000)) {
+        if(!cpu().exactTiming) { break; }
+        if(ARM_DWT_CYCCNT - cpu().exactTimingStartTime >= EXACTTIMINGDURATION * (F_CPU / 1000)) {
             cpu_disableExactTiming();
             break;
         }
@@ -215,13 +291,17 @@ void initMachine() {
 
     Serial.println();
 
-    resetPLA();
-    resetCia1();
-    resetCia2();
-    cpu.vic.reset();
-    cpu_reset();
+    rewindInit();
+#if MONITOR
+    monitorStart();
+#endif
 
-    resetExternal();
+    machineReset();
+
+    //the external devices boot while this waits, no line clock yet to end the reset
+    digitalWriteFast(PIN_RESET, 0);
+    delayMicroseconds(50000);
+    digitalWriteFast(PIN_RESET, 1);
 
     while((millis() - m) <= 1500);
 
@@ -229,13 +309,10 @@ void initMachine() {
 
     Serial.println("Starting.\n");
 
-#if FASTBOOT
-    cpu_clock(2e6);
-    cpu.RAM[678] = (PAL == 1) ? 1 : 0; //PAL/NTSC switch, C64-Autodetection does not work with FASTBOOT
-#endif
+    machineBoot();
 
-    cpu.vic.lineClock.begin(oneRasterLine, LINETIMER_DEFAULT_FREQ);
-    cpu.vic.lineClock.priority(ISR_PRIORITY_RASTERLINE);
+    cpu().vic.lineClock.begin(oneRasterLine, LINETIMER_DEFAULT_FREQ);
+    cpu().vic.lineClock.priority(ISR_PRIORITY_RASTERLINE);
 
     attachInterrupt(digitalPinToInterrupt(PIN_RESET), resetMachine, RISING);
 
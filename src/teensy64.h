@@ -58,8 +58,9 @@ extern ILI9341_t3n tft;
 extern USBHost myusb;
 
 void initMachine();
-void resetMachine() __attribute__ ((noreturn));
+void resetMachine();
 void resetExternal();
+void oneRasterLine(); //the line clock interrupt
 
 extern bool SDinitialized;
 
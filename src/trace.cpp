@@ -0,0 +1,92 @@
+/*
+	Copyright Frank Bösing, Karsten Fleischer, 2026
+
+	This file is part of Teensy64.
+
+    Teensy64 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Teensy64 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Teensy64.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von Teensy64.
+
+    Teensy64 ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Teensy64 wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+*/
+
+#include "settings.h"
+
+#if TRACE
+
+#include "teensy64.h"
+#include "trace.h"
+
+namespace {
+
+volatile bool request = false;
+
+}
+
+void traceDump() {
+    const ttrace &trace = cpu().trace;
+    unsigned count = min(trace.next, (uint32_t) TRACE_LENGTH);
+
+    Serial.printf("Trace: last %u instructions\n", count);
+    Serial.println("line cyc  PC   op  A  X  Y  P  SP");
+
+    for(uint32_t i = trace.next - count; i != trace.next; i++) {
+        const ttraceEntry &e = trace.entries[i & (TRACE_LENGTH - 1)];
+
+        Serial.printf("%3u %3u  %04X %02X %02X %02X %02X %02X %02X\n",
+                      (unsigned) (e.lineCycle & 0xFFFF), (unsigned) (e.lineCycle >> 16),
+                      (unsigned) (e.pcOpcodeA & 0xFFFF), (unsigned) ((e.pcOpcodeA >> 16) & 0xFF),
+                      (unsigned) (e.pcOpcodeA >> 24), (unsigned) (e.xYPSp & 0xFF),
+                      (unsigned) ((e.xYPSp >> 8) & 0xFF), (unsigned) ((e.xYPSp >> 16) & 0xFF),
+                      (unsigned) (e.xYPSp >> 24));
+    }
+}
+
+void traceRequest() {
+    request = true;
+}
+
+void tracePoll() {
+    if(!request) { return; }
+
+    request = false;
+    traceDump();
+}
+
+void traceFrame() {
+    if(cpu().pc != cpu().trace.hangPc || !(cpu().cpustatus & FLAG_INTERRUPT)) {
+        cpu().trace.hangPc = cpu().pc;
+        cpu().trace.hangFrames = 0;
+        return;
+    }
+
+    if(++cpu().trace.hangFrames == TRACE_HANG) {
+        Serial.printf("Trace: the CPU hangs at $%04X\n", cpu().pc);
+        traceDump();
+    }
+}
+
+#endif
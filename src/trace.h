@@ -0,0 +1,91 @@
+/*
+	Copyright Frank Bösing, Karsten Fleischer, 2026
+
+	This file is part of Teensy64.
+
+    Teensy64 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Teensy64 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Teensy64.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von Teensy64.
+
+    Teensy64 ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Teensy64 wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+*/
+
+#pragma once
+
+#ifndef TEENSY64_TRACE_H
+#define TEENSY64_TRACE_H
+
+#include <cstdint>
+#include "settings.h"
+
+/*
+  Trace of the last TRACE_LENGTH instructions, enabled with TRACE 1.
+
+  cpu_clock() writes each instruction into a ring buffer of the machine (cpu().trace) before it runs: PC, opcode, A, X, Y,
+  P, SP, the raster line and the cycle in the line, three 32-bit stores. Interrupts show up
+  as the first instruction of the handler.
+
+  The trace is printed on Serial, oldest instruction first:
+    - when the CPU executes a KIL opcode (CPU JAM), before the reset
+    - with Ctrl+Alt+T
+    - when the machine hangs: the PC is the same at the start of TRACE_HANG frames in a row,
+      with interrupts disabled. It is printed once per hang.
+
+  Cost: three 32-bit stores and the loads and shifts to pack them, per 6502 instruction. It has
+  not been measured on the Teensy yet. To measure it, compare the speed that warp mode prints
+  with TRACE 0 and 1 and write the result here. On the host build the difference is below the
+  noise of a run. Without TRACE, nothing is compiled in.
+*/
+
+#if TRACE
+struct ttraceEntry {
+    uint32_t pcOpcodeA;    //PC, opcode << 16, A << 24
+    uint32_t xYPSp;        //X, Y << 8, P << 16, SP << 24
+    uint32_t lineCycle;    //raster line, cycle in the line << 16
+};
+
+struct ttrace {
+    ttraceEntry entries[TRACE_LENGTH];
+    uint32_t next;
+    uint16_t hangPc;     //at the start of the last frame
+    uint32_t hangFrames; //with the same PC and interrupts disabled
+};
+
+static_assert((TRACE_LENGTH & (TRACE_LENGTH - 1)) == 0, "TRACE_LENGTH must be a power of 2");
+
+// Prints the trace on Serial.
+void traceDump();
+
+void traceRequest();
+
+// Called by the line clock interrupt between two raster lines.
+void tracePoll();
+
+// Called at the start of each frame, detects a hang.
+void traceFrame();
+#endif
+
+#endif // TEENSY64_TRACE_H
@@ -96,6 +96,15 @@ void setAudioOn() {
     //NVIC_ENABLE_IRQ(IRQ_USBHS);
 }
 
+extern "C" char *__brkval;
+
+//Space between the top of the heap and the stack
+size_t freeRAM() {
+    char top;
+
+    return &top - __brkval;
+}
+
 void listInterrupts() {
 #if defined(__MK66FX1M0__)
     const char isrName[][24] = {
@@ -67,6 +67,7 @@ inline uint32_t cycleCountNanos() {
 float setAudioSampleFreq(float freq);
 void setAudioOff();
 void setAudioOn();
+size_t freeRAM();
 void listInterrupts();
 
 #endif // TEENSY64_UTIL_H
\ No newline at end of file
@@ -48,6 +48,12 @@
 #include "teensy64.h"
 #include "vic.h"
 #include "vic_palette.h"
+#include "warp.h"
+#include "vic_journal.h"
+#if MACHINES > 1
+#include "vic_pipeline.h"
+#include "video_stream.h"
+#endif
 
 #include "font_Play-Bold.h"
 
@@ -58,6 +64,97 @@
 DMAMEM uint16_t screen[ILI9341_TFTHEIGHT][ILI9341_TFTWIDTH];
 uint16_t *const screenMem = &screen[0][0];
 
+#if VIC_JOURNAL
+//Records a write to the register (0-$3F) before it happens, see vic_journal.h
+static inline void vicJournalWrite(uint8_t reg, uint8_t value) {
+    tvicJournal &journal = cpu().vicJournal.current;
+
+    if(journal.count == VIC_JOURNAL_LENGTH) {
+        journal.dropped++;
+        return;
+    }
+
+    journal.writes[journal.count++] = {cpu().vic.rasterLine, (uint16_t) (cpu().lineCycles + cpu().ticks), reg, value};
+}
+#endif
+
+static inline tpixel *lineMem(int rasterLine) {
+    return cpu().vic.frameBuffer + (rasterLine - FIRSTDISPLAYLINE) * LINE_MEM_WIDTH;
+}
+
+#if MACHINES > 1
+//The line for the render thread, nullptr: render() draws it or nobody does
+static inline tpipelineLine *pipelineLine(tpixel *row) {
+    if(!cpu().vic.pipeline || warp.skipFrame) { return nullptr; }
+
+    tpipelineLine &line = vicPipelineReserve(cpu().vic.pipeline);
+
+    line.row = row;
+    line.palette = cpu().vic.palette;
+    line.border = 0;
+    line.csel = cpu().vic.r.CSEL;
+
+    return &line;
+}
+
+//g-data and colours of character x as mode0..mode7 read them, b0c is read before the c-access,
+//charset and bitmap at the start of the line
+static void pipelineChar(tpipelineChar &ch, uint8_t mode, int x, const uint8_t *charset, const uint8_t *bitmap, uint8_t b0c) {
+    uint8_t t = cpu().vic.lineMemChr[x];
+    uint8_t col = cpu().vic.lineMemCol[x];
+
+    ch.multicolor = 0;
+
+    switch(mode) {
+        case 0:
+            ch.g = charset[t * 8];
+            ch.c[0] = cpu().vic.R[VIC_B0C];
+            ch.c[1] = col;
+            break;
+        case 1:
+            if(cpu().vic.idle) {
+                ch.g = cpu().RAM[cpu().vic.bank + 0x3fff];
+                col = 0;
+            } else {
+                ch.g = charset[t * 8];
+            }
+            ch.multicolor = col & 0x08;
+            ch.c[0] = b0c;
+            ch.c[1] = ch.multicolor ? cpu().vic.R[VIC_B1C] : col & 0x07;
+            ch.c[2] = cpu().vic.R[VIC_B2C];
+            ch.c[3] = col & 0x07;
+            break;
+        case 2:
+            ch.g = bitmap[x * 8];
+            ch.c[0] = t & 0x0f;
+            ch.c[1] = t >> 4;
+            break;
+        case 3:
+            ch.multicolor = 1;
+            ch.c[0] = b0c;
+            if(cpu().vic.idle) {
+                ch.g = cpu().RAM[cpu().vic.bank + 0x3fff];
+                ch.c[1] = ch.c[2] = ch.c[3] = 0;
+            } else {
+                ch.g = bitmap[x * 8];
+                ch.c[1] = t >> 4;
+                ch.c[2] = t & 0x0f;
+                ch.c[3] = col;
+            }
+            break;
+        case 4:
+            ch.g = charset[(t & 0x3f) * 8];
+            ch.c[0] = cpu().vic.R[VIC_B0C + ((t >> 6) & 0x03)];
+            ch.c[1] = col;
+            break;
+        default: //invalid modes are black
+            ch.g = 0;
+            ch.c[0] = 0;
+            break;
+    }
+}
+#endif
+
 /*****************************************************************************************************/
 /*****************************************************************************************************/
 /*****************************************************************************************************/
@@ -78,12 +175,12 @@ static bool spritePriorityFromLineData(uint16_t data) {
 }
 
 
-#define CHARSETPTR() (cpu.vic.charsetPtr = cpu.vic.charsetPtrBase + cpu.vic.rc)
-#define CYCLES(x) {if (cpu.vic.badline) {cia_clockt(x);} else {cpu_clock(x);} }
+#define CHARSETPTR() (cpu().vic.charsetPtr = cpu().vic.charsetPtrBase + cpu().vic.rc)
+#define CYCLES(x) {if (cpu().vic.badline) {cia_clockt(x);} else {cpu_clock(x);} }
 
-#define BADLINE(x) {if (cpu.vic.badline) { \
-      cpu.vic.lineMemChr[x] = cpu.RAM[cpu.vic.videomatrix + vc + x]; \
-      cpu.vic.lineMemCol[x] = cpu.vic.colorRAM[vc + x]; \
+#define BADLINE(x) {if (cpu().vic.badline) { \
+      cpu().vic.lineMemChr[x] = cpu().RAM[cpu().vic.videomatrix + vc + x]; \
+      cpu().vic.lineMemCol[x] = cpu().vic.colorRAM[vc + x]; \
       cia1_clock(1); \
       cia2_clock(1); \
     } else { \
@@ -94,7 +191,7 @@ static bool spritePriorityFromLineData(uint16_t data) {
 #define SPRITEORFIXEDCOLOR() \
   sprite = *spl++; \
   if (sprite) { \
-    *p++ = cpu.vic.palette[sprite & 0x0f]; \
+    *p++ = cpu().vic.palette[sprite & 0x0f]; \
   } else { \
     *p++ = col; \
   }
@@ -133,7 +230,7 @@ static void fastFillLineNoSprites(tpixel *p, const tpixel *pe, const uint16_t co
 
 inline __attribute__((always_inline))
 static void fastFillLine(tpixel *p, const tpixel *pe, const uint16_t col, uint16_t const *spl) {
-    if(spl != nullptr && cpu.vic.lineHasSprites) {
+    if(spl != nullptr && cpu().vic.lineHasSprites) {
         int i = 0;
         uint16_t sprite;
         while(p < pe) {
@@ -210,12 +307,12 @@ static void mode0(tpixel *p, const tpixel *pe, uint16_t const *spl, const uint16
 
     CHARSETPTR();
 
-    if(cpu.vic.lineHasSprites) {
+    if(cpu().vic.lineHasSprites) {
         do {
             BADLINE(x);
 
-            auto chr = cpu.vic.charsetPtr[cpu.vic.lineMemChr[x] * 8];
-            auto fgcol = cpu.vic.lineMemCol[x];
+            auto chr = cpu().vic.charsetPtr[cpu().vic.lineMemChr[x] * 8];
+            auto fgcol = cpu().vic.lineMemCol[x];
             uint8_t pixel;
 
             x++;
@@ -232,23 +329,23 @@ static void mode0(tpixel *p, const tpixel *pe, uint16_t const *spl, const uint16
 
                     if(spritePriority) {   // Sprite: Hinter Text  MxDP = 1
                         if(chr & 0x80) {
-                            cpu.vic.fgcollision |= spriteBit;
+                            cpu().vic.fgcollision |= spriteBit;
                             pixel = fgcol;
                         } else {
                             pixel = spritePixel;
                         }
                     } else {            // Sprite: Vor Text //MxDP = 0
                         if(chr & 0x80) {
-                            cpu.vic.fgcollision |= spriteBit;
+                            cpu().vic.fgcollision |= spriteBit;
                         }
 
                         pixel = spritePixel;
                     }
                 } else {            // Kein Sprite
-                    pixel = (chr & 0x80) ? fgcol : cpu.vic.r.B0C;
+                    pixel = (chr & 0x80) ? fgcol : cpu().vic.r.B0C;
                 }
 
-                *p++ = cpu.vic.palette[pixel];
+                *p++ = cpu().vic.palette[pixel];
                 chr = chr << 1;
             }
         } while(p < pe);
@@ -257,9 +354,9 @@ static void mode0(tpixel *p, const tpixel *pe, uint16_t const *spl, const uint16
         while(p < pe - 8) {
             BADLINE(x);
 
-            auto chr = cpu.vic.charsetPtr[cpu.vic.lineMemChr[x] * 8];
-            auto fgcol = cpu.vic.palette[cpu.vic.lineMemCol[x]];
-            auto bgcol = cpu.vic.palette[cpu.vic.R[VIC_B0C]];
+            auto chr = cpu().vic.charsetPtr[cpu().vic.lineMemChr[x] * 8];
+            auto fgcol = cpu().vic.palette[cpu().vic.lineMemCol[x]];
+            auto bgcol = cpu().vic.palette[cpu().vic.R[VIC_B0C]];
             x++;
 
             *p++ = (chr & 0x80) ? fgcol : bgcol;
@@ -275,9 +372,9 @@ static void mode0(tpixel *p, const tpixel *pe, uint16_t const *spl, const uint16
         while(p < pe) {
             BADLINE(x);
 
-            auto chr = cpu.vic.charsetPtr[cpu.vic.lineMemChr[x] * 8];
-            auto fgcol = cpu.vic.palette[cpu.vic.lineMemCol[x]];
-            auto bgcol = cpu.vic.palette[cpu.vic.R[VIC_B0C]];
+            auto chr = cpu().vic.charsetPtr[cpu().vic.lineMemChr[x] * 8];
+            auto fgcol = cpu().vic.palette[cpu().vic.lineMemCol[x]];
+            auto bgcol = cpu().vic.palette[cpu().vic.R[VIC_B0C]];
             x++;
 
             *p++ = (chr & 0x80) ? fgcol : bgcol;
@@ -379,23 +476,23 @@ static void mode1(tpixel *p, const tpixel *pe, uint16_t const *spl, const uint16
 
     CHARSETPTR();
 
-    if(cpu.vic.lineHasSprites) {
-        colors[0] = cpu.vic.r.B0C;
+    if(cpu().vic.lineHasSprites) {
+        colors[0] = cpu().vic.r.B0C;
 
         do {
-            if(cpu.vic.idle) {
+            if(cpu().vic.idle) {
                 cpu_clock(1);
 
                 fgcol = colors[1] = colors[2] = colors[3] = 0;
-                chr = cpu.RAM[cpu.vic.bank + 0x3fff];
+                chr = cpu().RAM[cpu().vic.bank + 0x3fff];
             } else {
                 BADLINE(x);
 
-                fgcol = cpu.vic.lineMemCol[x];
-                colors[1] = cpu.vic.R[VIC_B1C];
-                colors[2] = cpu.vic.R[VIC_B2C];
+                fgcol = cpu().vic.lineMemCol[x];
+                colors[1] = cpu().vic.R[VIC_B1C];
+                colors[2] = cpu().vic.R[VIC_B2C];
                 colors[3] = fgcol & 0x07;
-                chr = cpu.vic.charsetPtr[cpu.vic.lineMemChr[x] * 8];
+                chr = cpu().vic.charsetPtr[cpu().vic.lineMemChr[x] * 8];
             }
 
             x++;
@@ -423,19 +520,19 @@ static void mode1(tpixel *p, const tpixel *pe, uint16_t const *spl, const uint16
 
                         if(spritePriority) {   // MxDP = 1
                             if(chr & 0x80) { //Vordergrundpixel ist gesetzt
-                                cpu.vic.fgcollision |= spriteBit;
+                                cpu().vic.fgcollision |= spriteBit;
                                 pixel = colors[3];
                             }
                         } else {            // MxDP = 0
                             if(chr & 0x80) {
-                                cpu.vic.fgcollision |= spriteBit;
+                                cpu().vic.fgcollision |= spriteBit;
                             } //Vordergrundpixel ist gesetzt
                         }
                     } else {            // Kein Sprite
                         pixel = (chr >> 7) ? colors[3] : colors[0];
                     }
 
-                    *p++ = cpu.vic.palette[pixel];
+                    *p++ = cpu().vic.palette[pixel];
 
                     chr = chr << 1;
                 }
@@ -459,19 +556,19 @@ static void mode1(tpixel *p, const tpixel *pe, uint16_t const *spl, const uint16
 
                         if(spritePriority) {  // MxDP = 1
                             if(chr & 0x80) {  //Vordergrundpixel ist gesetzt
-                                cpu.vic.fgcollision |= spriteBit;
+                                cpu().vic.fgcollision |= spriteBit;
                                 pixel = colors[c];
                             }
                         } else {          // MxDP = 0
                             if(chr & 0x80) {
-                                cpu.vic.fgcollision |= spriteBit;
+                                cpu().vic.fgcollision |= spriteBit;
                             } //Vordergrundpixel ist gesetzt
                         }
                     } else { // Kein Sprite
                         pixel = colors[c];
                     }
 
-                    *p++ = cpu.vic.palette[pixel];
+                    *p++ = cpu().vic.palette[pixel];
 
                     if(p >= pe) {
                         break;
@@ -489,18 +586,18 @@ static void mode1(tpixel *p, const tpixel *pe, uint16_t const *spl, const uint16
                         if(spritePriority) {  // MxDP = 1
 
                             if(chr & 0x80) { //Vordergrundpixel ist gesetzt
-                                cpu.vic.fgcollision |= spriteBit;
+                                cpu().vic.fgcollision |= spriteBit;
                                 pixel = colors[c];
                             }
                         } else {          // MxDP = 0
                             if(chr & 0x80) {
-                                cpu.vic.fgcollision |= spriteBit;
+                                cpu().vic.fgcollision |= spriteBit;
                             } //Vordergrundpixel ist gesetzt
                         }
                     } else { // Kein Sprite
                         pixel = colors[c];
                     }
-                    *p++ = cpu.vic.palette[pixel];
+                    *p++ = cpu().vic.palette[pixel];
                 }
             }
         } while(p < pe);
@@ -509,27 +606,27 @@ static void mode1(tpixel *p, const tpixel *pe, uint16_t const *spl, const uint16
         while(p < pe - 8) {
             int c;
 
-            bgcol = cpu.vic.palette[cpu.vic.R[VIC_B0C]];
+            bgcol = cpu().vic.palette[cpu().vic.R[VIC_B0C]];
             colors[0] = bgcol;
 
-            if(cpu.vic.idle) {
+            if(cpu().vic.idle) {
                 cpu_clock(1);
                 c = colors[1] = colors[2] = colors[3] = 0;
-                chr = cpu.RAM[cpu.vic.bank + 0x3fff];
+                chr = cpu().RAM[cpu().vic.bank + 0x3fff];
             } else {
                 BADLINE(x);
 
-                colors[1] = cpu.vic.palette[cpu.vic.R[VIC_B1C]];
-                colors[2] = cpu.vic.palette[cpu.vic.R[VIC_B2C]];
+                colors[1] = cpu().vic.palette[cpu().vic.R[VIC_B1C]];
+                colors[2] = cpu().vic.palette[cpu().vic.R[VIC_B2C]];
 
-                chr = cpu.vic.charsetPtr[cpu.vic.lineMemChr[x] * 8];
-                c = cpu.vic.lineMemCol[x];
+                chr = cpu().vic.charsetPtr[cpu().vic.lineMemChr[x] * 8];
+                c = cpu().vic.lineMemCol[x];
             }
 
             x++;
 
             if((c & 0x08) == 0) { //Zeichen ist HIRES
-                fgcol = cpu.vic.palette[c & 0x07];
+                fgcol = cpu().vic.palette[c & 0x07];
                 *p++ = (chr & 0x80) ? fgcol : bgcol;
                 *p++ = (chr & 0x40) ? fgcol : bgcol;
                 *p++ = (chr & 0x20) ? fgcol : bgcol;
@@ -539,7 +636,7 @@ static void mode1(tpixel *p, const tpixel *pe, uint16_t const *spl, const uint16
                 *p++ = (chr & 0x02) ? fgcol : bgcol;
                 *p++ = (chr & 0x01) ? fgcol : bgcol;
             } else {//Zeichen ist MULTICOLOR
-                colors[3] = cpu.vic.palette[c & 0x07];
+                colors[3] = cpu().vic.palette[c & 0x07];
                 pixel = colors[(chr >> 6) & 0x03];
                 *p++ = pixel;
                 *p++ = pixel;
@@ -559,27 +656,27 @@ static void mode1(tpixel *p, const tpixel *pe, uint16_t const *spl, const uint16
 
             int c;
 
-            bgcol = cpu.vic.palette[cpu.vic.R[VIC_B0C]];
+            bgcol = cpu().vic.palette[cpu().vic.R[VIC_B0C]];
             colors[0] = bgcol;
 
-            if(cpu.vic.idle) {
+            if(cpu().vic.idle) {
                 cpu_clock(1);
                 c = colors[1] = colors[2] = colors[3] = 0;
-                chr = cpu.RAM[cpu.vic.bank + 0x3fff];
+                chr = cpu().RAM[cpu().vic.bank + 0x3fff];
             } else {
                 BADLINE(x);
 
-                colors[1] = cpu.vic.palette[cpu.vic.R[VIC_B1C]];
-                colors[2] = cpu.vic.palette[cpu.vic.R[VIC_B2C]];
+                colors[1] = cpu().vic.palette[cpu().vic.R[VIC_B1C]];
+                colors[2] = cpu().vic.palette[cpu().vic.R[VIC_B2C]];
 
-                chr = cpu.vic.charsetPtr[cpu.vic.lineMemChr[x] * 8];
-                c = cpu.vic.lineMemCol[x];
+                chr = cpu().vic.charsetPtr[cpu().vic.lineMemChr[x] * 8];
+                c = cpu().vic.lineMemCol[x];
             }
 
             x++;
 
             if((c & 0x08) == 0) { //Zeichen ist HIRES
-                fgcol = cpu.vic.palette[c & 0x07];
+                fgcol = cpu().vic.palette[c & 0x07];
                 *p++ = (chr & 0x80) ? fgcol : bgcol;
                 if(p >= pe) { break; }
                 *p++ = (chr & 0x40) ? fgcol : bgcol;
@@ -596,7 +693,7 @@ static void mode1(tpixel *p, const tpixel *pe, uint16_t const *spl, const uint16
                 if(p >= pe) { break; }
                 *p++ = (chr & 0x01) ? fgcol : bgcol;
             } else {//Zeichen ist MULTICOLOR
-                colors[3] = cpu.vic.palette[c & 0x07];
+                colors[3] = cpu().vic.palette[c & 0x07];
                 pixel = colors[(chr >> 6) & 0x03];
                 *p++ = pixel;
                 if(p >= pe) { break; }
@@ -697,13 +794,13 @@ static void mode2(tpixel *p, const tpixel *pe, uint16_t const *spl, const uint16
     uint16_t fgcol;
     uint16_t bgcol;
     uint8_t x = 0;
-    uint8_t *bP = cpu.vic.bitmapPtr + vc * 8 + cpu.vic.rc;
+    uint8_t *bP = cpu().vic.bitmapPtr + vc * 8 + cpu().vic.rc;
 
-    if(cpu.vic.lineHasSprites) {
+    if(cpu().vic.lineHasSprites) {
         do {
             BADLINE(x);
 
-            uint8_t t = cpu.vic.lineMemChr[x];
+            uint8_t t = cpu().vic.lineMemChr[x];
             fgcol = t >> 4;
             chr = bP[x * 8];
 
@@ -734,19 +831,19 @@ static void mode2(tpixel *p, const tpixel *pe, uint16_t const *spl, const uint16
 
                     if(spritePriority) {   // MxDP = 1
                         if(chr & 0x80) { //Vordergrundpixel ist gesetzt
-                            cpu.vic.fgcollision |= spriteBit;
+                            cpu().vic.fgcollision |= spriteBit;
                             pixel = fgcol;
                         }
                     } else {            // MxDP = 0
                         if(chr & 0x80) {
-                            cpu.vic.fgcollision |= spriteBit;
+                            cpu().vic.fgcollision |= spriteBit;
                         } //Vordergrundpixel ist gesetzt
                     }
                 } else {            // Kein Sprite
-                    pixel = (chr & 0x80) ? fgcol : cpu.vic.r.B0C;
+                    pixel = (chr & 0x80) ? fgcol : cpu().vic.r.B0C;
                 }
 
-                *p++ = cpu.vic.palette[pixel];
+                *p++ = cpu().vic.palette[pixel];
             }
         } while(p < pe);
         PRINTOVERFLOWS
@@ -756,9 +853,9 @@ static void mode2(tpixel *p, const tpixel *pe, uint16_t const *spl, const uint16
             //color-ram not used!
             BADLINE(x);
 
-            uint8_t t = cpu.vic.lineMemChr[x];
-            fgcol = cpu.vic.palette[t >> 4];
-            bgcol = cpu.vic.palette[t & 0x0f];
+            uint8_t t = cpu().vic.lineMemChr[x];
+            fgcol = cpu().vic.palette[t >> 4];
+            bgcol = cpu().vic.palette[t & 0x0f];
             chr = bP[x * 8];
             x++;
 
@@ -775,9 +872,9 @@ static void mode2(tpixel *p, const tpixel *pe, uint16_t const *spl, const uint16
             //color-ram not used!
             BADLINE(x);
 
-            uint8_t t = cpu.vic.lineMemChr[x];
-            fgcol = cpu.vic.palette[t >> 4];
-            bgcol = cpu.vic.palette[t & 0x0f];
+            uint8_t t = cpu().vic.lineMemChr[x];
+            fgcol = cpu().vic.palette[t >> 4];
+            bgcol = cpu().vic.palette[t & 0x0f];
             chr = bP[x * 8];
 
             x++;
@@ -861,27 +958,27 @@ static void mode3(tpixel *p, const tpixel *pe, uint16_t const *spl, const uint16
          | "11": Color from bits 8-11 of c-data  |
          +---------------------------------------+
      */
-    uint8_t *bP = cpu.vic.bitmapPtr + vc * 8 + cpu.vic.rc;
+    uint8_t *bP = cpu().vic.bitmapPtr + vc * 8 + cpu().vic.rc;
     uint16_t colors[4];
     uint8_t pixel;
     uint8_t chr, x;
 
     x = 0;
 
-    if(cpu.vic.lineHasSprites) {
-        colors[0] = cpu.vic.r.B0C;
+    if(cpu().vic.lineHasSprites) {
+        colors[0] = cpu().vic.r.B0C;
 
         do {
-            if(cpu.vic.idle) {
+            if(cpu().vic.idle) {
                 cpu_clock(1);
                 colors[1] = colors[2] = colors[3] = 0;
-                chr = cpu.RAM[cpu.vic.bank + 0x3fff];
+                chr = cpu().RAM[cpu().vic.bank + 0x3fff];
             } else {
                 BADLINE(x);
-                uint8_t t = cpu.vic.lineMemChr[x];
+                uint8_t t = cpu().vic.lineMemChr[x];
                 colors[1] = t >> 4;//10
                 colors[2] = t & 0x0f; //01
-                colors[3] = cpu.vic.lineMemCol[x];
+                colors[3] = cpu().vic.lineMemCol[x];
                 chr = bP[x * 8];
             }
 
@@ -905,19 +1002,19 @@ static void mode3(tpixel *p, const tpixel *pe, uint16_t const *spl, const uint16
 
                     if(spritePriority) {  // MxDP = 1
                         if(c & 0x02) {  //Vordergrundpixel ist gesetzt
-                            cpu.vic.fgcollision |= spriteBit;
+                            cpu().vic.fgcollision |= spriteBit;
                             pixel = colors[c];
                         }
                     } else {          // MxDP = 0
                         if(c & 0x02) {
-                            cpu.vic.fgcollision |= spriteBit;
+                            cpu().vic.fgcollision |= spriteBit;
                         } //Vordergundpixel ist gesetzt
                     }
                 } else { // Kein Sprite
                     pixel = colors[c];
                 }
 
-                *p++ = cpu.vic.palette[pixel];
+                *p++ = cpu().vic.palette[pixel];
                 if(p >= pe) { break; }
 
                 spriteLineData = *spl++;
@@ -930,37 +1027,37 @@ static void mode3(tpixel *p, const tpixel *pe, uint16_t const *spl, const uint16
 
                     if(spritePriority) {  // MxDP = 1
                         if(c & 0x02) {  //Vordergrundpixel ist gesetzt
-                            cpu.vic.fgcollision |= spriteBit;
+                            cpu().vic.fgcollision |= spriteBit;
                             pixel = colors[c];
                         }
                     } else {          // MxDP = 0
                         if(c & 0x02) {
-                            cpu.vic.fgcollision |= spriteBit;
+                            cpu().vic.fgcollision |= spriteBit;
                         } //Vordergundpixel ist gesetzt
                     }
                 } else { // Kein Sprite
                     pixel = colors[c];
                 }
 
-                *p++ = cpu.vic.palette[pixel];
+                *p++ = cpu().vic.palette[pixel];
             }
         } while(p < pe);
         PRINTOVERFLOWS
     } else { //Keine Sprites
         while(p < pe - 8) {
-            colors[0] = cpu.vic.palette[cpu.vic.R[VIC_B0C]];
+            colors[0] = cpu().vic.palette[cpu().vic.R[VIC_B0C]];
 
-            if(cpu.vic.idle) {
+            if(cpu().vic.idle) {
                 cpu_clock(1);
                 colors[1] = colors[2] = colors[3] = 0;
-                chr = cpu.RAM[cpu.vic.bank + 0x3fff];
+                chr = cpu().RAM[cpu().vic.bank + 0x3fff];
             } else {
                 BADLINE(x);
 
-                uint8_t t = cpu.vic.lineMemChr[x];
-                colors[1] = cpu.vic.palette[t >> 4];//10
-                colors[2] = cpu.vic.palette[t & 0x0f]; //01
-                colors[3] = cpu.vic.palette[cpu.vic.lineMemCol[x]];
+                uint8_t t = cpu().vic.lineMemChr[x];
+                colors[1] = cpu().vic.palette[t >> 4];//10
+                colors[2] = cpu().vic.palette[t & 0x0f]; //01
+                colors[3] = cpu().vic.palette[cpu().vic.lineMemCol[x]];
                 chr = bP[x * 8];
             }
 
@@ -979,19 +1076,19 @@ static void mode3(tpixel *p, const tpixel *pe, uint16_t const *spl, const uint16
             *p++ = pixel;
         }
         while(p < pe) {
-            colors[0] = cpu.vic.palette[cpu.vic.R[VIC_B0C]];
+            colors[0] = cpu().vic.palette[cpu().vic.R[VIC_B0C]];
 
-            if(cpu.vic.idle) {
+            if(cpu().vic.idle) {
                 cpu_clock(1);
                 colors[1] = colors[2] = colors[3] = 0;
-                chr = cpu.RAM[cpu.vic.bank + 0x3fff];
+                chr = cpu().RAM[cpu().vic.bank + 0x3fff];
             } else {
                 BADLINE(x);
 
-                uint8_t t = cpu.vic.lineMemChr[x];
-                colors[1] = cpu.vic.palette[t >> 4];//10
-                colors[2] = cpu.vic.palette[t & 0x0f]; //01
-                colors[3] = cpu.vic.palette[cpu.vic.lineMemCol[x]];
+                uint8_t t = cpu().vic.lineMemChr[x];
+                colors[1] = cpu().vic.palette[t >> 4];//10
+                colors[2] = cpu().vic.palette[t & 0x0f]; //01
+                colors[3] = cpu().vic.palette[cpu().vic.lineMemCol[x]];
                 chr = bP[x * 8];
             }
 
@@ -1086,14 +1183,14 @@ static void mode4(tpixel *p, const tpixel *pe, uint16_t const *spl, const uint16
     uint8_t x = 0;
 
     CHARSETPTR();
-    if(cpu.vic.lineHasSprites) {
+    if(cpu().vic.lineHasSprites) {
         do {
             BADLINE(x);
 
-            uint32_t td = cpu.vic.lineMemChr[x];
-            bgcol = cpu.vic.R[VIC_B0C + ((td >> 6) & 0x03)];
-            chr = cpu.vic.charsetPtr[(td & 0x3f) * 8];
-            fgcol = cpu.vic.lineMemCol[x];
+            uint32_t td = cpu().vic.lineMemChr[x];
+            bgcol = cpu().vic.R[VIC_B0C + ((td >> 6) & 0x03)];
+            chr = cpu().vic.charsetPtr[(td & 0x3f) * 8];
+            fgcol = cpu().vic.lineMemCol[x];
 
             x++;
 
@@ -1110,12 +1207,12 @@ static void mode4(tpixel *p, const tpixel *pe, uint16_t const *spl, const uint16
 
                     if(spritePriority) {   // Sprite: Hinter Text
                         if(chr & 0x80) {
-                            cpu.vic.fgcollision |= spriteBit;
+                            cpu().vic.fgcollision |= spriteBit;
                             pixel = fgcol;
                         } else { pixel = bgcol; }
                     } else {              // Sprite: Vor Text
                         if(chr & 0x80) {
-                            cpu.vic.fgcollision |= spriteBit;
+                            cpu().vic.fgcollision |= spriteBit;
                         }
                     }
                 } else {                // Kein Sprite
@@ -1123,7 +1220,7 @@ static void mode4(tpixel *p, const tpixel *pe, uint16_t const *spl, const uint16
                 }
 
                 chr = chr << 1;
-                *p++ = cpu.vic.palette[pixel];
+                *p++ = cpu().vic.palette[pixel];
             }
         } while(p < pe);
         PRINTOVERFLOWS
@@ -1131,10 +1228,10 @@ static void mode4(tpixel *p, const tpixel *pe, uint16_t const *spl, const uint16
         while(p < pe - 8) {
             BADLINE(x);
 
-            uint32_t td = cpu.vic.lineMemChr[x];
-            bgcol = cpu.vic.palette[cpu.vic.R[VIC_B0C + ((td >> 6) & 0x03)]];
-            chr = cpu.vic.charsetPtr[(td & 0x3f) * 8];
-            fgcol = cpu.vic.palette[cpu.vic.lineMemCol[x]];
+            uint32_t td = cpu().vic.lineMemChr[x];
+            bgcol = cpu().vic.palette[cpu().vic.R[VIC_B0C + ((td >> 6) & 0x03)]];
+            chr = cpu().vic.charsetPtr[(td & 0x3f) * 8];
+            fgcol = cpu().vic.palette[cpu().vic.lineMemCol[x]];
             x++;
 
             *p++ = (chr & 0x80) ? fgcol : bgcol;
@@ -1151,10 +1248,10 @@ static void mode4(tpixel *p, const tpixel *pe, uint16_t const *spl, const uint16
     while(p < pe) {
         BADLINE(x);
 
-        uint32_t td = cpu.vic.lineMemChr[x];
-        bgcol = cpu.vic.palette[cpu.vic.R[VIC_B0C + ((td >> 6) & 0x03)]];
-        chr = cpu.vic.charsetPtr[(td & 0x3f) * 8];
-        fgcol = cpu.vic.palette[cpu.vic.lineMemCol[x]];
+        uint32_t td = cpu().vic.lineMemChr[x];
+        bgcol = cpu().vic.palette[cpu().vic.R[VIC_B0C + ((td >> 6) & 0x03)]];
+        chr = cpu().vic.charsetPtr[(td & 0x3f) * 8];
+        fgcol = cpu().vic.palette[cpu().vic.lineMemCol[x]];
 
         x++;
 
@@ -1247,12 +1344,12 @@ static void mode5(tpixel *p, const tpixel *pe, uint16_t const *spl, const uint16
     uint16_t fgcol;
     uint8_t x = 0;
 
-    if(cpu.vic.lineHasSprites) {
+    if(cpu().vic.lineHasSprites) {
         do {
             BADLINE(x);
 
-            chr = cpu.vic.charsetPtr[(cpu.vic.lineMemChr[x] & 0x3F) * 8];
-            fgcol = cpu.vic.lineMemCol[x];
+            chr = cpu().vic.charsetPtr[(cpu().vic.lineMemChr[x] & 0x3F) * 8];
+            fgcol = cpu().vic.lineMemCol[x];
 
             x++;
 
@@ -1282,19 +1379,19 @@ static void mode5(tpixel *p, const tpixel *pe, uint16_t const *spl, const uint16
 
                         if(spritePriority) {   // MxDP = 1
                             if(chr & 0x80) { //Vordergrundpixel ist gesetzt
-                                cpu.vic.fgcollision |= spriteBit;
+                                cpu().vic.fgcollision |= spriteBit;
                                 pixel = 0;
                             }
                         } else {            // MxDP = 0
                             if(chr & 0x80) {
-                                cpu.vic.fgcollision |= spriteBit;
+                                cpu().vic.fgcollision |= spriteBit;
                             } //Vordergrundpixel ist gesetzt
                         }
                     } else {            // Kein Sprite
                         pixel = 0;
                     }
 
-                    *p++ = cpu.vic.palette[pixel];
+                    *p++ = cpu().vic.palette[pixel];
 
                     chr = chr << 1;
                 }
@@ -1316,19 +1413,19 @@ static void mode5(tpixel *p, const tpixel *pe, uint16_t const *spl, const uint16
 
                         if(spritePriority) {  // MxDP = 1
                             if(chr & 0x80) {  //Vordergrundpixel ist gesetzt
-                                cpu.vic.fgcollision |= spriteBit;
+                                cpu().vic.fgcollision |= spriteBit;
                                 pixel = 0;
                             }
                         } else {          // MxDP = 0
                             if(chr & 0x80) {
-                                cpu.vic.fgcollision |= spriteBit;
+                                cpu().vic.fgcollision |= spriteBit;
                             } //Vordergrundpixel ist gesetzt
                         }
                     } else { // Kein Sprite
                         pixel = 0;
                     }
 
-                    *p++ = cpu.vic.palette[pixel];
+                    *p++ = cpu().vic.palette[pixel];
 
                     if(p >= pe) {
                         break;
@@ -1345,18 +1442,18 @@ static void mode5(tpixel *p, const tpixel *pe, uint16_t const *spl, const uint16
 
                         if(spritePriority) {  // MxDP = 1
                             if(chr & 0x80) { //Vordergrundpixel ist gesetzt
-                                cpu.vic.fgcollision |= spriteBit;
+                                cpu().vic.fgcollision |= spriteBit;
                                 pixel = 0;
                             }
                         } else {          // MxDP = 0
                             if(chr & 0x80) {
-                                cpu.vic.fgcollision |= spriteBit;
+                                cpu().vic.fgcollision |= spriteBit;
                             } //Vordergrundpixel ist gesetzt
                         }
                     } else { // Kein Sprite
                         pixel = 0;
                     }
-                    *p++ = cpu.vic.palette[pixel];
+                    *p++ = cpu().vic.palette[pixel];
                 }
             }
         } while(p < pe);
@@ -1364,7 +1461,7 @@ static void mode5(tpixel *p, const tpixel *pe, uint16_t const *spl, const uint16
         PRINTOVERFLOWS
     } else { //Keine Sprites
         //Farbe immer schwarz
-        const uint16_t bgcol = cpu.vic.palette[0];
+        const uint16_t bgcol = cpu().vic.palette[0];
 
         while(p < pe - 8) {
             BADLINE(x);
@@ -1467,9 +1564,9 @@ static void mode6(tpixel *p, const tpixel *pe, uint16_t const *spl, const uint16
 
     uint8_t chr, pixel;
     uint8_t x = 0;
-    uint8_t *bP = cpu.vic.bitmapPtr + vc * 8 + cpu.vic.rc;
+    uint8_t *bP = cpu().vic.bitmapPtr + vc * 8 + cpu().vic.rc;
 
-    if(cpu.vic.lineHasSprites) {
+    if(cpu().vic.lineHasSprites) {
 
         do {
             BADLINE(x);
@@ -1503,25 +1600,25 @@ static void mode6(tpixel *p, const tpixel *pe, uint16_t const *spl, const uint16
 
                     if(spritePriority) {   // MxDP = 1
                         if(chr & 0x80) { //Vordergrundpixel ist gesetzt
-                            cpu.vic.fgcollision |= spriteBit;
+                            cpu().vic.fgcollision |= spriteBit;
                             pixel = 0;
                         }
                     } else {            // MxDP = 0
                         if(chr & 0x80) {
-                            cpu.vic.fgcollision |= spriteBit;
+                            cpu().vic.fgcollision |= spriteBit;
                         } //Vordergrundpixel ist gesetzt
                     }
                 } else {            // Kein Sprite
                     pixel = 0;
                 }
 
-                *p++ = cpu.vic.palette[pixel];
+                *p++ = cpu().vic.palette[pixel];
             }
         } while(p < pe);
         PRINTOVERFLOWS
     } else { //Keine Sprites
         //Farbe immer schwarz
-        const uint16_t bgcol = cpu.vic.palette[0];
+        const uint16_t bgcol = cpu().vic.palette[0];
         while(p < pe - 8) {
             BADLINE(x);
 
@@ -1628,9 +1725,9 @@ static void mode7(tpixel *p, const tpixel *pe, uint16_t const *spl, const uint16
     uint8_t chr;
     uint8_t x = 0;
     uint8_t pixel;
-    uint8_t *bP = cpu.vic.bitmapPtr + vc * 8 + cpu.vic.rc;
+    uint8_t *bP = cpu().vic.bitmapPtr + vc * 8 + cpu().vic.rc;
 
-    if(cpu.vic.lineHasSprites) {
+    if(cpu().vic.lineHasSprites) {
         do {
             BADLINE(x);
 
@@ -1652,19 +1749,19 @@ static void mode7(tpixel *p, const tpixel *pe, uint16_t const *spl, const uint16
 
                     if(spritePriority) {  // MxDP = 1
                         if(chr & 0x80) {  //Vordergrundpixel ist gesetzt
-                            cpu.vic.fgcollision |= spriteBit;
+                            cpu().vic.fgcollision |= spriteBit;
                             pixel = 0;
                         }
                     } else {          // MxDP = 0
                         if(chr & 0x80) {
-                            cpu.vic.fgcollision |= spriteBit;
+                            cpu().vic.fgcollision |= spriteBit;
                         } //Vordergundpixel ist gesetzt
                     }
                 } else { // Kein Sprite
                     pixel = 0;
                 }
 
-                *p++ = cpu.vic.palette[pixel];
+                *p++ = cpu().vic.palette[pixel];
 
                 if(p >= pe) { break; }
 
@@ -1678,25 +1775,25 @@ static void mode7(tpixel *p, const tpixel *pe, uint16_t const *spl, const uint16
 
                     if(spritePriority) {  // MxDP = 1
                         if(chr & 0x80) {  //Vordergrundpixel ist gesetzt
-                            cpu.vic.fgcollision |= spriteBit;
+                            cpu().vic.fgcollision |= spriteBit;
                             pixel = 0;
                         }
                     } else {          // MxDP = 0
                         if(chr & 0x80) {
-                            cpu.vic.fgcollision |= spriteBit;
+                            cpu().vic.fgcollision |= spriteBit;
                         } //Vordergundpixel ist gesetzt
                     }
                 } else { // Kein Sprite
                     pixel = 0;
                 }
 
-                *p++ = cpu.vic.palette[pixel];
+                *p++ = cpu().vic.palette[pixel];
             }
         } while(p < pe);
 
         PRINTOVERFLOWS
     } else { //Keine Sprites
-        const uint16_t bgcol = cpu.vic.palette[0];
+        const uint16_t bgcol = cpu().vic.palette[0];
 
         while(p < pe - 8) {
             BADLINE(x);
@@ -1765,27 +1862,37 @@ void tvic::render() {
     /* Linecounter ***************************************************************************************/
     /*****************************************************************************************************/
 
-    if(cpu.vic.rasterLine >= LINECNT) {
+    if(cpu().vic.rasterLine >= LINECNT) {
         //reSID sound needs much time - too much to keep everything in sync and with stable refreshrate
         //but it is not called very often, so most of the time, we have more time than needed.
         //We can measure the time needed for a frame and calc a correction factor to speed things up.
         unsigned long m = cycleCountMicros();
 
-        cpu.vic.neededTime = (m - cpu.vic.timeStart);
-        cpu.vic.timeStart = m;
-        cpu.vic.lineClock.update(LINETIMER_DEFAULT_FREQ -
-                                 ((float) cpu.vic.neededTime / (float) LINECNT - LINETIMER_DEFAULT_FREQ));
-        cpu.vic.rasterLine = 0;
-        cpu.vic.vcbase = 0;
-        cpu.vic.denLatch = 0;
+        cpu().vic.neededTime = (m - cpu().vic.timeStart);
+        cpu().vic.timeStart = m;
+
+        if(!warp.on) {
+            cpu().vic.lineClock.update(LINETIMER_DEFAULT_FREQ -
+                                       ((float) cpu().vic.neededTime / (float) LINECNT - LINETIMER_DEFAULT_FREQ));
+        }
+
+#if MACHINES > 1
+        if(cpu().vic.video && !warp.skipFrame) { videoStreamFrame(cpu().vic); }
+#endif
+
+        warpFrame();
+
+        cpu().vic.rasterLine = 0;
+        cpu().vic.vcbase = 0;
+        cpu().vic.denLatch = 0;
     } else {
-        cpu.vic.rasterLine++;
+        cpu().vic.rasterLine++;
     }
 
-    int rasterLine = cpu.vic.rasterLine;
+    int rasterLine = cpu().vic.rasterLine;
 
-    if(rasterLine == cpu.vic.intRasterLine) {//Set Rasterline-Interrupt
-        cpu.vic.R[VIC_IRQST] |= VIC_IRQST_IRST | (cpu.vic.R[VIC_IRQEN] & VIC_IRQEN_ERST ? VIC_IRQST_IRQ : 0);
+    if(rasterLine == cpu().vic.intRasterLine) {//Set Rasterline-Interrupt
+        cpu().vic.R[VIC_IRQST] |= VIC_IRQST_IRST | (cpu().vic.R[VIC_IRQEN] & VIC_IRQEN_ERST ? VIC_IRQST_IRQ : 0);
     }
 
     /*****************************************************************************************************/
@@ -1798,7 +1905,7 @@ void tvic::render() {
         DEN bit was set during an arbitrary cycle of raster line $30.
     */
 
-    if(rasterLine == 0x30) { cpu.vic.denLatch |= cpu.vic.r.DEN; }
+    if(rasterLine == 0x30) { cpu().vic.denLatch |= cpu().vic.r.DEN; }
 
     /* 3.7.2
         2. In the first phase of cycle 14 of each line, VC is loaded from VCBASE
@@ -1806,22 +1913,22 @@ void tvic::render() {
            this phase, RC is also reset to zero.
     */
 
-    vc = cpu.vic.vcbase;
+    vc = cpu().vic.vcbase;
 
-    cpu.vic.badline = (cpu.vic.denLatch && (rasterLine >= 0x30) && (rasterLine <= 0xf7) && ((rasterLine & 0x07) == cpu.vic.r.YSCROLL));
+    cpu().vic.badline = (cpu().vic.denLatch && (rasterLine >= 0x30) && (rasterLine <= 0xf7) && ((rasterLine & 0x07) == cpu().vic.r.YSCROLL));
 
-    if(cpu.vic.badline) {
-        cpu.vic.idle = 0;
-        cpu.vic.rc = 0;
+    if(cpu().vic.badline) {
+        cpu().vic.idle = 0;
+        cpu().vic.rc = 0;
     }
 
     /*****************************************************************************************************/
     /*****************************************************************************************************/
 #if 1
     {
-        int t = MAXCYCLESSPRITES3_7 - cpu.vic.spriteCycles3_7;
+        int t = MAXCYCLESSPRITES3_7 - cpu().vic.spriteCycles3_7;
         if(t > 0) { cpu_clock(t); }
-        if(cpu.vic.spriteCycles3_7 > 0) { cia_clockt(cpu.vic.spriteCycles3_7); }
+        if(cpu().vic.spriteCycles3_7 > 0) { cia_clockt(cpu().vic.spriteCycles3_7); }
     }
 #endif
 
@@ -1839,12 +1946,12 @@ void tvic::render() {
            1 | 25 text lines/200 pixels |   51 ($33)  | 250 ($fa)
     */
 
-    if(cpu.vic.borderFlag) {
-        int firstLine = (cpu.vic.r.RSEL) ? 0x33 : 0x37;
-        if((cpu.vic.r.DEN) && (rasterLine == firstLine)) { cpu.vic.borderFlag = false; }
+    if(cpu().vic.borderFlag) {
+        int firstLine = (cpu().vic.r.RSEL) ? 0x33 : 0x37;
+        if((cpu().vic.r.DEN) && (rasterLine == firstLine)) { cpu().vic.borderFlag = false; }
     } else {
-        int lastLine = (cpu.vic.r.RSEL) ? 0xfb : 0xf7;
-        if(rasterLine == lastLine) { cpu.vic.borderFlag = true; }
+        int lastLine = (cpu().vic.r.RSEL) ? 0xfb : 0xf7;
+        if(rasterLine == lastLine) { cpu().vic.borderFlag = true; }
     }
 
     if(rasterLine < FIRSTDISPLAYLINE || rasterLine > LASTDISPLAYLINE) {
@@ -1856,18 +1963,85 @@ void tvic::render() {
         goto noDisplayIncRC;
     }
 
-    //max_x =  (!cpu.vic.CSEL) ? 40:38;
-    p = screenMem + (rasterLine - FIRSTDISPLAYLINE) * LINE_MEM_WIDTH;
+    //max_x =  (!cpu().vic.CSEL) ? 40:38;
+    p = lineMem(rasterLine);
 
     pe = p + SCREEN_WIDTH;
     //Left Screenborder: Cycle 10
-    spl = &cpu.vic.spriteLine[24];
+    spl = &cpu().vic.spriteLine[24];
     cpu_clock(6);
 
+#if MACHINES > 1
+    if((warp.skipFrame || cpu().vic.pipeline) && !cpu().vic.lineHasSprites) {
+        //Pipelined: the pixels are drawn by the render thread from what is recorded in line
+        tpipelineLine *line = pipelineLine(p);
+#else
+    if(warp.skipFrame && !cpu().vic.lineHasSprites) {
+#endif
+        //Warp mode, frame not drawn: the cycles and badline fetches of the code below, without the pixels
+        if(cpu().vic.borderFlag) {
+            cpu_clock(5);
+#if MACHINES > 1
+            if(line) {
+                line->border = 1;
+                line->borderLeft = cpu().vic.R[VIC_EC];
+                vicPipelinePublish(cpu().vic.pipeline);
+            }
+#endif
+            for(int i = 0; i < (SCREEN_WIDTH + BORDER_RIGHT) / 8; i++) { CYCLES(1); }
+            goto noDisplayIncRC;
+        }
+
+        xscroll = cpu().vic.r.XSCROLL;
+#if MACHINES > 1
+        if(line) {
+            line->xscroll = xscroll;
+            line->borderLeft = cpu().vic.R[VIC_EC];
+        }
+#endif
+        if(xscroll > 0 && !cpu().vic.r.CSEL) { cpu_clock(1); }
+
+        cpu().vic.fgcollision = 0;
+        mode = (cpu().vic.r.ECM << 2) | (cpu().vic.r.BMM << 1) | cpu().vic.r.MCM;
+
+        if(!cpu().vic.idle || mode == 1 || mode == 3) {
+            bool display = !cpu().vic.idle;
+#if MACHINES > 1
+            if(line) {
+                const uint8_t *charset = cpu().vic.charsetPtrBase + cpu().vic.rc;
+                const uint8_t *bitmap = cpu().vic.bitmapPtr + vc * 8 + cpu().vic.rc;
+
+                for(int x = 0; x < 40; x++) {
+                    uint8_t b0c = cpu().vic.R[VIC_B0C];
+                    BADLINE(x);
+                    pipelineChar(line->ch[x], mode, x, charset, bitmap, b0c);
+                }
+            } else
+#endif
+            for(int x = 0; x < 40; x++) { BADLINE(x); }
+            if(display) { vc = (vc + 40) & 0x3ff; }
+        } else {
+#if MACHINES > 1
+            if(line) { memset(line->ch, 0, sizeof(line->ch)); } //idle: black
+#endif
+            for(int i = 0; i < (SCREEN_WIDTH - xscroll) / 8; i++) { CYCLES(1); }
+        }
+
+        if(!cpu().vic.r.CSEL) { cpu_clock(1); }
+#if MACHINES > 1
+        if(line) {
+            line->borderRight = cpu().vic.R[VIC_EC];
+            vicPipelinePublish(cpu().vic.pipeline);
+        }
+#endif
+        cpu_clock(5);
+        goto noDisplayIncRC;
+    }
+
 
-    if(cpu.vic.borderFlag) {
+    if(cpu().vic.borderFlag) {
         cpu_clock(5);
-        fastFillLineNoSprites(p, pe + BORDER_RIGHT, cpu.vic.palette[cpu.vic.R[VIC_EC]]);
+        fastFillLineNoSprites(p, pe + BORDER_RIGHT, cpu().vic.palette[cpu().vic.R[VIC_EC]]);
         goto noDisplayIncRC;
     }
 
@@ -1876,12 +2050,12 @@ void tvic::render() {
     /* DISPLAY *******************************************************************************************/
     /*****************************************************************************************************/
 
-    xscroll = cpu.vic.r.XSCROLL;
+    xscroll = cpu().vic.r.XSCROLL;
 
     if(xscroll > 0) {
-        uint16_t col = cpu.vic.palette[cpu.vic.R[VIC_EC]];
+        uint16_t col = cpu().vic.palette[cpu().vic.R[VIC_EC]];
 
-        if(!cpu.vic.r.CSEL) {
+        if(!cpu().vic.r.CSEL) {
             cpu_clock(1);
             uint16_t sprite;
             for(int i = 0; i < xscroll; i++) {
@@ -1900,10 +2074,10 @@ void tvic::render() {
     /*****************************************************************************************************/
 
 
-    cpu.vic.fgcollision = 0;
-    mode = (cpu.vic.r.ECM << 2) | (cpu.vic.r.BMM << 1) | cpu.vic.r.MCM;
+    cpu().vic.fgcollision = 0;
+    mode = (cpu().vic.r.ECM << 2) | (cpu().vic.r.BMM << 1) | cpu().vic.r.MCM;
 
-    if(!cpu.vic.idle) {
+    if(!cpu().vic.idle) {
         modes[mode](p, pe, spl, vc);
         vc = (vc + 40) & 0x3ff;
     } else {
@@ -1980,7 +2154,7 @@ void tvic::render() {
         if(mode == 1 || mode == 3) {
             modes[mode](p, pe, spl, vc);
         } else {
-            fastFillLine(p, pe, cpu.vic.palette[0], spl);
+            fastFillLine(p, pe, cpu().vic.palette[0], spl);
         }
     }
 
@@ -1992,26 +2166,26 @@ void tvic::render() {
         it.
      */
 
-    if(cpu.vic.fgcollision) {
-        if(cpu.vic.r.MD == 0) {
-            cpu.vic.R[VIC_IRQST] |= VIC_IRQST_IMBC | (cpu.vic.R[VIC_IRQEN] & VIC_IRQEN_EMBC ? VIC_IRQST_IRQ : 0);
+    if(cpu().vic.fgcollision) {
+        if(cpu().vic.r.MD == 0) {
+            cpu().vic.R[VIC_IRQST] |= VIC_IRQST_IMBC | (cpu().vic.R[VIC_IRQEN] & VIC_IRQEN_EMBC ? VIC_IRQST_IRQ : 0);
         }
 
-        cpu.vic.r.MD |= cpu.vic.fgcollision;
+        cpu().vic.r.MD |= cpu().vic.fgcollision;
     }
 
     /*****************************************************************************************************/
 
-    if(!cpu.vic.r.CSEL) {
+    if(!cpu().vic.r.CSEL) {
         cpu_clock(1);
-        uint16_t col = cpu.vic.palette[cpu.vic.R[VIC_EC]];
+        uint16_t col = cpu().vic.palette[cpu().vic.R[VIC_EC]];
         //p = &screen[rasterLine - FIRSTDISPLAYLINE][0];
-        p = screenMem + (rasterLine - FIRSTDISPLAYLINE) * LINE_MEM_WIDTH + BORDER_LEFT;
+        p = lineMem(rasterLine) + BORDER_LEFT;
 #if 0
         // Sprites im Rand
         uint16_t sprite;
         uint16_t * spl;
-        spl = &cpu.vic.spriteLine[24 + xscroll];
+        spl = &cpu().vic.spriteLine[24 + xscroll];
 
         SPRITEORFIXEDCOLOR();
         SPRITEORFIXEDCOLOR();
@@ -2033,12 +2207,12 @@ void tvic::render() {
 
         //Rand rechts:
         //p = &screen[rasterLine - FIRSTDISPLAYLINE][SCREEN_WIDTH - 9];
-        p = screenMem + (rasterLine - FIRSTDISPLAYLINE) * LINE_MEM_WIDTH + SCREEN_WIDTH - 9 + BORDER_LEFT;
+        p = lineMem(rasterLine) + SCREEN_WIDTH - 9 + BORDER_LEFT;
         pe = p + 9;
 
 #if 0
         // Sprites im Rand
-        spl = &cpu.vic.spriteLine[24 + SCREEN_WIDTH - 9 + xscroll];
+        spl = &cpu().vic.spriteLine[24 + SCREEN_WIDTH - 9 + xscroll];
         while (p < pe) {
           SPRITEORFIXEDCOLOR();
         }
@@ -2063,14 +2237,14 @@ void tvic::render() {
            if there is a Bad Line Condition), RC is incremented.
     */
 
-    if(cpu.vic.rc == 7) {
-        cpu.vic.idle = 1;
-        cpu.vic.vcbase = vc;
+    if(cpu().vic.rc == 7) {
+        cpu().vic.idle = 1;
+        cpu().vic.vcbase = vc;
     }
 
     // Ist dies richtig ??
-    if((!cpu.vic.idle) || (cpu.vic.denLatch && (rasterLine >= 0x30) && (rasterLine <= 0xf7) && ((rasterLine & 0x07) == cpu.vic.r.YSCROLL))) {
-        cpu.vic.rc = (cpu.vic.rc + 1) & 0x07;
+    if((!cpu().vic.idle) || (cpu().vic.denLatch && (rasterLine >= 0x30) && (rasterLine <= 0xf7) && ((rasterLine & 0x07) == cpu().vic.r.YSCROLL))) {
+        cpu().vic.rc = (cpu().vic.rc + 1) & 0x07;
     }
 
 
@@ -2078,19 +2252,19 @@ void tvic::render() {
     /* Sprites *******************************************************************************************/
     /*****************************************************************************************************/
 
-    cpu.vic.spriteCycles0_2 = 0;
-    cpu.vic.spriteCycles3_7 = 0;
+    cpu().vic.spriteCycles0_2 = 0;
+    cpu().vic.spriteCycles3_7 = 0;
 
-    if(cpu.vic.lineHasSprites) {
-        cpu.vic.lineHasSprites = 0;
+    if(cpu().vic.lineHasSprites) {
+        cpu().vic.lineHasSprites = 0;
 
-        memset(cpu.vic.spriteLine, 0, sizeof(cpu.vic.spriteLine));
+        memset(cpu().vic.spriteLine, 0, sizeof(cpu().vic.spriteLine));
     }
 
-    uint32_t spritesEnabled = cpu.vic.R[VIC_MxE];
+    uint32_t spritesEnabled = cpu().vic.R[VIC_MxE];
 
     if(spritesEnabled) {
-        uint8_t spritesYExpanded = cpu.vic.R[VIC_MxYE];
+        uint8_t spritesYExpanded = cpu().vic.R[VIC_MxYE];
         uint8_t collision = 0;
         uint8_t lastSpriteNum = 0;
 
@@ -2104,7 +2278,7 @@ void tvic::render() {
             if(spritesEnabled & spriteBit) {
                 spritesEnabled &= ~spriteBit;
 
-                uint8_t spriteYPos = cpu.vic.R[VIC_M0Y + spriteNum * 2];
+                uint8_t spriteYPos = cpu().vic.R[VIC_M0Y + spriteNum * 2];
                 bool spriteYExpanded = spritesYExpanded & spriteBit;
 
                 // does the rasterline cross the sprite?
@@ -2114,16 +2288,16 @@ void tvic::render() {
                     // Sprite cycles
                     if(spriteNum < 3) {
                         if(!lastSpriteNum) {
-                            cpu.vic.spriteCycles0_2 += 1;
+                            cpu().vic.spriteCycles0_2 += 1;
                         }
 
-                        cpu.vic.spriteCycles0_2 += 2;
+                        cpu().vic.spriteCycles0_2 += 2;
                     } else {
                         if(!lastSpriteNum) {
-                            cpu.vic.spriteCycles3_7 += 1;
+                            cpu().vic.spriteCycles3_7 += 1;
                         }
 
-                        cpu.vic.spriteCycles3_7 += 2;
+                        cpu().vic.spriteCycles3_7 += 2;
                     }
 
                     lastSpriteNum = spriteNum;
@@ -2132,8 +2306,8 @@ void tvic::render() {
                         continue;
                     }
 
-                    uint16_t spriteXPos = ((cpu.vic.R[VIC_MxX8] & spriteBit) ? 0x100 : 0) |
-                                            cpu.vic.R[VIC_M0X + spriteNum * 2];
+                    uint16_t spriteXPos = ((cpu().vic.R[VIC_MxX8] & spriteBit) ? 0x100 : 0) |
+                                            cpu().vic.R[VIC_M0X + spriteNum * 2];
 
                     if(spriteXPos >= SPRITE_MAX_X) {
                         continue;
@@ -2146,20 +2320,20 @@ void tvic::render() {
                     }
 
                     // address of sprite line in memory
-                    uint16_t spriteAdr = cpu.vic.bank |
-                                         cpu.RAM[cpu.vic.videomatrix + (1024 - 8) + spriteNum] << 6 |
+                    uint16_t spriteAdr = cpu().vic.bank |
+                                         cpu().RAM[cpu().vic.videomatrix + (1024 - 8) + spriteNum] << 6 |
                                          (lineOfSprite * 3);
 
                     // 24 bits of sprite data for the line
-                    uint32_t spriteData = ((unsigned) cpu.RAM[spriteAdr] << 16) |
-                                          ((unsigned) cpu.RAM[spriteAdr + 1] << 8) |
-                                          ((unsigned) cpu.RAM[spriteAdr + 2]);
+                    uint32_t spriteData = ((unsigned) cpu().RAM[spriteAdr] << 16) |
+                                          ((unsigned) cpu().RAM[spriteAdr + 1] << 8) |
+                                          ((unsigned) cpu().RAM[spriteAdr + 2]);
 
                     if(!spriteData) {
                         continue;
                     }
 
-                    cpu.vic.lineHasSprites = 1;
+                    cpu().vic.lineHasSprites = 1;
 
                     // "spriteLine" contains 16 bit per pixel for the current raster line.
                     // If bit 15 is set, a sprite is present for that pixel. Bit 14 then specifies whether the
@@ -2169,15 +2343,15 @@ void tvic::render() {
                     // Sprites have implicit priorities with sprite 0's priority being the highest.
                     // Thus spriteLine data will only be written if it contains zero. Even for sprite number 0 and color
                     // number 0 will contain 0x8000.
-                    uint16_t *slp = &cpu.vic.spriteLine[spriteXPos]; //Sprite-Line-Pointer
-                    uint16_t spriteLineupperByte = (0x80 | ((cpu.vic.r.MDP & spriteBit) ? 0x40 : 0) | spriteNum) << 8;
+                    uint16_t *slp = &cpu().vic.spriteLine[spriteXPos]; //Sprite-Line-Pointer
+                    uint16_t spriteLineupperByte = (0x80 | ((cpu().vic.r.MDP & spriteBit) ? 0x40 : 0) | spriteNum) << 8;
 
                     //Sprite in Spritezeile schreiben:
-                    if((cpu.vic.r.MMC & spriteBit) == 0) { // NO MULTICOLOR
+                    if((cpu().vic.r.MMC & spriteBit) == 0) { // NO MULTICOLOR
                         // flag + priority + sprite number + color number
-                        uint16_t spriteLineData = spriteLineupperByte | cpu.vic.R[VIC_M0C + spriteNum];
+                        uint16_t spriteLineData = spriteLineupperByte | cpu().vic.R[VIC_M0C + spriteNum];
 
-                        if((cpu.vic.r.MXE & spriteBit) == 0) { // NO MULTICOLOR, NO SPRITE-X-EXPANSION
+                        if((cpu().vic.r.MXE & spriteBit) == 0) { // NO MULTICOLOR, NO SPRITE-X-EXPANSION
                             for(unsigned cnt = 0; spriteData && cnt < 24; cnt++, spriteData <<= 1) {
                                 bool pixel = (spriteData >> 23) & 0x01;
 
@@ -2226,11 +2400,11 @@ void tvic::render() {
                         uint16_t colors[4];
 
                         // color 0 is transparent
-                        colors[1] = spriteLineupperByte | cpu.vic.R[VIC_MM0];
-                        colors[2] = spriteLineupperByte | cpu.vic.R[VIC_M0C + spriteNum];
-                        colors[3] = spriteLineupperByte | cpu.vic.R[VIC_MM1];
+                        colors[1] = spriteLineupperByte | cpu().vic.R[VIC_MM0];
+                        colors[2] = spriteLineupperByte | cpu().vic.R[VIC_M0C + spriteNum];
+                        colors[3] = spriteLineupperByte | cpu().vic.R[VIC_MM1];
 
-                        if((cpu.vic.r.MXE & spriteBit) == 0) { // MULTICOLOR, NO SPRITE-X-EXPANSION
+                        if((cpu().vic.r.MXE & spriteBit) == 0) { // MULTICOLOR, NO SPRITE-X-EXPANSION
                             for(unsigned cnt = 0; spriteData && cnt < 24; cnt++, spriteData <<= 2) {
                                 uint8_t pixel = (spriteData >> 22) & 0x03;
 
@@ -2304,19 +2478,19 @@ void tvic::render() {
         }
 
         if(collision) {
-            if(cpu.vic.r.MM == 0) {
-                cpu.vic.R[VIC_IRQST] |= VIC_IRQST_IMMC | (cpu.vic.R[VIC_IRQEN] & VIC_IRQEN_EMMC ? VIC_IRQST_IRQ : 0);
+            if(cpu().vic.r.MM == 0) {
+                cpu().vic.R[VIC_IRQST] |= VIC_IRQST_IMMC | (cpu().vic.R[VIC_IRQEN] & VIC_IRQEN_EMMC ? VIC_IRQST_IRQ : 0);
             }
 
-            cpu.vic.r.MM |= collision;
+            cpu().vic.r.MM |= collision;
         }
     }
     /*****************************************************************************************************/
 #if 0
     {
-      int t = MAXCYCLESSPRITES0_2 - cpu.vic.spriteCycles0_2;
+      int t = MAXCYCLESSPRITES0_2 - cpu().vic.spriteCycles0_2;
       if (t > 0) cpu_clock(t);
-      if (cpu.vic.spriteCycles0_2 > 0) cia_clockt(cpu.vic.spriteCycles0_2);
+      if (cpu().vic.spriteCycles0_2 > 0) cia_clockt(cpu().vic.spriteCycles0_2);
     }
 #endif
 
@@ -2333,13 +2507,19 @@ void tvic::render() {
 /*****************************************************************************************************/
 
 static void dim() {
+#if MACHINES > 1
+    vicPipelineFlush(cpu().vic);
+#endif
+
     for(int i = 0; i < ILI9341_TFTWIDTH * ILI9341_TFTHEIGHT; i++) {
-        auto p = screenMem[i];
-        screenMem[i] = (p & 0b1110000000000000) >> 2 | (p & 0b0000011110000000) >> 2 | (p & 0b0000000000011100) >> 2;
+        auto p = cpu().vic.frameBuffer[i];
+        cpu().vic.frameBuffer[i] = (p & 0b1110000000000000) >> 2 | (p & 0b0000011110000000) >> 2 | (p & 0b0000000000011100) >> 2;
     }
 }
 
 void tvic::displaySimpleModeScreen() {
+    if(cpu().vic.frameBuffer != screenMem) { return; } //not shown on the display
+
     dim();
 
     tft.setFont(Play_60_Bold);
@@ -2354,46 +2534,54 @@ void tvic::renderSimple() {
     uint16_t vc;
     int cycles = 0;
 
-    if(cpu.vic.rasterLine >= LINECNT) {
+    if(cpu().vic.rasterLine >= LINECNT) {
         //reSID sound needs much time - too much to keep everything in sync and with stable refreshrate
         //but it is not called very often, so most of the time, we have more time than needed.
         //We can measure the time needed for a frame and calc a correction factor to speed things up.
         uint32_t m = cycleCountMicros();
-        cpu.vic.neededTime = (m - cpu.vic.timeStart);
-        cpu.vic.timeStart = m;
+        cpu().vic.neededTime = (m - cpu().vic.timeStart);
+        cpu().vic.timeStart = m;
+
+        if(!warp.on) {
+            cpu().vic.lineClock.update(LINETIMER_DEFAULT_FREQ -
+                                       ((float)cpu().vic.neededTime / (float)LINECNT - LINETIMER_DEFAULT_FREQ));
+        }
 
-        cpu.vic.lineClock.update(LINETIMER_DEFAULT_FREQ -
-                                 ((float)cpu.vic.neededTime / (float)LINECNT - LINETIMER_DEFAULT_FREQ));
+#if MACHINES > 1
+        if(cpu().vic.video && !warp.skipFrame) { videoStreamFrame(cpu().vic); }
+#endif
+
+        warpFrame();
 
-        cpu.vic.rasterLine = 0;
-        cpu.vic.vcbase = 0;
-        cpu.vic.denLatch = 0;
+        cpu().vic.rasterLine = 0;
+        cpu().vic.vcbase = 0;
+        cpu().vic.denLatch = 0;
     } else {
-        cpu.vic.rasterLine++;
+        cpu().vic.rasterLine++;
         cpu_clock(1);
         cycles += 1;
     }
 
-    int r = cpu.vic.rasterLine;
+    int r = cpu().vic.rasterLine;
 
-    if(r == cpu.vic.intRasterLine) { // rasterline interrupt
-        cpu.vic.R[VIC_IRQST] |= VIC_IRQST_IRST | (cpu.vic.R[VIC_IRQEN] & VIC_IRQEN_ERST ? VIC_IRQST_IRQ : 0);
+    if(r == cpu().vic.intRasterLine) { // rasterline interrupt
+        cpu().vic.R[VIC_IRQST] |= VIC_IRQST_IRST | (cpu().vic.R[VIC_IRQEN] & VIC_IRQEN_ERST ? VIC_IRQST_IRQ : 0);
     }
 
     cpu_clock(9);
     cycles += 9;
 
     if(r == 0x30) {
-        cpu.vic.denLatch |= cpu.vic.r.DEN;
+        cpu().vic.denLatch |= cpu().vic.r.DEN;
     }
 
-    vc = cpu.vic.vcbase;
+    vc = cpu().vic.vcbase;
 
-    cpu.vic.badline = (cpu.vic.denLatch && (r >= 0x30) && (r <= 0xf7) && ((r & 0x07) == cpu.vic.r.YSCROLL));
+    cpu().vic.badline = (cpu().vic.denLatch && (r >= 0x30) && (r <= 0xf7) && ((r & 0x07) == cpu().vic.r.YSCROLL));
 
-    if(cpu.vic.badline) {
-        cpu.vic.idle = 0;
-        cpu.vic.rc = 0;
+    if(cpu().vic.badline) {
+        cpu().vic.idle = 0;
+        cpu().vic.rc = 0;
     }
 
 
@@ -2405,17 +2593,17 @@ void tvic::renderSimple() {
            1 | 25 text lines/200 pixels |   51 ($33)  | 250 ($fa)
      */
 
-    if(cpu.vic.borderFlag) {
-        int firstLine = (cpu.vic.r.RSEL) ? 0x33 : 0x37;
+    if(cpu().vic.borderFlag) {
+        int firstLine = (cpu().vic.r.RSEL) ? 0x33 : 0x37;
 
-        if(cpu.vic.r.DEN && r == firstLine) {
-            cpu.vic.borderFlag = false;
+        if(cpu().vic.r.DEN && r == firstLine) {
+            cpu().vic.borderFlag = false;
         }
     } else {
-        int lastLine = (cpu.vic.r.RSEL) ? 0xfb : 0xf7;
+        int lastLine = (cpu().vic.r.RSEL) ? 0xfb : 0xf7;
 
         if(r == lastLine) {
-            cpu.vic.borderFlag = true;
+            cpu().vic.borderFlag = true;
         }
     }
 
@@ -2431,14 +2619,14 @@ void tvic::renderSimple() {
     cpu_clock(4);
     cycles += 4;
 
-    if(cpu.vic.rc == 7) {
-        cpu.vic.idle = 1;
-        cpu.vic.vcbase = vc;
+    if(cpu().vic.rc == 7) {
+        cpu().vic.idle = 1;
+        cpu().vic.vcbase = vc;
     }
 
     //Ist dies richtig ??
-    if((!cpu.vic.idle) || (cpu.vic.denLatch && (r >= 0x30) && (r <= 0xf7) && ((r & 0x07) == cpu.vic.r.YSCROLL))) {
-        cpu.vic.rc = (cpu.vic.rc + 1) & 0x07;
+    if((!cpu().vic.idle) || (cpu().vic.denLatch && (r >= 0x30) && (r <= 0xf7) && ((r & 0x07) == cpu().vic.r.YSCROLL))) {
+        cpu().vic.rc = (cpu().vic.rc + 1) & 0x07;
     }
 
     cpu_clock(3); //1
@@ -2456,26 +2644,26 @@ void tvic::renderSimple() {
 /*****************************************************************************************************/
 
 void tvic::applyAdressChange() {
-    uint8_t r18 = cpu.vic.R[VIC_VM_CB];
-    cpu.vic.videomatrix = cpu.vic.bank + (unsigned) (r18 & VIC_VM_CB_VM_MASK) * 64;
+    uint8_t r18 = cpu().vic.R[VIC_VM_CB];
+    cpu().vic.videomatrix = cpu().vic.bank + (unsigned) (r18 & VIC_VM_CB_VM_MASK) * 64;
 
     unsigned charsetAddr = r18 & VIC_VM_CB_CB_MASK;
-    if((cpu.vic.bank & 0x4000) == 0) {
+    if((cpu().vic.bank & 0x4000) == 0) {
         if(charsetAddr == 0x04) {
-            cpu.vic.charsetPtrBase = ((uint8_t *) &rom_characters);
+            cpu().vic.charsetPtrBase = ((uint8_t *) &rom_characters);
         } else if(charsetAddr == 0x06) {
-            cpu.vic.charsetPtrBase = ((uint8_t *) &rom_characters) + 0x800;
+            cpu().vic.charsetPtrBase = ((uint8_t *) &rom_characters) + 0x800;
         } else {
-            cpu.vic.charsetPtrBase = &cpu.RAM[charsetAddr * 0x400 + cpu.vic.bank];
+            cpu().vic.charsetPtrBase = &cpu().RAM[charsetAddr * 0x400 + cpu().vic.bank];
         }
     } else {
-        cpu.vic.charsetPtrBase = &cpu.RAM[charsetAddr * 0x400 + cpu.vic.bank];
+        cpu().vic.charsetPtrBase = &cpu().RAM[charsetAddr * 0x400 + cpu().vic.bank];
     }
 
-    cpu.vic.bitmapPtr = (uint8_t *) &cpu.RAM[cpu.vic.bank | ((r18 & 0x08) * 0x400)];
+    cpu().vic.bitmapPtr = (uint8_t *) &cpu().RAM[cpu().vic.bank | ((r18 & 0x08) * 0x400)];
 
-    if((cpu.vic.R[VIC_CR1] & VIC_CR1_xxM_MASK) == VIC_CR1_xxM_MASK) {
-        cpu.vic.bitmapPtr = (uint8_t *) ((uintptr_t) cpu.vic.bitmapPtr & 0xf9ff);
+    if((cpu().vic.R[VIC_CR1] & VIC_CR1_xxM_MASK) == VIC_CR1_xxM_MASK) {
+        cpu().vic.bitmapPtr = (uint8_t *) ((uintptr_t) cpu().vic.bitmapPtr & 0xf9ff);
     }
 }
 
@@ -2483,59 +2671,63 @@ void tvic::applyAdressChange() {
 void tvic::write(uint32_t address, uint8_t value) {
     address &= 0x3F;
 
+#if VIC_JOURNAL
+    vicJournalWrite(address, value);
+#endif
+
     switch(address) {
         case VIC_CR1:
-            cpu.vic.R[VIC_CR1] = value;
-            cpu.vic.intRasterLine = (cpu.vic.intRasterLine & 0xff) | (value & VIC_CR1_RST8 ? 0x100 : 0);
+            cpu().vic.R[VIC_CR1] = value;
+            cpu().vic.intRasterLine = (cpu().vic.intRasterLine & 0xff) | (value & VIC_CR1_RST8 ? 0x100 : 0);
 
-            if(cpu.vic.rasterLine == 0x30) {
-                cpu.vic.denLatch |= value & VIC_CR1_DEN;
+            if(cpu().vic.rasterLine == 0x30) {
+                cpu().vic.denLatch |= value & VIC_CR1_DEN;
             }
 
-            cpu.vic.badline = (cpu.vic.denLatch
-                               && (cpu.vic.rasterLine >= 0x30)
-                               && (cpu.vic.rasterLine <= 0xf7)
-                               && ((cpu.vic.rasterLine & 0x07) == (value & VIC_CR1_YSCROLL_MASK)));
+            cpu().vic.badline = (cpu().vic.denLatch
+                               && (cpu().vic.rasterLine >= 0x30)
+                               && (cpu().vic.rasterLine <= 0xf7)
+                               && ((cpu().vic.rasterLine & 0x07) == (value & VIC_CR1_YSCROLL_MASK)));
 
-            if(cpu.vic.badline) {
-                cpu.vic.idle = 0;
+            if(cpu().vic.badline) {
+                cpu().vic.idle = 0;
             }
             applyAdressChange();
 
             break;
 
         case VIC_RASTER:
-            cpu.vic.intRasterLine = (cpu.vic.intRasterLine & 0x100) | value;
-            cpu.vic.R[VIC_RASTER] = value;
+            cpu().vic.intRasterLine = (cpu().vic.intRasterLine & 0x100) | value;
+            cpu().vic.R[VIC_RASTER] = value;
             break;
 
         case VIC_VM_CB:
-            cpu.vic.R[VIC_VM_CB] = value;
+            cpu().vic.R[VIC_VM_CB] = value;
             applyAdressChange();
             break;
 
         case VIC_IRQST:
-            cpu.vic.R[VIC_IRQST] &= (~value & VIC_IRQST_MASK);
+            cpu().vic.R[VIC_IRQST] &= (~value & VIC_IRQST_MASK);
             break;
 
         case VIC_IRQEN:
-            cpu.vic.R[VIC_IRQEN] = value & ~VIC_IRQEN_UNUSED_MASK;
+            cpu().vic.R[VIC_IRQEN] = value & ~VIC_IRQEN_UNUSED_MASK;
             break;
 
         case VIC_MxM:
         case VIC_MxD:
-            cpu.vic.R[address] = 0;
+            cpu().vic.R[address] = 0;
             break;
 
         case VIC_EC ... VIC_M7C:
-            cpu.vic.R[address] = value & ~VIC_xC_UNUSED_MASK;
+            cpu().vic.R[address] = value & ~VIC_xC_UNUSED_MASK;
             break;
 
         case 0x2F ... 0x3F:
             break;
 
         default:
-            cpu.vic.R[address] = value;
+            cpu().vic.R[address] = value;
             break;
     }
 }
@@ -2550,37 +2742,37 @@ uint8_t tvic::read(uint32_t address) {
     address &= 0x3F;
     switch(address) {
         case VIC_CR1:
-            ret = (cpu.vic.R[VIC_CR1] & 0x7F) | ((cpu.vic.rasterLine & 0x100) >> 1); // kfl02: ???
+            ret = (cpu().vic.R[VIC_CR1] & 0x7F) | ((cpu().vic.rasterLine & 0x100) >> 1); // kfl02: ???
             break;
 
         case VIC_RASTER:
-            ret = cpu.vic.rasterLine;
+            ret = cpu().vic.rasterLine;
             break;
 
         case VIC_CR2:
-            ret = cpu.vic.R[VIC_CR2] | VIC_CR2_UNUSED_MASK;
+            ret = cpu().vic.R[VIC_CR2] | VIC_CR2_UNUSED_MASK;
             break;
 
         case VIC_VM_CB:
-            ret = cpu.vic.R[VIC_VM_CB] | VIC_VM_CB_UNUSED_MASK;
+            ret = cpu().vic.R[VIC_VM_CB] | VIC_VM_CB_UNUSED_MASK;
             break;
 
         case VIC_IRQST:
-            ret = cpu.vic.R[VIC_IRQST] | VIC_IRQST_UNUSED_MASK;
+            ret = cpu().vic.R[VIC_IRQST] | VIC_IRQST_UNUSED_MASK;
             break;
 
         case VIC_IRQEN:
-            ret = cpu.vic.R[VIC_IRQEN] | VIC_IRQEN_UNUSED_MASK;
+            ret = cpu().vic.R[VIC_IRQEN] | VIC_IRQEN_UNUSED_MASK;
             break;
 
         case VIC_MxM:
         case VIC_MxD:
-            ret = cpu.vic.R[address];
-            cpu.vic.R[address] = 0;
+            ret = cpu().vic.R[address];
+            cpu().vic.R[address] = 0;
             break;
 
         case VIC_EC ... VIC_M7C:
-            ret = cpu.vic.R[address] | VIC_xC_UNUSED_MASK;
+            ret = cpu().vic.R[address] | VIC_xC_UNUSED_MASK;
             break;
 
         case 0x2F ... 0x3F:
@@ -2588,7 +2780,7 @@ uint8_t tvic::read(uint32_t address) {
             break;
 
         default:
-            ret = cpu.vic.R[address];
+            ret = cpu().vic.R[address];
             break;
     }
 
@@ -2603,31 +2795,32 @@ void tvic::reset() {
 
     enableCycleCounter();
 
-    cpu.vic.intRasterLine = 0;
-    cpu.vic.rasterLine = 0;
-    cpu.vic.lineHasSprites = 0;
-    memset(&cpu.RAM[0x400], 0, 1000);
-    memset(&cpu.vic.R, 0, sizeof(cpu.vic.R));
+    if(cpu().vic.frameBuffer == nullptr) { cpu().vic.frameBuffer = screenMem; }
+    cpu().vic.intRasterLine = 0;
+    cpu().vic.rasterLine = 0;
+    cpu().vic.lineHasSprites = 0;
+    memset(&cpu().RAM[0x400], 0, 1000);
+    memset(&cpu().vic.R, 0, sizeof(cpu().vic.R));
     updatePalette(0);
 
     //http://dustlayer.com/vic-ii/2013/4/22/when-visibility-matters
-    cpu.vic.R[VIC_CR1] = 0x9B;
-    cpu.vic.R[VIC_CR2] = 0x08;
-    cpu.vic.R[VIC_VM_CB] = 0x14;
-    cpu.vic.R[VIC_IRQST] = 0x0f;
+    cpu().vic.R[VIC_CR1] = 0x9B;
+    cpu().vic.R[VIC_CR2] = 0x08;
+    cpu().vic.R[VIC_VM_CB] = 0x14;
+    cpu().vic.R[VIC_IRQST] = 0x0f;
 
-    for(unsigned char & i : cpu.vic.colorRAM) {
+    for(unsigned char & i : cpu().vic.colorRAM) {
         i = (rand() & 0x0F);
     }
 
-    cpu.RAM[0x39FF] = 0x0;
-    cpu.RAM[0x3FFF] = 0x0;
-    cpu.RAM[0x39FF + 16384] = 0x0;
-    cpu.RAM[0x3FFF + 16384] = 0x0;
-    cpu.RAM[0x39FF + 32768] = 0x0;
-    cpu.RAM[0x3FFF + 32768] = 0x0;
-    cpu.RAM[0x39FF + 49152] = 0x0;
-    cpu.RAM[0x3FFF + 49152] = 0x0;
+    cpu().RAM[0x39FF] = 0x0;
+    cpu().RAM[0x3FFF] = 0x0;
+    cpu().RAM[0x39FF + 16384] = 0x0;
+    cpu().RAM[0x3FFF + 16384] = 0x0;
+    cpu().RAM[0x39FF + 32768] = 0x0;
+    cpu().RAM[0x3FFF + 32768] = 0x0;
+    cpu().RAM[0x39FF + 49152] = 0x0;
+    cpu().RAM[0x3FFF + 49152] = 0x0;
 
     applyAdressChange();
 }
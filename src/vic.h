@@ -91,6 +91,12 @@ struct tvic {
     uint16_t palette[16];
     uint8_t paletteNo;
 
+    tpixel *frameBuffer; //the frame is drawn here, nullptr: the display
+#if MACHINES > 1
+    struct tvicPipeline *pipeline; //render thread, nullptr: render() draws all lines, see vic_pipeline.h
+    struct tvideoStream *video;    //completed frames for a consumer, see video_stream.h
+#endif
+
     IntervalTimer lineClock;
 
     union {
@@ -0,0 +1,96 @@
+/*
+	Copyright Frank Bösing, Karsten Fleischer, 2026
+
+	This file is part of Teensy64.
+
+    Teensy64 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Teensy64 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Teensy64.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von Teensy64.
+
+    Teensy64 ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Teensy64 wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+*/
+
+#include <cstring>
+#include "settings.h"
+
+#if VIC_JOURNAL
+
+#include "teensy64.h"
+#include "vic_journal.h"
+
+namespace {
+
+volatile bool request = false;
+
+}
+
+void vicJournalReset() {
+    cpu().vicJournal.current.count = cpu().vicJournal.current.dropped = 0;
+    cpu().vicJournal.frame.count = cpu().vicJournal.frame.dropped = 0;
+}
+
+void vicJournalNextFrame() {
+    tvicJournals &journal = cpu().vicJournal;
+
+    memcpy(journal.frame.writes, journal.current.writes, journal.current.count * sizeof(tvicWrite));
+    journal.frame.count = journal.current.count;
+    journal.frame.dropped = journal.current.dropped;
+    journal.current.count = journal.current.dropped = 0;
+}
+
+unsigned vicJournalLines() {
+    const tvicJournal &frame = cpu().vicJournal.frame;
+    unsigned lines = 0;
+
+    for(unsigned i = 0; i < frame.count; i++) {
+        if(i == 0 || frame.writes[i].line != frame.writes[i - 1].line) { lines++; }
+    }
+
+    return lines;
+}
+
+void vicJournalRequest() {
+    request = true;
+}
+
+void vicJournalPoll() {
+    if(!request) { return; }
+
+    const tvicJournal &frame = cpu().vicJournal.frame;
+
+    request = false;
+    Serial.printf("VIC journal: %u writes in %u lines, %u dropped\n", (unsigned) frame.count,
+                  vicJournalLines(), (unsigned) frame.dropped);
+    Serial.printf("line cycle register value\n");
+
+    for(unsigned i = 0; i < frame.count; i++) {
+        const tvicWrite &w = frame.writes[i];
+
+        Serial.printf("%4u %5u    $D0%02X   $%02X\n", w.line, w.cycle, w.reg, w.value);
+    }
+}
+
+#endif
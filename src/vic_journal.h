@@ -0,0 +1,92 @@
+/*
+	Copyright Frank Bösing, Karsten Fleischer, 2026
+
+	This file is part of Teensy64.
+
+    Teensy64 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Teensy64 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Teensy64.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von Teensy64.
+
+    Teensy64 ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Teensy64 wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+*/
+
+#pragma once
+
+#ifndef TEENSY64_VIC_JOURNAL_H
+#define TEENSY64_VIC_JOURNAL_H
+
+#include <cstdint>
+#include "settings.h"
+
+/*
+  Journal of the VIC register writes, an instrumentation build with VIC_JOURNAL 1:
+  each write of the CPU to $D000-$D3FF with the raster line, the cycle in the line,
+  the register and the value, in the order of the writes.
+
+  The cycle is cpu().lineCycles at the end of the writing instruction, where its write
+  happens, in CPU cycles: with turbo, a line has more of them.
+  A frame keeps up to VIC_JOURNAL_LENGTH writes, further ones are only counted. The
+  journal of the last complete frame is kept: Ctrl+Alt+V prints it on Serial, the batch
+  runner puts a summary into the report of each program and the journal into a file.
+  Raster splits show up as several lines with writes, changes in the middle of a line as
+  cycles inside the display window.
+*/
+
+#if VIC_JOURNAL
+struct tvicWrite {
+    uint16_t line;
+    uint16_t cycle;
+    uint8_t reg;
+    uint8_t value;
+};
+
+struct tvicJournal {
+    tvicWrite writes[VIC_JOURNAL_LENGTH];
+    uint32_t count;
+    uint32_t dropped; //writes after the buffer was full
+};
+
+// The journal of a machine, cpu().vicJournal. tvic::write() records into current.
+struct tvicJournals {
+    tvicJournal current; //the frame being recorded
+    tvicJournal frame;   //the last complete frame
+};
+
+void vicJournalReset();
+
+// Called at the start of each frame, keeps the journal of the frame that ended.
+void vicJournalNextFrame();
+
+// Number of raster lines with writes in the last complete frame.
+unsigned vicJournalLines();
+
+void vicJournalRequest();
+
+// Called by the line clock interrupt between two raster lines.
+void vicJournalPoll();
+#endif
+
+#endif // TEENSY64_VIC_JOURNAL_H
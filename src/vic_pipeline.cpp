@@ -0,0 +1,159 @@
+/*
+	Copyright Frank Bösing, Karsten Fleischer, 2026
+
+	This file is part of Teensy64.
+
+    Teensy64 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Teensy64 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Teensy64.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von Teensy64.
+
+    Teensy64 ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Teensy64 wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+*/
+
+#include "teensy64.h"
+
+#if MACHINES > 1
+
+#include <atomic>
+#include <thread>
+#include "vic_pipeline.h"
+
+namespace {
+
+const unsigned RING_LINES = 64; //power of 2
+
+}
+
+struct tvicPipeline {
+    tpipelineLine ring[RING_LINES];
+    std::atomic<uint32_t> head{0}; //written by the CPU thread
+    std::atomic<uint32_t> tail{0}; //written by the render thread
+    std::atomic<bool> stop{false};
+    std::thread thread;
+};
+
+namespace {
+
+inline void expand(tpixel *&p, const tpixel *pe, const tpipelineChar &ch, const uint16_t *palette) {
+    uint8_t g = ch.g;
+
+    if(ch.multicolor) {
+        for(unsigned i = 0; i < 4 && p < pe; i++, g <<= 2) {
+            tpixel pixel = palette[ch.c[g >> 6]];
+
+            *p++ = pixel;
+            if(p < pe) { *p++ = pixel; }
+        }
+    } else {
+        tpixel bg = palette[ch.c[0]];
+        tpixel fg = palette[ch.c[1]];
+
+        for(unsigned i = 0; i < 8 && p < pe; i++, g <<= 1) { *p++ = (g & 0x80) ? fg : bg; }
+    }
+}
+
+//Same pixels as render() with the modes 0..7, without sprites
+void draw(const tpipelineLine &line) {
+    const uint16_t *palette = line.palette;
+    tpixel *p = line.row;
+    const tpixel *pe = p + SCREEN_WIDTH;
+
+    if(line.border) {
+        tpixel col = palette[line.borderLeft];
+        while(p < pe + BORDER_RIGHT) { *p++ = col; }
+        return;
+    }
+
+    for(unsigned i = 0; i < line.xscroll; i++) { *p++ = palette[line.borderLeft]; }
+
+    for(unsigned x = 0; x < 40 && p < pe; x++) { expand(p, pe, line.ch[x], palette); }
+
+    if(!line.csel) {
+        tpixel col = palette[line.borderRight];
+
+        p = line.row + BORDER_LEFT;
+        for(unsigned i = 0; i < 7; i++) { *p++ = col; }
+
+        p = line.row + SCREEN_WIDTH - 9 + BORDER_LEFT;
+        for(unsigned i = 0; i < 9; i++) { *p++ = col; }
+    }
+}
+
+void renderThread(tvicPipeline *pipeline) {
+    uint32_t tail = pipeline->tail.load(std::memory_order_relaxed);
+
+    while(true) {
+        while(tail == pipeline->head.load(std::memory_order_acquire)) {
+            if(pipeline->stop.load(std::memory_order_acquire)) { return; }
+            std::this_thread::yield();
+        }
+
+        draw(pipeline->ring[tail % RING_LINES]);
+        pipeline->tail.store(++tail, std::memory_order_release);
+    }
+}
+
+}
+
+void vicPipelineStart(tvic &vic) {
+    if(vic.pipeline) { return; }
+
+    vic.pipeline = new tvicPipeline();
+    vic.pipeline->thread = std::thread(renderThread, vic.pipeline);
+}
+
+void vicPipelineStop(tvic &vic) {
+    if(!vic.pipeline) { return; }
+
+    vicPipelineFlush(vic);
+    vic.pipeline->stop.store(true, std::memory_order_release);
+    vic.pipeline->thread.join();
+
+    delete vic.pipeline;
+    vic.pipeline = nullptr;
+}
+
+void vicPipelineFlush(tvic &vic) {
+    if(!vic.pipeline) { return; }
+
+    uint32_t head = vic.pipeline->head.load(std::memory_order_relaxed);
+
+    while(vic.pipeline->tail.load(std::memory_order_acquire) != head) { std::this_thread::yield(); }
+}
+
+tpipelineLine &vicPipelineReserve(tvicPipeline *pipeline) {
+    uint32_t head = pipeline->head.load(std::memory_order_relaxed);
+
+    while(head - pipeline->tail.load(std::memory_order_acquire) >= RING_LINES) { std::this_thread::yield(); }
+
+    return pipeline->ring[head % RING_LINES];
+}
+
+void vicPipelinePublish(tvicPipeline *pipeline) {
+    pipeline->head.store(pipeline->head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+#endif
@@ -0,0 +1,90 @@
+/*
+	Copyright Frank Bösing, Karsten Fleischer, 2026
+
+	This file is part of Teensy64.
+
+    Teensy64 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Teensy64 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Teensy64.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von Teensy64.
+
+    Teensy64 ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Teensy64 wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+*/
+
+#pragma once
+
+#ifndef TEENSY64_VIC_PIPELINE_H
+#define TEENSY64_VIC_PIPELINE_H
+
+#include "vic.h"
+
+/*
+  Pipelined VIC for host builds (MACHINES > 1): the pixels of a line are drawn on a render
+  thread while the CPU thread already emulates the next lines.
+
+  For lines without sprites, render() takes the path of the warp mode that has the cycles
+  and c-accesses, but no pixels. On the way it puts everything the pixels depend on into a
+  line of a ring buffer: the g-data and the colours of each character as they are at the
+  cycle the drawing code reads them, and the border colours. The render thread turns the
+  line into pixels. The CPU thread and the render thread share only the ring buffer, with
+  one index written by each of them.
+
+  Lines with sprites are still drawn by the CPU thread, the sprite collisions depend on
+  the pixels.
+*/
+
+struct tpipelineChar {
+    uint8_t g;          //pixels from the g-access
+    uint8_t multicolor; //2 bits per pixel
+    uint8_t c[4];       //colours of the pixel values, hires: c[0] and c[1]
+};
+
+struct tpipelineLine {
+    tpixel *row;
+    const uint16_t *palette;
+    uint8_t border;  //the line is all border, in borderLeft
+    uint8_t xscroll;
+    uint8_t csel;
+    uint8_t borderLeft;
+    uint8_t borderRight;
+    tpipelineChar ch[40];
+};
+
+struct tvicPipeline;
+
+// Starts/stops the render thread of the VIC of a machine.
+void vicPipelineStart(tvic &vic);
+void vicPipelineStop(tvic &vic);
+
+// Waits until the render thread has drawn all lines so far, before the frame buffer is read.
+void vicPipelineFlush(tvic &vic);
+
+// The next line of the ring buffer, waits while it is full. Used by render().
+tpipelineLine &vicPipelineReserve(tvicPipeline *pipeline);
+
+// Hands the reserved line to the render thread.
+void vicPipelinePublish(tvicPipeline *pipeline);
+
+#endif // TEENSY64_VIC_PIPELINE_H
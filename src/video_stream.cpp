@@ -0,0 +1,103 @@
+/*
+	Copyright Frank Bösing, Karsten Fleischer, 2026
+
+	This file is part of Teensy64.
+
+    Teensy64 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Teensy64 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Teensy64.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von Teensy64.
+
+    Teensy64 ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Teensy64 wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+*/
+
+#include <cstring>
+#include "teensy64.h"
+
+#if MACHINES > 1
+
+#include "vic_pipeline.h"
+#include "video_stream.h"
+
+namespace {
+
+const unsigned STREAM_FRAMES = 4; //one drawn, one held by the consumer, two queued
+
+}
+
+struct tvideoStream {
+    explicit tvideoStream(tstreamPolicy policy) : frames(policy) {}
+
+    tstream<tframe, STREAM_FRAMES> frames;
+    tpixel *frameBuffer; //of the machine before the stream
+    uint32_t number{};
+};
+
+void videoStreamStart(tvic &vic, tstreamPolicy policy) {
+    if(vic.video) { return; }
+
+    vicPipelineFlush(vic);
+
+    vic.video = new tvideoStream(policy);
+    vic.video->frameBuffer = vic.frameBuffer;
+    vic.frameBuffer = vic.video->frames.slot().pixels;
+
+    //the lines of the current frame drawn so far
+    memcpy(vic.frameBuffer, vic.video->frameBuffer, sizeof(tframe::pixels));
+}
+
+void videoStreamStop(tvic &vic) {
+    if(!vic.video) { return; }
+
+    vicPipelineFlush(vic);
+
+    vic.frameBuffer = vic.video->frameBuffer;
+
+    delete vic.video;
+    vic.video = nullptr;
+}
+
+const tframe *videoStreamAcquire(tvic &vic) {
+    return vic.video->frames.acquire();
+}
+
+void videoStreamClose(tvic &vic) {
+    vic.video->frames.close();
+}
+
+uint32_t videoStreamDropped(const tvic &vic) {
+    return vic.video->frames.dropped;
+}
+
+void videoStreamFrame(tvic &vic) {
+    //the lines still on the render thread belong to this frame
+    vicPipelineFlush(vic);
+
+    vic.video->frames.slot().number = vic.video->number++;
+    vic.video->frames.publish();
+    vic.frameBuffer = vic.video->frames.slot().pixels;
+}
+
+#endif
@@ -0,0 +1,78 @@
+/*
+	Copyright Frank Bösing, Karsten Fleischer, 2026
+
+	This file is part of Teensy64.
+
+    Teensy64 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Teensy64 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Teensy64.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von Teensy64.
+
+    Teensy64 ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Teensy64 wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+*/
+
+#pragma once
+
+#ifndef TEENSY64_VIDEO_STREAM_H
+#define TEENSY64_VIDEO_STREAM_H
+
+#include "vic.h"
+#include "stream.h"
+
+/*
+  Completed frames of a machine for a consumer thread in host builds (MACHINES > 1), e.g.
+  a window or a video encoder.
+
+  The frames of the stream are the frame buffers of the VIC: at the end of a frame render()
+  hands the buffer it has just drawn to the consumer and goes on with the next free one, no
+  pixel is copied. Frames that are not drawn (warp mode) are not handed over.
+  The policy decides what happens if the consumer is slower than the emulation, see stream.h.
+*/
+
+struct tframe {
+    tpixel pixels[ILI9341_TFTHEIGHT * ILI9341_TFTWIDTH];
+    uint32_t number; //frames since videoStreamStart()
+};
+
+struct tvideoStream;
+
+// Starts/stops the stream of the VIC of a machine. While it runs, the frame buffer
+// of the machine is one of the stream.
+void videoStreamStart(tvic &vic, tstreamPolicy policy);
+void videoStreamStop(tvic &vic);
+
+// Consumer: the next frame, valid until the next call. See stream.h for nullptr.
+const tframe *videoStreamAcquire(tvic &vic);
+
+// Consumer: the emulation no longer waits for it with STREAM_BLOCK, before the consumer goes away.
+void videoStreamClose(tvic &vic);
+
+// Frames dropped because the consumer was too slow.
+uint32_t videoStreamDropped(const tvic &vic);
+
+// Hands the frame drawn so far to the consumer. Called by render() at the end of the frame.
+void videoStreamFrame(tvic &vic);
+
+#endif // TEENSY64_VIDEO_STREAM_H
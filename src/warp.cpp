@@ -0,0 +1,127 @@
+/*
+	Copyright Frank Bösing, Karsten Fleischer, 2026
+
+	This file is part of Teensy64.
+
+    Teensy64 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Teensy64 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Teensy64.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von Teensy64.
+
+    Teensy64 ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Teensy64 wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+*/
+
+#include "teensy64.h"
+#include "pla.h"
+#include "util.h"
+#include "kernal_editor.h"
+#include "warp.h"
+
+struct twarp warp;
+
+namespace {
+
+void report() {
+    uint32_t m = cycleCountMicros();
+    float seconds = (m - warp.startTime) / 1e6f;
+
+    if(seconds > 0) {
+        Serial.print("Warp: ");
+        Serial.print(warp.frames / REFRESHRATE / seconds, 1);
+        Serial.println("x");
+    }
+
+    warp.frames = 0;
+    warp.startTime = m;
+}
+
+}
+
+void warpOn(bool automatic) {
+    if(warp.on) { return; }
+
+    warp.on = 1;
+    warp.automatic = automatic;
+    warp.frameCount = 0;
+    warp.frames = 0;
+    warp.startTime = cycleCountMicros();
+#if WARP_MUTE
+    warp.volume = AudioOutputAnalog::volume;
+    AudioOutputAnalog::volume = 16;
+#endif
+
+    Serial.println(automatic ? "Warp on (LOAD)" : "Warp on");
+}
+
+void warpOff() {
+    if(!warp.on) { return; }
+
+    warp.on = 0;
+    warp.skipFrame = 0;
+#if WARP_MUTE
+    AudioOutputAnalog::volume = warp.volume;
+#endif
+
+    report();
+    Serial.println("Warp off");
+}
+
+void warpToggle() {
+    if(warp.on) {
+        warpOff();
+    } else {
+        warpOn(false);
+    }
+}
+
+void warpFrame() {
+    if(!warp.on) { return; }
+
+    if(warp.automatic && (kernalKeyboardWait() || warp.frames >= WARP_AUTOFRAMES)) {
+        warpOff();
+        return;
+    }
+
+    warp.skipFrame = 1;
+
+#if WARP_FRAMESKIP
+    if(++warp.frameCount >= WARP_FRAMESKIP) {
+        warp.frameCount = 0;
+        warp.skipFrame = 0;
+    }
+#endif
+
+    warp.frames++;
+
+    if(!warp.automatic && cycleCountMicros() - warp.startTime >= 2000000) {
+        report();
+    }
+}
+
+bool warpNextLine(uint32_t sliceStart) {
+    static const uint32_t timeSlice = F_CPU / LINEFREQ * WARP_LOAD / 100;
+
+    return warp.on && ARM_DWT_CYCCNT - sliceStart < timeSlice;
+}
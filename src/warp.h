@@ -0,0 +1,78 @@
+/*
+	Copyright Frank Bösing, Karsten Fleischer, 2026
+
+	This file is part of Teensy64.
+
+    Teensy64 is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Teensy64 is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Teensy64.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von Teensy64.
+
+    Teensy64 ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Teensy64 wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+
+*/
+
+#pragma once
+
+#ifndef TEENSY64_WARP_H
+#define TEENSY64_WARP_H
+
+#include <cstdint>
+
+/*
+  Warp mode: the emulation runs as fast as it can.
+
+  The raster line interrupt runs lines back to back for WARP_LOAD percent of its period,
+  CPU, CIAs and VIC are emulated as usual. Only every WARP_FRAMESKIP-th frame is drawn,
+  lines of the other frames are drawn only if they contain sprites (for the collisions).
+  With WARP_MUTE the audio output is muted.
+
+  Warp mode is toggled with "Scroll Lock" or switched on by LOAD from SD (WARP_AUTO).
+  Automatic warp mode ends when the KERNAL waits for a key or after WARP_AUTOFRAMES frames.
+  The speed reached is printed on the serial console.
+*/
+
+struct twarp {
+    uint8_t on;
+    uint8_t automatic;
+    uint8_t skipFrame;   //the current frame is not drawn
+    uint8_t frameCount;
+    uint8_t volume;      //audio volume before muting
+    uint32_t frames;     //frames since the last report
+    uint32_t startTime;  //µs of the last report
+};
+
+extern struct twarp warp;
+
+void warpOn(bool automatic);
+void warpOff();
+void warpToggle();
+
+// Called by the VIC at the start of every frame.
+void warpFrame();
+
+// Returns true if the raster line interrupt may run the next line right away.
+bool warpNextLine(uint32_t sliceStart);
+
+#endif // TEENSY64_WARP_H